@@ -0,0 +1,366 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "base/AFDLLHeader.hpp"
+
+#include "KernelBenchModule.h"
+#include "base/AFMetaDefine.hpp"
+#include "kernel/include/AFCDataList.hpp"
+
+static const int MAP_ID = 1;
+static const std::string RESULT_FILE = "kernel_bench.json";
+
+static const size_t ENTITY_COUNT = 10000;
+static const size_t NODE_COUNT = 1000000;
+static const size_t TABLE_ROW_COUNT = 5000;
+static const size_t CONTAINER_COUNT = 1000;
+static const size_t DELAY_SYNC_ROUND = 100;
+static const size_t DELAY_SYNC_ENTITY_COUNT = 1000;
+static const size_t DB_DATA_COUNT = 1000;
+
+namespace ark {
+
+bool KernelBenchModule::Init()
+{
+    std::cout << GET_CLASS_NAME(KernelBenchModule) << ", Init" << std::endl;
+    return true;
+}
+
+bool KernelBenchModule::PostInit()
+{
+    std::cout << GET_CLASS_NAME(KernelBenchModule) << ", PostInit" << std::endl;
+
+    m_pKernelModule = FindModule<AFIKernelModule>();
+    m_pClassMetaModule = FindModule<AFIClassMetaModule>();
+    m_pMapModule = FindModule<AFIMapModule>();
+    m_pLogModule = FindModule<AFILogModule>();
+
+    // all entity need in scene
+    m_pMapModule->CreateMap(MAP_ID);
+
+    EntityBench();
+    NodeBench();
+    TableBench();
+    ContainerBench();
+    DelaySyncBench();
+    DBDataBench();
+
+    WriteResult(RESULT_FILE);
+
+    return true;
+}
+
+bool KernelBenchModule::PreShut()
+{
+    std::cout << GET_CLASS_NAME(KernelBenchModule) << ", PreShut" << std::endl;
+    m_pKernelModule->DestroyAll();
+
+    return true;
+}
+
+void KernelBenchModule::EntityBench()
+{
+    std::vector<AFGUID> id_list(ENTITY_COUNT, NULL_GUID);
+
+    Run("entity_create", ENTITY_COUNT, [&](size_t i) {
+        auto pEntity = m_pKernelModule->CreateEntity(
+            NULL_GUID, MAP_ID, 0, AFEntityMetaPlayer::self_name(), NULL_INT, AFCDataList());
+        if (pEntity != nullptr)
+        {
+            id_list[i] = pEntity->GetID();
+        }
+    });
+
+    Run("entity_find", ENTITY_COUNT, [&](size_t i) { sink_ += (m_pKernelModule->GetEntity(id_list[i]) != nullptr); });
+
+    Run("entity_destroy", ENTITY_COUNT, [&](size_t i) { m_pKernelModule->DestroyEntity(id_list[i]); });
+}
+
+void KernelBenchModule::NodeBench()
+{
+    auto pEntity = CreatePlayer();
+    ARK_ASSERT_RET_NONE(pEntity != nullptr);
+
+    const std::string names[] = {"Xiaoming", "Xiaohong"};
+
+    Run("node_get_int_index", NODE_COUNT,
+        [&](size_t i) { sink_ += pEntity->GetInt32(AFEntityMetaPlayer::gender_index()); });
+
+    Run("node_get_int_name", NODE_COUNT,
+        [&](size_t i) { sink_ += pEntity->GetInt32(AFEntityMetaPlayer::gender()); });
+
+    Run("node_get_string_index", NODE_COUNT,
+        [&](size_t i) { sink_ += pEntity->GetString(AFEntityMetaPlayer::name_index()).size(); });
+
+    Run("node_set_int", NODE_COUNT,
+        [&](size_t i) { pEntity->SetInt32(AFEntityMetaPlayer::gender_index(), static_cast<int32_t>(i)); });
+
+    Run("node_set_string", NODE_COUNT,
+        [&](size_t i) { pEntity->SetString(AFEntityMetaPlayer::name_index(), names[i & 1]); });
+
+    // callbacks could not be removed, keep it the last one
+    m_pKernelModule->AddNodeCallBack(
+        AFEntityMetaPlayer::self_name(), AFEntityMetaPlayer::gender(), this, &KernelBenchModule::OnNodeCallBack);
+
+    Run("node_set_int_callback", NODE_COUNT,
+        [&](size_t i) { pEntity->SetInt32(AFEntityMetaPlayer::gender_index(), static_cast<int32_t>(i)); });
+
+    m_pKernelModule->DestroyEntity(pEntity->GetID());
+
+    // flush delay sync data of the above
+    m_pKernelModule->Update();
+}
+
+void KernelBenchModule::TableBench()
+{
+    auto pEntity = CreatePlayer();
+    ARK_ASSERT_RET_NONE(pEntity != nullptr);
+
+    AFITable* pTable = pEntity->FindTable(AFEntityMetaPlayer::items_index());
+    ARK_ASSERT_RET_NONE(pTable != nullptr);
+    pTable->Clear();
+
+    const uint32_t col_guid = AFEntityMetaItemBag::guid_index();
+    std::vector<uint32_t> row_list(TABLE_ROW_COUNT, 0u);
+
+    Run("table_add_row", TABLE_ROW_COUNT, [&](size_t i) {
+        auto pRow = pTable->AddRow(0);
+        if (pRow != nullptr)
+        {
+            pRow->SetInt64(col_guid, static_cast<int64_t>(i) + 1);
+            row_list[i] = pRow->GetRow();
+        }
+    });
+
+    Run("table_find_row", TABLE_ROW_COUNT, [&](size_t i) { sink_ += (pTable->FindRow(row_list[i]) != nullptr); });
+
+    Run("table_find_value", TABLE_ROW_COUNT,
+        [&](size_t i) { sink_ += pTable->FindInt64(col_guid, static_cast<int64_t>(i) + 1); });
+
+    Run("table_remove_row", TABLE_ROW_COUNT, [&](size_t i) { pTable->RemoveRow(row_list[i]); });
+
+    m_pKernelModule->DestroyEntity(pEntity->GetID());
+    m_pKernelModule->Update();
+}
+
+void KernelBenchModule::ContainerBench()
+{
+    auto pEntity = CreatePlayer();
+    ARK_ASSERT_RET_NONE(pEntity != nullptr);
+
+    const uint32_t bag_index = AFEntityMetaPlayer::bag_index();
+    auto pContainer = pEntity->FindContainer(bag_index);
+    ARK_ASSERT_RET_NONE(pContainer != nullptr);
+
+    auto pClassMeta = m_pClassMetaModule->FindMeta(AFEntityMetaPlayer::self_name());
+    ARK_ASSERT_RET_NONE(pClassMeta != nullptr);
+
+    auto pContainerMeta = pClassMeta->FindContainerMeta(bag_index);
+    ARK_ASSERT_RET_NONE(pContainerMeta != nullptr);
+
+    const AFGUID& self = pEntity->GetID();
+    const std::string& item_class = pContainerMeta->GetClassName();
+    std::vector<std::shared_ptr<AFIEntity>> item_list(CONTAINER_COUNT, nullptr);
+
+    Run("container_create_entity", CONTAINER_COUNT,
+        [&](size_t i) { item_list[i] = m_pKernelModule->CreateContainerEntity(self, bag_index, item_class, 0); });
+
+    std::vector<uint32_t> index_list(CONTAINER_COUNT, 0u);
+    for (size_t i = 0; i < CONTAINER_COUNT; ++i)
+    {
+        if (item_list[i] != nullptr)
+        {
+            index_list[i] = pContainer->Find(item_list[i]->GetID());
+        }
+    }
+
+    Run("container_swap", CONTAINER_COUNT,
+        [&](size_t i) { pContainer->Swap(index_list[i], index_list[CONTAINER_COUNT - 1 - i]); });
+
+    Run("container_remove", CONTAINER_COUNT, [&](size_t i) {
+        if (item_list[i] != nullptr)
+        {
+            pContainer->Remove(item_list[i]->GetID());
+        }
+    });
+
+    Run("container_place", CONTAINER_COUNT, [&](size_t i) {
+        if (item_list[i] != nullptr)
+        {
+            pContainer->Place(item_list[i]);
+        }
+    });
+
+    m_pKernelModule->DestroyEntity(self);
+    m_pKernelModule->Update();
+}
+
+void KernelBenchModule::DelaySyncBench()
+{
+    std::vector<std::shared_ptr<AFIEntity>> entity_list;
+    for (size_t i = 0; i < DELAY_SYNC_ENTITY_COUNT; ++i)
+    {
+        auto pEntity = CreatePlayer();
+        ARK_ASSERT_RET_NONE(pEntity != nullptr);
+
+        entity_list.push_back(pEntity);
+    }
+
+    m_pKernelModule->Update();
+
+    // only the flush is timed, changes are made before
+    int64_t total_ns = 0;
+    for (size_t round = 0; round < DELAY_SYNC_ROUND; ++round)
+    {
+        for (auto& pEntity : entity_list)
+        {
+            pEntity->SetInt32(AFEntityMetaPlayer::level_index(), static_cast<int32_t>(round));
+            pEntity->SetInt64(AFEntityMetaPlayer::exp_index(), static_cast<int64_t>(round));
+            pEntity->SetInt64(AFEntityMetaPlayer::gold_index(), static_cast<int64_t>(round));
+
+            AFITable* pTable = pEntity->FindTable(AFEntityMetaPlayer::items_index());
+            if (pTable != nullptr)
+            {
+                auto pRow = pTable->AddRow(0);
+                if (pRow != nullptr)
+                {
+                    pRow->SetInt32(AFEntityMetaItemBag::count_index(), static_cast<int32_t>(round));
+                }
+            }
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        m_pKernelModule->Update();
+        auto end = std::chrono::steady_clock::now();
+        total_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    }
+
+    AddResult("delay_sync_flush_entity", DELAY_SYNC_ROUND * DELAY_SYNC_ENTITY_COUNT, total_ns);
+
+    for (auto& pEntity : entity_list)
+    {
+        m_pKernelModule->DestroyEntity(pEntity->GetID());
+    }
+
+    m_pKernelModule->Update();
+}
+
+void KernelBenchModule::DBDataBench()
+{
+    std::vector<AFGUID> id_list;
+    for (size_t i = 0; i < DB_DATA_COUNT; ++i)
+    {
+        auto pEntity = CreatePlayer();
+        ARK_ASSERT_RET_NONE(pEntity != nullptr);
+
+        id_list.push_back(pEntity->GetID());
+    }
+
+    std::vector<AFMsg::pb_db_entity> pb_list(DB_DATA_COUNT);
+    Run("db_data_to_pb", DB_DATA_COUNT, [&](size_t i) { m_pKernelModule->EntityToDBData(id_list[i], pb_list[i]); });
+
+    std::vector<std::string> data_list(DB_DATA_COUNT);
+    Run("db_data_serialize", DB_DATA_COUNT, [&](size_t i) { pb_list[i].SerializeToString(&data_list[i]); });
+
+    for (auto& id : id_list)
+    {
+        m_pKernelModule->DestroyEntity(id);
+    }
+
+    Run("db_data_parse", DB_DATA_COUNT, [&](size_t i) { pb_list[i].ParseFromString(data_list[i]); });
+
+    Run("db_data_from_pb", DB_DATA_COUNT, [&](size_t i) { m_pKernelModule->CreateEntity(pb_list[i]); });
+
+    for (auto& id : id_list)
+    {
+        m_pKernelModule->DestroyEntity(id);
+    }
+
+    m_pKernelModule->Update();
+}
+
+void KernelBenchModule::AddResult(const std::string& name, const size_t count, const int64_t total_ns)
+{
+    BenchResult result;
+    result.name_ = name;
+    result.count_ = count;
+    result.total_ns_ = total_ns;
+    results_.push_back(result);
+
+    std::cout << "[" << name << "] count = " << count << " time = " << total_ns / 1000000 << " ms"
+              << " per op = " << (count > 0 ? total_ns / int64_t(count) : 0) << " ns" << std::endl;
+}
+
+bool KernelBenchModule::WriteResult(const std::string& file_path)
+{
+    std::ofstream out(file_path, std::ios::out | std::ios::trunc);
+    if (!out.is_open())
+    {
+        ARK_LOG_ERROR("open benchmark result failed, file = {}", file_path);
+        return false;
+    }
+
+    out << "{\n  \"benchmark\": \"kernel\",\n  \"results\": [\n";
+    for (size_t i = 0; i < results_.size(); ++i)
+    {
+        auto& result = results_[i];
+        double ns_per_op = result.count_ > 0 ? double(result.total_ns_) / result.count_ : 0.0;
+        double ops_per_sec = result.total_ns_ > 0 ? result.count_ * 1e9 / result.total_ns_ : 0.0;
+
+        out << ARK_FORMAT(
+            "    {{\"name\": \"{}\", \"count\": {}, \"total_ns\": {}, \"ns_per_op\": {:.2f}, \"ops_per_sec\": {:.2f}}}",
+            result.name_, result.count_, result.total_ns_, ns_per_op, ops_per_sec);
+        out << (i + 1 < results_.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+
+    ARK_LOG_INFO("benchmark finished, result = {} sink = {}", file_path, sink_);
+    return true;
+}
+
+std::shared_ptr<AFIEntity> KernelBenchModule::CreatePlayer()
+{
+    auto pEntity =
+        m_pKernelModule->CreateEntity(NULL_GUID, MAP_ID, 0, AFEntityMetaPlayer::self_name(), NULL_INT, AFCDataList());
+    ARK_ASSERT_RET_VAL(pEntity != nullptr, nullptr);
+
+    pEntity->SetString(AFEntityMetaPlayer::name_index(), "Xiaoming");
+    pEntity->SetInt32(AFEntityMetaPlayer::gender_index(), 1);
+    pEntity->SetInt32(AFEntityMetaPlayer::career_index(), 1);
+    pEntity->SetInt32(AFEntityMetaPlayer::level_index(), 1);
+
+    AFITable* pTable = pEntity->FindTable(AFEntityMetaPlayer::items_index());
+    ARK_ASSERT_RET_VAL(pTable != nullptr, nullptr);
+
+    auto pRow = pTable->AddRow(0);
+    ARK_ASSERT_RET_VAL(pRow != nullptr, nullptr);
+    pRow->SetInt64(AFEntityMetaItemBag::guid_index(), 1111);
+
+    return pEntity;
+}
+
+int KernelBenchModule::OnNodeCallBack(const AFGUID& self, const std::string& data_name, const uint32_t index,
+    const AFIData& old_value, const AFIData& new_value)
+{
+    ++sink_;
+    return 0;
+}
+
+} // namespace ark
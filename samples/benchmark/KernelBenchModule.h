@@ -0,0 +1,92 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPluginManager.hpp"
+#include "kernel/interface/AFIKernelModule.hpp"
+#include "kernel/interface/AFIClassMetaModule.hpp"
+#include "kernel/interface/AFIMapModule.hpp"
+#include "log/interface/AFILogModule.hpp"
+
+namespace ark {
+
+// Benchmark of kernel hot paths, results are written to kernel_bench.json in the working directory.
+// run in bin: ./bin/app --busid=1.0.1.1 --name=kernel_bench --plugin=plugin_conf/kernel_bench.plugin
+class KernelBenchModule final : public AFIModule
+{
+    ARK_DECLARE_MODULE_FUNCTIONS
+public:
+    explicit KernelBenchModule() = default;
+
+    bool Init() override;
+    bool PostInit() override;
+    bool PreShut() override;
+
+protected:
+    struct BenchResult
+    {
+        std::string name_;
+        size_t count_{0};
+        int64_t total_ns_{0};
+    };
+
+    void EntityBench();
+    void NodeBench();
+    void TableBench();
+    void ContainerBench();
+    void DelaySyncBench();
+    void DBDataBench();
+
+    // time count calls of func(i)
+    template<typename FUNC>
+    void Run(const std::string& name, const size_t count, FUNC&& func)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i)
+        {
+            func(i);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        AddResult(name, count, std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+    }
+
+    void AddResult(const std::string& name, const size_t count, const int64_t total_ns);
+    bool WriteResult(const std::string& file_path);
+
+    std::shared_ptr<AFIEntity> CreatePlayer();
+
+    int OnNodeCallBack(const AFGUID& self, const std::string& data_name, const uint32_t index,
+        const AFIData& old_value, const AFIData& new_value);
+
+private:
+    std::vector<BenchResult> results_;
+
+    // keep the compiler from removing benchmark loops
+    int64_t sink_{0};
+
+    AFIKernelModule* m_pKernelModule;
+    AFIClassMetaModule* m_pClassMetaModule;
+    AFIMapModule* m_pMapModule;
+    AFILogModule* m_pLogModule;
+};
+
+} // namespace ark
@@ -100,6 +100,11 @@ public:
     int bus_id{0};
     uint32_t max_connection{0};
     uint8_t thread_num{0};
+    uint8_t logic_thread_num{0}; // workers handling messages by actor id, 0 means handling in main thread
+    uint32_t net_frame_budget{0}; // us of inbound message processing every frame, 0 means default
+    uint32_t send_low_watermark{0};  // KB queued per session to end congestion, 0 means default
+    uint32_t send_high_watermark{0}; // KB queued per session to start congestion, 0 means default
+    uint32_t send_hard_limit{0};     // KB queued per session to disconnect it, 0 means default
     AFEndpoint intranet_ep;
     AFEndpoint server_ep;
     // to add other fields
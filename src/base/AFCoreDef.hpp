@@ -25,6 +25,281 @@
 
 namespace ark {
 
+// Allocation counters of CoreAlloc and tagged objects, one instance per plugin module.
+// Every allocation is charged to the alloc tag of the calling thread, e.g. a class name set by kernel
+// around entity creation. The tag is kept in a small head before the block, so a free is charged back
+// to the same tag whichever thread and scope it happens in.
+class AFAllocCounter
+{
+public:
+    static const uint32_t NULL_TAG = 0;
+    static const uint32_t MAX_TAG_COUNT = 2048;
+
+    // head before every counted block, keeps the block aligned as operator new does
+    static const size_t HEAD_SIZE = 16;
+
+    struct TagStat
+    {
+        int64_t live_count_{0};
+        int64_t live_bytes_{0};
+        int64_t total_count_{0};
+    };
+
+    static AFAllocCounter& Instance()
+    {
+        static AFAllocCounter counter;
+        return counter;
+    }
+
+    // tag of the calling thread, see AFAllocTagScope
+    static uint32_t& CurrentTag()
+    {
+        static thread_local uint32_t tag = NULL_TAG;
+        return tag;
+    }
+
+    AFAllocCounter()
+    {
+        tag_names_.emplace_back("untagged");
+    }
+
+    // return the same tag for the same name, NULL_TAG when tags run out
+    uint32_t RegisterTag(const std::string& name)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        auto iter = tag_index_.find(name);
+        if (iter != tag_index_.end())
+        {
+            return iter->second;
+        }
+
+        if (tag_names_.size() >= MAX_TAG_COUNT)
+        {
+            return NULL_TAG;
+        }
+
+        uint32_t tag = static_cast<uint32_t>(tag_names_.size());
+        tag_names_.emplace_back(name);
+        tag_index_.insert(std::make_pair(name, tag));
+        return tag;
+    }
+
+    void* Alloc(size_t size)
+    {
+        char* head = static_cast<char*>(::operator new(HEAD_SIZE + size, std::nothrow));
+        if (head == nullptr)
+        {
+            return nullptr;
+        }
+
+        uint32_t tag = CurrentTag();
+        memcpy(head, &tag, sizeof(tag));
+        memcpy(head + sizeof(tag), &size, sizeof(size));
+
+        auto& counter = tag_counters_[tag];
+        counter.alloc_count_.fetch_add(1, std::memory_order_relaxed);
+        counter.alloc_bytes_.fetch_add(size, std::memory_order_relaxed);
+        return head + HEAD_SIZE;
+    }
+
+    void Free(void* ptr)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        char* head = static_cast<char*>(ptr) - HEAD_SIZE;
+        uint32_t tag = NULL_TAG;
+        size_t size = 0;
+        memcpy(&tag, head, sizeof(tag));
+        memcpy(&size, head + sizeof(tag), sizeof(size));
+
+        auto& counter = tag_counters_[tag];
+        counter.free_count_.fetch_add(1, std::memory_order_relaxed);
+        counter.free_bytes_.fetch_add(size, std::memory_order_relaxed);
+        ::operator delete(head);
+    }
+
+    int64_t GetAllocCount() const
+    {
+        int64_t count = 0;
+        for (auto& counter : tag_counters_)
+        {
+            count += counter.alloc_count_.load(std::memory_order_relaxed);
+        }
+
+        return count;
+    }
+
+    int64_t GetLiveCount() const
+    {
+        int64_t count = 0;
+        for (auto& counter : tag_counters_)
+        {
+            count += counter.GetLiveCount();
+        }
+
+        return count;
+    }
+
+    int64_t GetLiveBytes() const
+    {
+        int64_t bytes = 0;
+        for (auto& counter : tag_counters_)
+        {
+            bytes += counter.GetLiveBytes();
+        }
+
+        return bytes;
+    }
+
+    // stat of every tag ever allocated from, by tag name
+    void GetTagStats(std::map<std::string, TagStat>& stats) const
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        for (size_t tag = 0; tag < tag_names_.size(); ++tag)
+        {
+            auto& counter = tag_counters_[tag];
+            TagStat stat;
+            stat.total_count_ = counter.alloc_count_.load(std::memory_order_relaxed);
+            if (stat.total_count_ == 0)
+            {
+                continue;
+            }
+
+            stat.live_count_ = counter.GetLiveCount();
+            stat.live_bytes_ = counter.GetLiveBytes();
+            stats[tag_names_[tag]] = stat;
+        }
+    }
+
+private:
+    static_assert(HEAD_SIZE >= sizeof(uint32_t) + sizeof(size_t), "alloc head too small");
+
+    struct TagCounter
+    {
+        std::atomic<int64_t> alloc_count_{0};
+        std::atomic<int64_t> free_count_{0};
+        std::atomic<int64_t> alloc_bytes_{0};
+        std::atomic<int64_t> free_bytes_{0};
+
+        int64_t GetLiveCount() const
+        {
+            return alloc_count_.load(std::memory_order_relaxed) - free_count_.load(std::memory_order_relaxed);
+        }
+
+        int64_t GetLiveBytes() const
+        {
+            return alloc_bytes_.load(std::memory_order_relaxed) - free_bytes_.load(std::memory_order_relaxed);
+        }
+    };
+
+    std::array<TagCounter, MAX_TAG_COUNT> tag_counters_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::string> tag_names_;
+    std::unordered_map<std::string, uint32_t> tag_index_;
+};
+
+// charge allocations of the calling thread to a tag until the scope ends
+class AFAllocTagScope final
+{
+public:
+    explicit AFAllocTagScope(const uint32_t tag)
+        : prev_tag_(AFAllocCounter::CurrentTag())
+    {
+        AFAllocCounter::CurrentTag() = tag;
+    }
+
+    ~AFAllocTagScope()
+    {
+        AFAllocCounter::CurrentTag() = prev_tag_;
+    }
+
+    AFAllocTagScope(const AFAllocTagScope&) = delete;
+    AFAllocTagScope& operator=(const AFAllocTagScope&) = delete;
+
+private:
+    uint32_t prev_tag_{AFAllocCounter::NULL_TAG};
+};
+
+// objects of a derived class created by new are counted, e.g. tables, rows and nodes created with ARK_NEW
+class AFAllocTagged
+{
+public:
+    static void* operator new(size_t size)
+    {
+        void* ptr = AFAllocCounter::Instance().Alloc(size);
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        return ptr;
+    }
+
+    static void* operator new(size_t size, const std::nothrow_t&) noexcept
+    {
+        return AFAllocCounter::Instance().Alloc(size);
+    }
+
+    static void operator delete(void* ptr) noexcept
+    {
+        AFAllocCounter::Instance().Free(ptr);
+    }
+
+    static void operator delete(void* ptr, const std::nothrow_t&) noexcept
+    {
+        AFAllocCounter::Instance().Free(ptr);
+    }
+};
+
+// allocator of std::allocate_shared, counts objects kept by shared_ptr, e.g. entities and node managers
+template<typename T>
+class AFTagAllocator
+{
+public:
+    using value_type = T;
+
+    AFTagAllocator() = default;
+
+    template<typename U>
+    AFTagAllocator(const AFTagAllocator<U>&)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        void* ptr = AFAllocCounter::Instance().Alloc(n * sizeof(T));
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        AFAllocCounter::Instance().Free(ptr);
+    }
+
+    template<typename U>
+    bool operator==(const AFTagAllocator<U>&) const
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const AFTagAllocator<U>&) const
+    {
+        return false;
+    }
+};
+
 class CoreAlloc
 {
 public:
@@ -33,12 +308,12 @@ public:
 
     void* Alloc(size_t size)
     {
-        ARK_NEW_ARRAY_RET(char, size);
+        return AFAllocCounter::Instance().Alloc(size);
     }
 
     void Free(void* ptr, size_t size)
     {
-        ARK_DELETE_ARRAY(char, ptr);
+        AFAllocCounter::Instance().Free(ptr);
     }
 
     void Swap(CoreAlloc& src)
@@ -42,6 +42,7 @@ const static nullptr_t NULL_POINT = nullptr;
 const static AFVector3D NULL_VECTOR3D = AFVector3D(0.0F, 0.0F, 0.0F);
 
 const static std::string CONFIG_CLASS_FILE_PATH = "meta/config_class.config";
+const static std::string CONFIG_IMAGE_FILE_PATH = "meta/config_class.image";
 const static std::string ENTITY_CLASS_FILE_PATH = "meta/entity_class.config";
 const static std::string PROC_CONFIG_FILE_PATH = "conf/proc.xml";
 const static std::string BUS_RELATION_CONFIG_FILE_PATH = "conf/bus_relation.xml";
@@ -92,5 +93,6 @@ using MOVE_EVENT_FUNCTOR = std::function<bool(const AFGUID&, const AFVector3D&,
 using EVENT_PROCESS_FUNCTOR = std::function<int(const AFGUID&, const int, const AFIDataList&)>;
 using TIMER_FUNCTOR = std::function<void(uint64_t, const AFGUID&)>;
 using SCHEDULER_FUNCTOR = std::function<void()>;
+using CONFIG_RELOAD_FUNCTOR = std::function<void(const std::string&, const std::vector<ID_TYPE>&)>;
 
 } // namespace ark
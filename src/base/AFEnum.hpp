@@ -64,6 +64,9 @@ enum class ArkEntityEvent : uint32_t
     ENTITY_EVT_POST_EFFECT_DATA,
     ENTITY_EVT_DATA_FINISHED,
     ENTITY_EVT_ALL_FINISHED, // Call it by yourself when create entity finished
+    ENTITY_EVT_MIGRATE_OUT,  // before the entity is serialized to migrate, save runtime state (e.g. timers) to data
+    ENTITY_EVT_MIGRATE_IN,   // after the entity is recreated by migrating, restore runtime state
+    ENTITY_EVT_MIGRATE_FAIL, // migrating is failed, the entity stays on this process
 };
 
 enum class ArkDataOpType : uint16_t
@@ -98,6 +101,7 @@ enum class ArkDataMask : uint16_t
     PF_SYNC_GUILD = 5, // sync to guild member
     PF_SYNC_MAP = 6,   // sync to all player in same map
     PF_LOG = 7,        // log when changed
+    PF_INTERN = 8,     // enum-like string, values are interned and shared
 };
 
 enum class ArkContainerOpType : uint32_t
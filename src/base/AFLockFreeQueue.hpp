@@ -51,4 +51,71 @@ private:
     moodycamel::BlockingReaderWriterQueue<T> queue_;
 };
 
+// multiple producers push without lock, the single consumer takes all pushed objects at once
+template<typename T>
+class AFMpscQueue
+{
+public:
+    AFMpscQueue() = default;
+
+    ~AFMpscQueue()
+    {
+        Node* node = head_.exchange(nullptr);
+        while (node != nullptr)
+        {
+            Node* next = node->next_;
+            delete node;
+            node = next;
+        }
+    }
+
+    bool Push(const T& object)
+    {
+        Node* node = new (std::nothrow) Node();
+        if (node == nullptr)
+        {
+            return false;
+        }
+
+        node->object_ = object;
+        node->next_ = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(node->next_, node, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+
+        return true;
+    }
+
+    // append all pushed objects to the list in push order
+    bool PopAll(std::vector<T>& object_list)
+    {
+        Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+        if (node == nullptr)
+        {
+            return false;
+        }
+
+        size_t begin = object_list.size();
+        while (node != nullptr)
+        {
+            object_list.push_back(node->object_);
+            Node* next = node->next_;
+            delete node;
+            node = next;
+        }
+
+        std::reverse(object_list.begin() + begin, object_list.end());
+        return true;
+    }
+
+private:
+    struct Node
+    {
+        T object_{};
+        Node* next_{nullptr};
+    };
+
+    std::atomic<Node*> head_{nullptr};
+};
+
 } // namespace ark
@@ -0,0 +1,179 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPlatform.hpp"
+#include "base/AFMacros.hpp"
+#include "base/AFDateTime.hpp"
+
+namespace ark {
+
+class AFMailbox;
+using MAILBOX_FUNCTOR = std::function<void(AFMailbox&)>;
+
+// Serial executor of posted functors.
+// Messages and timers of one mailbox are executed in post order and never concurrently,
+// different mailboxes run on the scheduler workers in parallel.
+// Posting is thread safe, everything else belongs to the mailbox itself.
+//
+// A mailbox owns nothing but its messages, they work on the state they capture. Kernel entities belong to the
+// main loop, reach them with AFIMapModule::PostMainMessage, entity creation and destruction assert in a mailbox.
+class AFMailbox final : public std::enable_shared_from_this<AFMailbox>
+{
+public:
+    using SCHEDULE_FUNCTOR = std::function<void(std::shared_ptr<AFMailbox>)>;
+
+    explicit AFMailbox(SCHEDULE_FUNCTOR&& schedule)
+        : schedule_(std::move(schedule))
+    {
+    }
+
+    // post a message, delay in milliseconds, return false if the mailbox is closed
+    bool Post(MAILBOX_FUNCTOR&& func, const int64_t delay = 0)
+    {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (closed_)
+            {
+                return false;
+            }
+
+            if (delay <= 0)
+            {
+                mailbox_.emplace_back(std::move(func));
+            }
+            else
+            {
+                auto due_time = AFDateTime::GetNowTime() + delay;
+                timers_.emplace(due_time, std::move(func));
+                next_timer_time_ = timers_.begin()->first;
+                return true;
+            }
+        }
+
+        Schedule();
+        return true;
+    }
+
+    // called by scheduler tick, wake up the mailbox if a timer is due
+    void CheckTimer(const int64_t now)
+    {
+        auto next_time = next_timer_time_.load(std::memory_order_relaxed);
+        if (next_time == 0 || next_time > now)
+        {
+            return;
+        }
+
+        Schedule();
+    }
+
+    // the mailbox running on this thread, nullptr on the main loop
+    static AFMailbox* Current()
+    {
+        return CurrentRef();
+    }
+
+    // run on a worker
+    void Run()
+    {
+        std::deque<MAILBOX_FUNCTOR> messages;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            messages.swap(mailbox_);
+
+            auto now = AFDateTime::GetNowTime();
+            auto iter = timers_.begin();
+            for (; iter != timers_.end() && iter->first <= now; ++iter)
+            {
+                messages.emplace_back(std::move(iter->second));
+            }
+
+            timers_.erase(timers_.begin(), iter);
+            next_timer_time_ = timers_.empty() ? 0 : timers_.begin()->first;
+        }
+
+        CurrentRef() = this;
+        for (auto& func : messages)
+        {
+            func(*this);
+        }
+        CurrentRef() = nullptr;
+
+        scheduled_.store(false);
+
+        // messages posted while running saw scheduled_ and did not schedule again
+        bool pending = false;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            pending = !mailbox_.empty();
+        }
+
+        if (pending)
+        {
+            Schedule();
+        }
+    }
+
+    // drop all messages and refuse new ones
+    void Close()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        closed_ = true;
+        mailbox_.clear();
+        timers_.clear();
+        next_timer_time_ = 0;
+    }
+
+    bool IsClosed() const
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return closed_;
+    }
+
+private:
+    static AFMailbox*& CurrentRef()
+    {
+        static thread_local AFMailbox* current = nullptr;
+        return current;
+    }
+
+    void Schedule()
+    {
+        if (scheduled_.exchange(true))
+        {
+            return;
+        }
+
+        schedule_(shared_from_this());
+    }
+
+    SCHEDULE_FUNCTOR schedule_;
+
+    mutable std::mutex mutex_;
+    bool closed_{false};
+    std::deque<MAILBOX_FUNCTOR> mailbox_;
+    std::multimap<int64_t, MAILBOX_FUNCTOR> timers_;
+
+    std::atomic<int64_t> next_timer_time_{0};
+    std::atomic<bool> scheduled_{false};
+};
+
+} // namespace ark
@@ -0,0 +1,106 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <ctpl/ctpl_stl.h>
+
+#include "base/AFPlatform.hpp"
+#include "base/AFMailbox.hpp"
+
+namespace ark {
+
+// Multiplex mailboxes on a fixed pool of worker threads.
+// A mailbox is pushed to the pool only when it has work and is never run by two workers at once.
+// Creating, destroying and ticking mailboxes must happen on the owner thread.
+class AFMailboxScheduler final
+{
+public:
+    explicit AFMailboxScheduler(const size_t thread_count)
+        : pool_(static_cast<int>(thread_count))
+    {
+    }
+
+    ~AFMailboxScheduler()
+    {
+        Stop();
+    }
+
+    std::shared_ptr<AFMailbox> CreateMailbox()
+    {
+        auto func = std::bind(&AFMailboxScheduler::Schedule, this, std::placeholders::_1);
+        auto pMailbox = std::make_shared<AFMailbox>(std::move(func));
+        mailbox_list_.push_back(pMailbox);
+
+        return pMailbox;
+    }
+
+    void DestroyMailbox(std::shared_ptr<AFMailbox> pMailbox)
+    {
+        ARK_ASSERT_RET_NONE(pMailbox != nullptr);
+
+        pMailbox->Close();
+
+        auto iter = std::find(mailbox_list_.begin(), mailbox_list_.end(), pMailbox);
+        if (iter != mailbox_list_.end())
+        {
+            *iter = mailbox_list_.back();
+            mailbox_list_.pop_back();
+        }
+    }
+
+    // wake up mailboxes whose timers are due
+    void Tick()
+    {
+        auto now = AFDateTime::GetNowTime();
+        for (auto& pMailbox : mailbox_list_)
+        {
+            pMailbox->CheckTimer(now);
+        }
+    }
+
+    size_t GetMailboxCount() const
+    {
+        return mailbox_list_.size();
+    }
+
+    // close all mailboxes and wait for the running ones
+    void Stop()
+    {
+        for (auto& pMailbox : mailbox_list_)
+        {
+            pMailbox->Close();
+        }
+
+        mailbox_list_.clear();
+        pool_.stop(true);
+    }
+
+private:
+    void Schedule(std::shared_ptr<AFMailbox> pMailbox)
+    {
+        pool_.push([pMailbox](int) { pMailbox->Run(); });
+    }
+
+    ctpl::thread_pool pool_;
+    std::vector<std::shared_ptr<AFMailbox>> mailbox_list_;
+};
+
+} // namespace ark
@@ -60,6 +60,12 @@ public:
         return nodes_.empty();
     }
 
+    // approximate, every map node holds a value and about four pointers
+    std::size_t GetMemUsage() const
+    {
+        return sizeof(*this) + nodes_.size() * (sizeof(value_type) + 4 * sizeof(void*));
+    }
+
     std::pair<iterator, bool> insert(const k_type& key, const v_type& value)
     {
         return nodes_.insert(value_type(key, value));
@@ -208,6 +214,12 @@ public:
         return nodes_.empty();
     }
 
+    // approximate, every map node holds a value and about four pointers
+    std::size_t GetMemUsage() const
+    {
+        return sizeof(*this) + nodes_.size() * (sizeof(value_type) + 4 * sizeof(void*));
+    }
+
     std::pair<iterator, bool> insert(const k_type& key, const v_type& value)
     {
         return nodes_.insert(value_type(key, value));
@@ -35,6 +35,7 @@
 #include <stdexcept>
 #include <string>
 #include <vector>
+#include <array>
 #include <map>
 #include <list>
 #include <set>
@@ -45,6 +46,7 @@
 #include <functional>
 #include <iterator>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 #include <memory>
 #include <chrono>
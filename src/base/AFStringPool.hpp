@@ -0,0 +1,52 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <unordered_set>
+#include "base/AFPlatform.hpp"
+#include "base/AFSingleton.hpp"
+
+namespace ark {
+
+// Interned strings, every distinct value is stored once and never released,
+// so references returned by Intern stay valid and can be copied and compared as pointers.
+// Only for small sets of repetitive values, e.g. enum-like string fields.
+class AFStringPool final : public AFSingleton<AFStringPool>
+{
+public:
+    const std::string& Intern(const std::string& value)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return *strings_.insert(value).first;
+    }
+
+    size_t GetCount()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return strings_.size();
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_set<std::string> strings_;
+};
+
+} // namespace ark
@@ -136,6 +136,17 @@ public:
         return true;
     }
 
+    // timers of a paused entity keep their slot but do not fire until resumed
+    void PauseTimer(const AFGUID& entity_id)
+    {
+        paused_entities_.insert(entity_id);
+    }
+
+    void ResumeTimer(const AFGUID& entity_id)
+    {
+        paused_entities_.erase(entity_id);
+    }
+
 protected:
     void InitTimerVec(AFTimeWheelVec* tv, int32_t size)
     {
@@ -236,6 +247,14 @@ protected:
                 continue;
             }
 
+            // skip this round without spending the count
+            if (!paused_entities_.empty() && paused_entities_.find(timer->entity_id) != paused_entities_.end())
+            {
+                timer->expires = static_cast<uint64_t>(now_slot_) + std::max<uint64_t>(timer->interval, 1u);
+                AddTimerInternal(timer);
+                continue;
+            }
+
             // timer handler
             (timer->callback)(timer->idx, timer->entity_id);
 
@@ -284,6 +303,7 @@ private:
     uint64_t timer_idx_{0};
     std::unordered_map<uint64_t, AFTimeWheelData*> timers_;
     std::list<AFTimeWheelData*> free_timers_;
+    std::unordered_set<AFGUID> paused_entities_;
 };
 
 } // namespace ark
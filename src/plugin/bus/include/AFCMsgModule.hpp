@@ -55,6 +55,8 @@ public:
         const AFGUID& guid = NULL_GUID) override;
     bool SendMsgByBusID(const int bus_id, const int msg_id, const google::protobuf::Message& msg,
         const AFGUID& guid = NULL_GUID) override;
+    bool SendMsgByRelay(const ARK_APP_TYPE relay_app_type, const int target_bus, const int msg_id,
+        const google::protobuf::Message& msg, const AFGUID& guid = NULL_GUID) override;
 
 protected:
     bool SendMsg(std::shared_ptr<AFINet>& pNet, const int src_bus, const int target_bus, const int msg_id,
@@ -55,6 +55,9 @@ public:
         const AFGUID& guid = NULL_GUID) = 0;
     virtual bool SendMsgByBusID(
         const int bus_id, const int msg_id, const google::protobuf::Message& msg, const AFGUID& guid = NULL_GUID) = 0;
+    // send through a process of relay_app_type, the head keeps target_bus as dst bus for the relay to look up
+    virtual bool SendMsgByRelay(const ARK_APP_TYPE relay_app_type, const int target_bus, const int msg_id,
+        const google::protobuf::Message& msg, const AFGUID& guid = NULL_GUID) = 0;
 
     static bool RecvPB(const AFNetMsg* msg, std::string& str_msg, AFGUID& actor_id)
     {
@@ -60,6 +60,11 @@ bool AFCBusModule::LoadProcConfig()
         std::string endpoint_intranet = proc_node.GetString("endpoint_intranet");
         uint32_t max_connection = proc_node.GetUint32("max_connection");
         uint8_t thread_num = static_cast<uint8_t>(proc_node.GetUint32("thread_num"));
+        uint8_t logic_thread_num = static_cast<uint8_t>(proc_node.GetUint32("logic_thread_num"));
+        uint32_t net_frame_budget = proc_node.GetUint32("net_frame_budget");
+        uint32_t send_low_watermark = proc_node.GetUint32("send_low_watermark");
+        uint32_t send_high_watermark = proc_node.GetUint32("send_high_watermark");
+        uint32_t send_hard_limit = proc_node.GetUint32("send_hard_limit");
 
         AFBusAddr bus_addr;
         ARK_ASSERT_CONTINUE(bus_addr.FromString(bus_name));
@@ -72,6 +77,11 @@ bool AFCBusModule::LoadProcConfig()
 
         app_config_.self_proc.bus_id = bus_addr.bus_id;
         app_config_.self_proc.thread_num = thread_num;
+        app_config_.self_proc.logic_thread_num = logic_thread_num;
+        app_config_.self_proc.net_frame_budget = net_frame_budget;
+        app_config_.self_proc.send_low_watermark = send_low_watermark;
+        app_config_.self_proc.send_high_watermark = send_high_watermark;
+        app_config_.self_proc.send_hard_limit = send_hard_limit;
         app_config_.self_proc.max_connection = max_connection;
 
         std::error_code ec;
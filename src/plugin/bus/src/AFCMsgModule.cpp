@@ -141,6 +141,29 @@ bool AFCMsgModule::SendMsgByBusID(
     return SendMsg(pNet, src_bus, bus_id, msg_id, msg, guid);
 }
 
+bool AFCMsgModule::SendMsgByRelay(const ARK_APP_TYPE relay_app_type, const int target_bus, const int msg_id,
+    const google::protobuf::Message& msg, const AFGUID& guid /* = NULL_GUID*/)
+{
+    auto pClientService = m_pNetServiceManagerModule->GetClientService(relay_app_type);
+    if (pClientService == nullptr)
+    {
+        ARK_LOG_ERROR("net client service not be found, src_bus={} relay_app_type={} target_bus={} msg_id={}",
+            m_pBusModule->GetSelfBusID(), (uint8_t)relay_app_type, target_bus, msg_id);
+        return false;
+    }
+
+    auto busid = m_pBusModule->GetSelfBusID();
+    auto pConnetionInfo = pClientService->GetSuitableConnect(AFMisc::ToString(busid));
+    if (pConnetionInfo == nullptr)
+    {
+        ARK_LOG_ERROR("connection info not be found, src_bus={} relay_app_type={} target_bus={} msg_id={}",
+            m_pBusModule->GetSelfBusID(), (uint8_t)relay_app_type, target_bus, msg_id);
+        return false;
+    }
+
+    return SendMsg(pConnetionInfo->net_client_, busid, target_bus, msg_id, msg, guid);
+}
+
 bool AFCMsgModule::SendMsg(std::shared_ptr<AFINet>& pNet, const int src_bus, const int target_bus, const int msg_id,
     const google::protobuf::Message& msg, const AFGUID& guid)
 {
@@ -152,7 +175,7 @@ bool AFCMsgModule::SendMsg(std::shared_ptr<AFINet>& pNet, const int src_bus, con
     }
 
     std::string msg_data;
-    if (msg.SerializeToString(&msg_data))
+    if (!msg.SerializeToString(&msg_data))
     {
         ARK_LOG_ERROR("msg serializing failed, src_bus={} target_bus={} msg_id={} actor_id={}", src_bus, target_bus,
             msg_id, guid);
@@ -41,7 +41,8 @@ public:
 
     bool Load() override;
 
-    bool AddClassCallBack(const std::string& class_name, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio) override;
+    bool AddClassCallBack(const std::string& class_name, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio,
+        const std::string& owner) override;
 
     bool DoClassEvent(const AFGUID& id, const std::string& class_name, const ArkEntityEvent class_event,
         const AFIDataList& args) override;
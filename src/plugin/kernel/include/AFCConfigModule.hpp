@@ -24,6 +24,7 @@
 #include "base/AFPluginManager.hpp"
 #include "log/interface/AFILogModule.hpp"
 #include "kernel/interface/AFIClassMetaModule.hpp"
+#include "kernel/include/AFConfigImage.hpp"
 
 namespace ark {
 
@@ -33,15 +34,38 @@ class AFCConfigModule final : public AFIConfigModule
 public:
     bool Init() override;
     bool Shut() override;
+    bool Update() override;
 
     bool Load() override;
     bool Save() override;
     bool Clear() override;
 
+    bool Reload() override;
+    bool AddReloadCallBack(CONFIG_RELOAD_FUNCTOR&& cb) override;
+
     std::shared_ptr<AFIStaticEntity> FindStaticEntity(const ID_TYPE config_id) override;
 
 protected:
-    bool LoadConfig(std::shared_ptr<AFClassMeta> pClassMeta);
+    using ConfigRows = std::vector<std::pair<ID_TYPE, std::shared_ptr<AFNodeManager>>>;
+
+    // parse xml files of classes on a thread pool and merge the results into static entity manager
+    bool LoadConfigParallel(const std::vector<std::shared_ptr<AFClassMeta>>& class_meta_list);
+
+    // parse a class xml into rows, run on worker thread, must not touch static entity manager
+    bool LoadConfig(std::shared_ptr<AFClassMeta> pClassMeta, ConfigRows& rows);
+
+    struct ReloadResult
+    {
+        bool ret_{false};
+        std::shared_ptr<AFClassMeta> class_meta_{nullptr};
+        AFConfigImage::SourceInfo source_info_;
+        ConfigRows rows_;
+    };
+
+    using ReloadResultList = std::vector<ReloadResult>;
+
+    // swap changed static entities in and fire reload callbacks, run on main thread
+    void ApplyReload(ReloadResultList& result_list);
 
 private:
     bool loaded_{false};
@@ -50,6 +74,12 @@ private:
     AFIClassMetaModule* m_pClassModule{nullptr};
 
     AFStaticEntityManager* m_pStaticEntityManager{nullptr};
+
+    // class name -> source file info when last loaded
+    AFConfigImage::SourceInfoList source_info_list_;
+
+    std::future<ReloadResultList> reload_future_;
+    std::vector<CONFIG_RELOAD_FUNCTOR> reload_call_backs_;
 };
 
 } // namespace ark
@@ -50,11 +50,14 @@ private:
     // call back
     std::shared_ptr<AFClassCallBackManager> call_back_mgr_{nullptr};
 
+    // frozen flag of the parent entity
+    std::shared_ptr<const bool> frozen_{nullptr};
+
 public:
     AFCContainer() = delete;
 
     explicit AFCContainer(std::shared_ptr<AFContainerMeta> container_meta, const AFGUID& parent_id,
-        std::shared_ptr<AFClassCallBackManager> class_meta);
+        std::shared_ptr<AFClassCallBackManager> class_meta, std::shared_ptr<const bool> frozen);
 
     const std::string& GetName() const override;
 
@@ -91,9 +94,13 @@ public:
     bool Destroy(const uint32_t index) override;
     bool Destroy(const AFGUID& id) override;
 
+    size_t GetMemUsage() const override;
+
 private:
     uint32_t SelectIndex() const;
 
+    bool IsFrozen() const;
+
     bool PlaceEntity(const uint32_t index, std::shared_ptr<AFIEntity> pEntity);
 
     void OnContainerPlace(const uint32_t index, std::shared_ptr<AFIEntity> pEntity);
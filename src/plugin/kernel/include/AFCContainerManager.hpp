@@ -31,8 +31,17 @@ private:
     // container
     ContainerList container_data_;
 
+    // frozen flag of the owner entity
+    std::shared_ptr<const bool> frozen_{nullptr};
+
+    // containers created later are counted with the tag the manager was created with
+    uint32_t alloc_tag_{AFAllocCounter::CurrentTag()};
+
 public:
-    explicit AFCContainerManager() = default;
+    explicit AFCContainerManager(std::shared_ptr<const bool> frozen)
+        : frozen_(frozen)
+    {
+    }
 
     // find container
     std::shared_ptr<AFIContainer> FindContainer(const uint32_t index) const override;
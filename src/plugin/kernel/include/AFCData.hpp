@@ -566,9 +566,10 @@ public:
         {
             case ArkDataType::DT_STRING:
             {
-                if (mstrValue != nullptr)
+                // inline string takes no extra memory
+                if (mstrValue != nullptr && mstrValue != mBuffer)
                 {
-                    size += strlen(mstrValue) + 1;
+                    size += mnAllocLen;
                 }
             }
             break;
@@ -576,7 +577,7 @@ public:
             {
                 if (mpUserData != nullptr)
                 {
-                    size += AFIData::GetUserDataSize(mpUserData);
+                    size += mnAllocLen;
                 }
             }
             break;
@@ -720,7 +721,7 @@ private:
     };
 };
 
-// special
-using AFCData = AFDataBase<4, CoreAlloc>;
+// special, strings shorter than 32 bytes are kept inline
+using AFCData = AFDataBase<32, CoreAlloc>;
 
 } // namespace ark
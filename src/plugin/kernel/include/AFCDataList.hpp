@@ -160,13 +160,23 @@ public:
         InnerAppend(src, 0, src.GetCount());
     }
 
+    AFBaseDataList(self_t&& src) noexcept
+    {
+        InnerMove(src);
+    }
+
     virtual ~AFBaseDataList()
     {
         Release();
     }
 
-    self_t operator=(const self_t& src)
+    self_t& operator=(const self_t& src)
     {
+        if (this == &src)
+        {
+            return *this;
+        }
+
         Release();
 
         mpData = mDataStack;
@@ -181,6 +191,17 @@ public:
         return *this;
     }
 
+    self_t& operator=(self_t&& src) noexcept
+    {
+        if (this != &src)
+        {
+            Release();
+            InnerMove(src);
+        }
+
+        return *this;
+    }
+
     void Release()
     {
         if (mnDataSize > DATA_SIZE)
@@ -940,6 +961,45 @@ protected:
         ARK_ASSERT_NO_EFFECT(bRet);
     }
 
+    // take heap storage of src, inline storage has to be copied
+    void InnerMove(self_t& src)
+    {
+        mxAlloc.Swap(src.mxAlloc);
+
+        if (src.mnDataSize > DATA_SIZE)
+        {
+            mpData = src.mpData;
+        }
+        else
+        {
+            mpData = mDataStack;
+            memcpy(mDataStack, src.mDataStack, src.mnDataUsed * sizeof(dynamic_data_t));
+        }
+
+        mnDataSize = src.mnDataSize;
+        mnDataUsed = src.mnDataUsed;
+
+        if (src.mnBufferSize > BUFFER_SIZE)
+        {
+            mpBuffer = src.mpBuffer;
+        }
+        else
+        {
+            mpBuffer = mBufferStack;
+            memcpy(mBufferStack, src.mBufferStack, src.mnBufferUsed);
+        }
+
+        mnBufferSize = src.mnBufferSize;
+        mnBufferUsed = src.mnBufferUsed;
+
+        src.mpData = src.mDataStack;
+        src.mnDataSize = DATA_SIZE;
+        src.mnDataUsed = 0;
+        src.mpBuffer = src.mBufferStack;
+        src.mnBufferSize = BUFFER_SIZE;
+        src.mnBufferUsed = 0;
+    }
+
     bool InnerAppend(const AFIDataList& src, size_t start, size_t end)
     {
         bool bRet(false);
@@ -1005,4 +1065,7 @@ private:
 
 using AFCDataList = AFBaseDataList<8, 128>;
 
+// id lists of map queries, a common map instance fits without heap allocation
+using AFCEntityList = AFBaseDataList<256, 8>;
+
 } // namespace ark
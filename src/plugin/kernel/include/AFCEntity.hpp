@@ -27,8 +27,8 @@
 #include "AFClassCallBackManager.hpp"
 #include "kernel/interface/AFIContainerManager.hpp"
 #include "AFNodeManager.hpp"
+#include "AFCData.hpp"
 #include "AFTableManager.hpp"
-#include "kernel/interface/AFIEventManager.hpp"
 #include "kernel/interface/AFINode.hpp"
 #include "base/AFDefine.hpp"
 #include "kernel/interface/AFIDataList.hpp"
@@ -39,11 +39,11 @@ namespace ark {
 class AFEntityOptCharactor
 {
 public:
-    AFEntityOptCharactor(const int32_t map_id, const int32_t map_entity_id)
+    AFEntityOptCharactor(const int32_t map_id, const int32_t map_entity_id, std::shared_ptr<const bool> frozen)
         : map_id_(map_id)
         , map_entity_id_(map_entity_id)
     {
-        m_pContainerManager = std::make_shared<AFCContainerManager>();
+        m_pContainerManager = std::allocate_shared<AFCContainerManager>(AFTagAllocator<AFCContainerManager>(), frozen);
     }
 
     // map id
@@ -79,13 +79,23 @@ private:
     // is sent to client(for container use)
     bool sent_{false};
 
+    // node and table change count
+    uint32_t data_version_{0};
+
+    // refuse writes, shared with tables and containers of this entity
+    std::shared_ptr<bool> frozen_{std::make_shared<bool>(false)};
+
     // optional data only for player and npc
     std::shared_ptr<AFEntityOptCharactor> opt_charactor_{nullptr};
 
-    // custom data
+    // custom data by name, for names not registered as slot
     using CustomDataList = AFHashmap<std::string, AFIData>;
     CustomDataList custom_data_list_;
 
+    // custom data, indexed by slot of AFCustomSlotManager
+    using CustomSlotList = std::vector<AFCData>;
+    CustomSlotList custom_slot_list_;
+
     // class meta
     std::shared_ptr<AFClassMeta> class_meta_{nullptr};
 
@@ -95,9 +105,6 @@ private:
     // table data
     std::shared_ptr<AFTableManager> m_pTableManager{nullptr};
 
-    // event manager
-    std::shared_ptr<AFIEventManager> m_pEventManager{nullptr};
-
     // call back manager
     std::shared_ptr<AFClassCallBackManager> m_pCallBackManager{nullptr};
 
@@ -109,6 +116,9 @@ public:
 
     void Update() override;
 
+    void SetFrozen(const bool value) override;
+    bool IsFrozen() const override;
+
     // get unique id
     const AFGUID& GetID() const override;
 
@@ -240,9 +250,32 @@ public:
     bool FindCustomData(const std::string& name) const override;
     bool RemoveCustomData(const std::string& name) override;
 
+    bool SetCustomBool(const uint32_t slot, bool value) override;
+    bool SetCustomInt32(const uint32_t slot, const int32_t value) override;
+    bool SetCustomUInt32(const uint32_t slot, const uint32_t value) override;
+    bool SetCustomInt64(const uint32_t slot, const int64_t value) override;
+    bool SetCustomFloat(const uint32_t slot, const float value) override;
+    bool SetCustomDouble(const uint32_t slot, const double value) override;
+    bool SetCustomString(const uint32_t slot, const std::string& value) override;
+
+    bool GetCustomBool(const uint32_t slot) const override;
+    int32_t GetCustomInt32(const uint32_t slot) const override;
+    uint32_t GetCustomUInt32(const uint32_t slot) const override;
+    int64_t GetCustomInt64(const uint32_t slot) const override;
+    float GetCustomFloat(const uint32_t slot) const override;
+    double GetCustomDouble(const uint32_t slot) const override;
+    const char* GetCustomString(const uint32_t slot) const override;
+
+    bool FindCustomData(const uint32_t slot) const override;
+    bool RemoveCustomData(const uint32_t slot) override;
+
     bool IsSent() const override;
     void UpdateSent() override;
 
+    uint32_t GetDataVersion() const override;
+
+    size_t GetMemUsage() const override;
+
 private:
     std::shared_ptr<AFNodeManager> GetNodeManager() const;
 
@@ -250,10 +283,17 @@ private:
 
     std::shared_ptr<AFIContainerManager> GetContainerManager() const;
 
-    std::shared_ptr<AFIEventManager> GetEventManager() const;
-
     std::shared_ptr<AFClassMeta> GetClassMeta() const;
 
+    // nullptr if slot is not set
+    const AFIData* FindCustomSlot(const uint32_t slot) const;
+
+    // slot registered for name with the same type, otherwise INVALID_SLOT and the name keyed list is used
+    uint32_t GetCustomSlot(const std::string& name, const ArkDataType type) const;
+
+    // storage of slot, nullptr if type is not the registered one
+    AFIData* PrepareCustomSlot(const uint32_t slot, const ArkDataType type);
+
     int OnDataCallBack(AFINode* pNode, const AFIData& old_data, const AFIData& new_data);
 
     int OnTableCallBack(const ArkMaskType mask, AFINode* pNode, const TABLE_EVENT_DATA& event_data,
@@ -21,91 +21,288 @@
 #pragma once
 
 #include "base/AFDefine.hpp"
-#include "base/AFList.hpp"
-#include "base/AFMap.hpp"
 #include "kernel/interface/AFIEventManager.hpp"
 #include "kernel/include/AFCDataList.hpp"
 
 namespace ark {
 
+// Callbacks of an entity are kept in one flat vector, allocated on the first registration.
+// Callbacks added while dispatching are pending until the outermost dispatch returns,
+// removed ones are skipped at once and erased in Update.
 class AFCEventManager final : public AFIEventManager
 {
 public:
-    AFCEventManager() = delete;
+    using AFIEventManager::AddEventCallBack;
+    using AFIEventManager::DoEvent;
+    using AFIEventManager::PostEvent;
 
-    explicit AFCEventManager(AFGUID self)
-        : self_(self)
-    {
-    }
+    AFCEventManager() = default;
 
     void Update() override
     {
-        for (auto iter : need_remove_events_)
+        // events posted during delivery are delivered in next frame
+        deliver_list_.swap(event_queue_);
+
+        // pointer instead of iterator, callbacks added while delivering may rehash the map
+        CallBackList* pCallBacks = nullptr;
+        AFGUID last_id = NULL_GUID;
+        for (auto& event : deliver_list_)
+        {
+            // events of the same entity are usually posted together
+            if (pCallBacks == nullptr || last_id != event.self_)
+            {
+                last_id = event.self_;
+                auto iter = subscriptions_.find(last_id);
+                pCallBacks = (iter == subscriptions_.end()) ? nullptr : &iter->second;
+            }
+
+            if (pCallBacks == nullptr)
+            {
+                continue;
+            }
+
+            if (event.args_ != nullptr)
+            {
+                Dispatch(*pCallBacks, event.self_, event.event_id_, event.args_.get(), nullptr);
+            }
+            else
+            {
+                Dispatch(*pCallBacks, event.self_, event.event_id_, nullptr, event.event_.get());
+            }
+        }
+
+        deliver_list_.clear();
+
+        for (auto& id : need_compact_list_)
         {
-            event_callbacks_.erase(iter);
+            auto iter_sub = subscriptions_.find(id);
+            if (iter_sub == subscriptions_.end())
+            {
+                continue;
+            }
+
+            auto& callbacks = iter_sub->second;
+            callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+                                [](const EventCallBack& cb) { return cb.removed_; }),
+                callbacks.end());
+
+            if (callbacks.empty())
+            {
+                subscriptions_.erase(iter_sub);
+            }
         }
 
-        need_remove_events_.clear();
+        need_compact_list_.clear();
+    }
+
+    bool AddEventCallBack(const AFGUID& self, const int event_id, EVENT_PROCESS_FUNCTOR&& cb) override
+    {
+        EventCallBack event_cb;
+        event_cb.event_id_ = event_id;
+        event_cb.func_ = std::forward<EVENT_PROCESS_FUNCTOR>(cb);
+
+        return AddCallBack(self, std::move(event_cb));
     }
 
-    bool AddEventCallBack(const int event_id, EVENT_PROCESS_FUNCTOR&& cb) override
+    bool RemoveEventCallBack(const AFGUID& self, const int event_id) override
     {
-        auto pEventInfo = event_callbacks_.find_value(event_id);
-        if (pEventInfo == nullptr)
+        auto iter = subscriptions_.find(self);
+        if (iter == subscriptions_.end())
         {
-            auto event_info = std::make_shared<AFList<EVENT_PROCESS_FUNCTOR>>();
-            event_info->emplace_back(cb);
-            return event_callbacks_.insert(event_id, event_info).second;
+            return false;
         }
-        else
+
+        for (auto& cb : iter->second)
         {
-            pEventInfo->emplace_back(cb);
-            return true;
+            if (cb.event_id_ == event_id)
+            {
+                cb.removed_ = true;
+            }
         }
-    }
 
-    bool RemoveEventCallBack(const int event_id) override
-    {
-        need_remove_events_.emplace_back(event_id);
+        for (auto& pending : pending_list_)
+        {
+            if (pending.first == self && pending.second.event_id_ == event_id)
+            {
+                pending.second.removed_ = true;
+            }
+        }
+
+        need_compact_list_.insert(self);
         return true;
     }
 
-    bool DoEvent(const int event_id, const AFIDataList& args) override
+    bool Clear(const AFGUID& self) override
     {
-        auto event_info = event_callbacks_.find_value(event_id);
-        if (event_info == nullptr)
+        for (auto& pending : pending_list_)
+        {
+            if (pending.first == self)
+            {
+                pending.second.removed_ = true;
+            }
+        }
+
+        auto iter = subscriptions_.find(self);
+        if (iter == subscriptions_.end())
         {
             return false;
         }
 
-        for (auto iter : *event_info)
+        for (auto& cb : iter->second)
         {
-            iter(self_, event_id, args);
+            cb.removed_ = true;
         }
 
+        need_compact_list_.insert(self);
         return true;
     }
 
-    bool Clear() override
+    bool DoEvent(const AFGUID& self, const int event_id, const AFIDataList& args) override
     {
-        need_remove_events_.clear();
-        event_callbacks_.clear();
+        auto iter = subscriptions_.find(self);
+        if (iter == subscriptions_.end())
+        {
+            return false;
+        }
+
+        return Dispatch(iter->second, self, event_id, &args, nullptr);
+    }
+
+    bool PostEvent(const AFGUID& self, const int event_id, const AFIDataList& args) override
+    {
+        QueuedEvent event;
+        event.self_ = self;
+        event.event_id_ = event_id;
+        event.args_ = std::make_shared<AFCDataList>(args);
+        event_queue_.emplace_back(std::move(event));
 
         return true;
     }
 
 protected:
-    bool HasEventCallBack(const int event_id) override
+    bool AddTypedEventCallBack(const AFGUID& self, const int event_id, TYPED_EVENT_FUNCTOR&& cb) override
     {
-        auto event_info = event_callbacks_.find_value(event_id);
-        return (event_info != nullptr);
+        EventCallBack event_cb;
+        event_cb.event_id_ = event_id;
+        event_cb.typed_func_ = std::forward<TYPED_EVENT_FUNCTOR>(cb);
+
+        return AddCallBack(self, std::move(event_cb));
+    }
+
+    bool DoTypedEvent(const AFGUID& self, const int event_id, const void* pEvent) override
+    {
+        auto iter = subscriptions_.find(self);
+        if (iter == subscriptions_.end())
+        {
+            return false;
+        }
+
+        return Dispatch(iter->second, self, event_id, nullptr, pEvent);
+    }
+
+    bool PostTypedEvent(const AFGUID& self, const int event_id, std::shared_ptr<void> pEvent) override
+    {
+        ARK_ASSERT_RET_VAL(pEvent != nullptr, false);
+
+        QueuedEvent event;
+        event.self_ = self;
+        event.event_id_ = event_id;
+        event.event_ = std::move(pEvent);
+        event_queue_.emplace_back(std::move(event));
+
+        return true;
     }
 
 private:
-    AFGUID self_;
+    struct EventCallBack
+    {
+        int event_id_{0};
+        bool removed_{false};
+
+        // only one of them is set
+        EVENT_PROCESS_FUNCTOR func_{nullptr};
+        TYPED_EVENT_FUNCTOR typed_func_{nullptr};
+    };
+
+    struct QueuedEvent
+    {
+        AFGUID self_{NULL_GUID};
+        int event_id_{0};
+
+        // only one of them is set
+        std::shared_ptr<AFCDataList> args_{nullptr};
+        std::shared_ptr<void> event_{nullptr};
+    };
+
+    using CallBackList = std::vector<EventCallBack>;
+    using SubscriptionList = std::unordered_map<AFGUID, CallBackList>;
+
+    bool AddCallBack(const AFGUID& self, EventCallBack&& event_cb)
+    {
+        if (dispatch_depth_ > 0)
+        {
+            pending_list_.emplace_back(self, std::move(event_cb));
+        }
+        else
+        {
+            subscriptions_[self].emplace_back(std::move(event_cb));
+        }
+
+        return true;
+    }
+
+    bool Dispatch(CallBackList& callbacks, const AFGUID& self, const int event_id, const AFIDataList* pArgs,
+        const void* pEvent)
+    {
+        bool ret = false;
+
+        // no callback is added to the list while dispatching, index and reference stay valid
+        ++dispatch_depth_;
+        for (size_t i = 0; i < callbacks.size(); ++i)
+        {
+            auto& cb = callbacks[i];
+            if (cb.event_id_ != event_id || cb.removed_)
+            {
+                continue;
+            }
+
+            if (pArgs != nullptr && cb.func_ != nullptr)
+            {
+                cb.func_(self, event_id, *pArgs);
+                ret = true;
+            }
+            else if (pEvent != nullptr && cb.typed_func_ != nullptr)
+            {
+                cb.typed_func_(self, event_id, pEvent);
+                ret = true;
+            }
+        }
+        --dispatch_depth_;
+
+        if (dispatch_depth_ == 0 && !pending_list_.empty())
+        {
+            for (auto& pending : pending_list_)
+            {
+                if (!pending.second.removed_)
+                {
+                    subscriptions_[pending.first].emplace_back(std::move(pending.second));
+                }
+            }
+
+            pending_list_.clear();
+        }
+
+        return ret;
+    }
+
+    SubscriptionList subscriptions_;
+    std::vector<std::pair<AFGUID, EventCallBack>> pending_list_;
+    std::set<AFGUID> need_compact_list_;
+
+    std::vector<QueuedEvent> event_queue_;
+    std::vector<QueuedEvent> deliver_list_;
 
-    AFList<int> need_remove_events_;
-    AFSmartPtrMap<int, AFList<EVENT_PROCESS_FUNCTOR>> event_callbacks_;
+    int dispatch_depth_{0};
 };
 
 } // namespace ark
@@ -31,6 +31,7 @@
 #include "kernel/interface/AFIClassMetaModule.hpp"
 #include "kernel/interface/AFIConfigModule.hpp"
 #include "kernel/interface/AFIEntity.hpp"
+#include "AFCEntity.hpp"
 #include "AFNodeManager.hpp"
 #include "AFTableManager.hpp"
 #include "kernel/interface/AFIContainerManager.hpp"
@@ -46,11 +47,13 @@ public:
     ~AFCKernelModule() override;
 
     bool Init() override;
+    bool PreUpdate() override;
     bool Update() override;
     bool PreShut() override;
 
     ///////////////////////////////////////////////////////////////////////
     std::shared_ptr<AFIStaticEntity> GetStaticEntity(const ID_TYPE config_id) override;
+    uint32_t RegisterCustomData(const std::string& name, const ArkDataType type) override;
     std::shared_ptr<AFIEntity> GetEntity(const AFGUID& self) override;
     std::shared_ptr<AFIEntity> CreateEntity(const AFGUID& self, const int nSceneID, const int nGroupID,
         const std::string& strClassName, const ID_TYPE config_id, const AFIDataList& arg) override;
@@ -65,11 +68,21 @@ public:
     bool LogInfo(const AFGUID& id) override;
     bool LogSelfInfo(const AFGUID& id);
     int LogObjectData(const AFGUID& guid) override;
+
+    bool GetMemoryReport(AFMemoryReport& report, const size_t top_count) override;
+    bool DumpMemoryReport(const std::string& file_path, const size_t top_count) override;
+
+    void SetCallBackProfile(const bool enable, const int64_t dump_interval) override;
+    bool GetCallBackProfile(std::vector<AFCallBackStat>& stat_list) override;
+    void DumpCallBackProfile() override;
     //////////////////////////////////////////////////////////////////////////
 
     bool DoEvent(const AFGUID& self, const std::string& class_name, ArkEntityEvent class_event,
         const AFIDataList& args) override;
     bool DoEvent(const AFGUID& self, const int event_id, const AFIDataList& args) override;
+    bool PostEvent(const AFGUID& self, const int event_id, const AFIDataList& args) override;
+
+    std::shared_ptr<AFIEventManager> GetEventManager() override;
 
     bool Exist(const AFGUID& self) override;
 
@@ -95,27 +108,32 @@ protected:
     bool InnerDestroyEntity(std::shared_ptr<AFIEntity> pEntity);
 
     bool AddEventCallBack(const AFGUID& self, const int event_id, EVENT_PROCESS_FUNCTOR&& cb) override;
-    bool AddClassCallBack(const std::string& class_name, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio) override;
+    bool AddClassCallBack(const std::string& class_name, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio,
+        const std::string& owner) override;
     bool AddNodeCallBack(const std::string& class_name, const std::string& name, DATA_NODE_EVENT_FUNCTOR&& cb,
-        const int32_t prio) override;
+        const int32_t prio, const std::string& owner) override;
     bool AddTableCallBack(const std::string& class_name, const std::string& name, DATA_TABLE_EVENT_FUNCTOR&& cb,
-        const int32_t prio) override;
+        const int32_t prio, const std::string& owner) override;
 
-    bool AddNodeCallBack(
-        const std::string& class_name, const uint32_t index, DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio) override;
+    bool AddNodeCallBack(const std::string& class_name, const uint32_t index, DATA_NODE_EVENT_FUNCTOR&& cb,
+        const int32_t prio, const std::string& owner) override;
     bool AddTableCallBack(const std::string& class_name, const uint32_t index, DATA_TABLE_EVENT_FUNCTOR&& cb,
-        const int32_t prio) override;
+        const int32_t prio, const std::string& owner) override;
 
-    bool AddContainerCallBack(
-        const std::string& class_name, const uint32_t index, CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio) override;
-    bool AddCommonContainerCallBack(CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio) override;
+    bool AddContainerCallBack(const std::string& class_name, const uint32_t index, CONTAINER_EVENT_FUNCTOR&& cb,
+        const int32_t prio, const std::string& owner) override;
+    bool AddCommonContainerCallBack(
+        CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) override;
 
-    bool AddCommonClassEvent(CLASS_EVENT_FUNCTOR&& cb, const int32_t prio) override;
+    bool AddCommonClassEvent(CLASS_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) override;
 
-    bool AddLeaveSceneEvent(const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio) override;
-    bool AddEnterSceneEvent(const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio) override;
+    bool AddLeaveSceneEvent(const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio,
+        const std::string& owner) override;
+    bool AddEnterSceneEvent(const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio,
+        const std::string& owner) override;
 
-    bool AddMoveEvent(const std::string& class_name, MOVE_EVENT_FUNCTOR&& cb, const int32_t prio) override;
+    bool AddMoveEvent(
+        const std::string& class_name, MOVE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) override;
 
     // data sync call back
     void AddSyncCallBack();
@@ -177,19 +195,25 @@ protected:
 
     bool CopyData(std::shared_ptr<AFIEntity> pEntity, std::shared_ptr<AFIStaticEntity> pStaticEntity);
 
+    // new entity object, its nodes, tables and containers are counted with the alloc tag of its class
+    std::shared_ptr<AFCEntity> NewEntity(std::shared_ptr<AFClassMeta> pClassMeta, const AFGUID& guid,
+        const ID_TYPE config_id, const int32_t map_id, const int32_t map_entity_id, const AFIDataList& data_list);
+
     // get entity data
-    std::shared_ptr<AFNodeManager> GetNodeManager(std::shared_ptr<AFIStaticEntity> pStaticEntity) const;
     std::shared_ptr<AFNodeManager> GetNodeManager(std::shared_ptr<AFIEntity> pEntity) const;
     std::shared_ptr<AFNodeManager> GetNodeManager(AFIRow* pRow) const;
     std::shared_ptr<AFTableManager> GetTableManager(std::shared_ptr<AFIEntity> pEntity) const;
     std::shared_ptr<AFIContainerManager> GetContainerManager(std::shared_ptr<AFIEntity> pEntity) const;
-    std::shared_ptr<AFIEventManager> GetEventManager(std::shared_ptr<AFIEntity> pEntity) const;
 
 private:
     std::list<AFGUID> delete_list_;
 
     AFGUID cur_exec_object_{NULL_GUID};
 
+    // call back profile dump interval in ms, 0 means never
+    int64_t profile_dump_interval_{0};
+    int64_t last_profile_dump_time_{0};
+
     using SYNC_FUNCTOR = std::function<bool(const AFGUID&, const google::protobuf::Message&)>;
     std::map<ArkDataMask, SYNC_FUNCTOR> sync_functors;
 
@@ -199,6 +223,9 @@ private:
     AFIConfigModule* m_pConfigModule{nullptr};
     AFIClassMetaModule* m_pClassModule{nullptr};
 
+    // entity events, nullptr until the first use
+    std::shared_ptr<AFIEventManager> m_pEventManager{nullptr};
+
     AFArrayMap<std::string, int32_t> inner_nodes_;
     AFSmartPtrMap<AFGUID, AFIEntity> objects_;
 };
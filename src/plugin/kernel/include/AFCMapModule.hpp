@@ -33,6 +33,7 @@ class AFCMapModule final : public AFIMapModule
     ARK_DECLARE_MODULE_FUNCTIONS
 public:
     bool Init() override;
+    bool Update() override;
     bool Shut() override;
 
     std::shared_ptr<AFMapInfo> GetMapInfo(const int map_id) override;
@@ -56,6 +57,8 @@ public:
     bool ReleaseMapInstance(const int map_id, const int inst_id) override;
     bool ExitMapInstance(const int map_id, const int inst_id) override;
 
+    void PostMainMessage(SCHEDULER_FUNCTOR&& func) override;
+
     bool GetInstEntityList(const int map_id, const int inst_id, AFIDataList& list) override;
     int GetEntityByDataNode(
         const int map_id, const std::string& name, const AFIDataList& value_args, AFIDataList& list) override;
@@ -65,6 +68,9 @@ private:
     AFILogModule* m_pLogModule;
 
     AFSmartPtrMap<int, AFMapInfo> map_infos_;
+
+    std::mutex main_message_mutex_;
+    std::vector<SCHEDULER_FUNCTOR> main_messages_;
 };
 
 } // namespace ark
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include "base/AFStringPool.hpp"
 #include "plugin/kernel/interface/AFINode.hpp"
 
 namespace ark {
@@ -134,6 +135,11 @@ public:
         return static_cast<ID_TYPE>(data_);
     }
 
+    size_t GetMemUsage() const override
+    {
+        return sizeof(*this);
+    }
+
     DATA_NODE_DECLARE
 
     // data value
@@ -208,6 +214,11 @@ public:
         return static_cast<ID_TYPE>(data_);
     }
 
+    size_t GetMemUsage() const override
+    {
+        return sizeof(*this);
+    }
+
     DATA_NODE_DECLARE
 
     // data value
@@ -221,6 +232,12 @@ public:
     explicit AFNodeString(std::shared_ptr<AFNodeMeta> pDataMeta)
     {
         data_meta_ = pDataMeta;
+
+        // enum-like string, share values in string pool
+        if (data_meta_ != nullptr && data_meta_->HaveMask(ArkDataMask::PF_INTERN))
+        {
+            intern_data_ = &NULL_STR;
+        }
     }
 
     ~AFNodeString() override = default;
@@ -233,12 +250,19 @@ public:
 
     void Reset() override
     {
-        data_ = NULL_STR;
+        if (intern_data_ != nullptr)
+        {
+            intern_data_ = &NULL_STR;
+        }
+        else
+        {
+            data_ = NULL_STR;
+        }
     }
 
     bool IsNull() const override
     {
-        return data_.empty();
+        return GetString().empty();
     }
 
     void CopyFrom(AFINode* other) override
@@ -246,6 +270,13 @@ public:
         ARK_ASSERT_RET_NONE(data_meta_ != nullptr && other != nullptr);
         ARK_ASSERT_RET_NONE(data_meta_->GetType() == other->GetType());
 
+        // both interned, share the pooled value directly
+        if (intern_data_ != nullptr && other->HaveMask(ArkDataMask::PF_INTERN))
+        {
+            intern_data_ = &other->GetString();
+            return;
+        }
+
         SetString(other->GetString());
     }
 
@@ -259,33 +290,52 @@ public:
 
     const std::string& GetString() const override
     {
-        return data_;
+        return (intern_data_ != nullptr) ? *intern_data_ : data_;
     }
 
     void SetString(const std::string& value) override
     {
-        data_ = value;
+        if (intern_data_ != nullptr)
+        {
+            intern_data_ = &AFStringPool::get_instance().Intern(value);
+        }
+        else
+        {
+            data_ = value;
+        }
     }
 
     std::string ToString() const override
     {
-        return data_;
+        return GetString();
     }
 
     void FromString(const std::string& value) override
     {
-        data_ = value;
+        SetString(value);
     }
 
     ID_TYPE GetValue() const override
     {
-        return AFMisc::FromString<ID_TYPE>(data_);
+        return AFMisc::FromString<ID_TYPE>(GetString());
+    }
+
+    size_t GetMemUsage() const override
+    {
+        // interned value is shared, heap buffer only when out of small string storage
+        const char* p = data_.data();
+        const char* self = reinterpret_cast<const char*>(&data_);
+        bool inline_data = (p >= self && p < self + sizeof(data_));
+        return sizeof(*this) + (inline_data ? 0 : data_.capacity() + 1);
     }
 
     DATA_NODE_DECLARE
 
     // data value
     std::string data_{NULL_STR};
+
+    // pooled value of interned node
+    const std::string* intern_data_{nullptr};
 };
 
 // data bool
@@ -356,6 +406,11 @@ public:
         return static_cast<ID_TYPE>(data_);
     }
 
+    size_t GetMemUsage() const override
+    {
+        return sizeof(*this);
+    }
+
     DATA_NODE_DECLARE
 
     // data value
@@ -430,6 +485,11 @@ public:
         return static_cast<ID_TYPE>(data_);
     }
 
+    size_t GetMemUsage() const override
+    {
+        return sizeof(*this);
+    }
+
     DATA_NODE_DECLARE
 
     // data value
@@ -504,6 +564,11 @@ public:
         return static_cast<ID_TYPE>(data_);
     }
 
+    size_t GetMemUsage() const override
+    {
+        return sizeof(*this);
+    }
+
     DATA_NODE_DECLARE
 
     // data value
@@ -578,6 +643,11 @@ public:
         return static_cast<ID_TYPE>(data_);
     }
 
+    size_t GetMemUsage() const override
+    {
+        return sizeof(*this);
+    }
+
     DATA_NODE_DECLARE
 
     // data value
@@ -652,6 +722,11 @@ public:
         return static_cast<ID_TYPE>(data_);
     }
 
+    size_t GetMemUsage() const override
+    {
+        return sizeof(*this);
+    }
+
     DATA_NODE_DECLARE
 
     // data value
@@ -726,6 +801,11 @@ public:
         return static_cast<ID_TYPE>(data_);
     }
 
+    size_t GetMemUsage() const override
+    {
+        return sizeof(*this);
+    }
+
     DATA_NODE_DECLARE
 
     // data value
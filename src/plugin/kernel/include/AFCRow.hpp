@@ -30,7 +30,7 @@
 
 namespace ark {
 
-class AFCRow final : public AFIRow
+class AFCRow final : public AFIRow, public AFAllocTagged
 {
 private:
     friend class AFCKernelModule;
@@ -45,16 +45,21 @@ private:
     // data
     std::shared_ptr<AFNodeManager> m_pNodeManager{nullptr};
 
+    // frozen flag of the owner entity
+    std::shared_ptr<const bool> frozen_{nullptr};
+
 public:
     AFCRow() = delete;
 
     // constructor
-    explicit AFCRow(
-        std::shared_ptr<AFClassMeta> pClassMeta, uint32_t row, const AFIDataList& args, ROW_CALLBACK_FUNCTOR&& func);
+    explicit AFCRow(std::shared_ptr<AFClassMeta> pClassMeta, uint32_t row, const AFIDataList& args,
+        std::shared_ptr<const bool> frozen, ROW_CALLBACK_FUNCTOR&& func);
 
     // get row
     uint32_t GetRow() const override;
 
+    size_t GetMemUsage() const override;
+
     // get row data
     bool GetBool(const uint32_t index) const override;
     int32_t GetInt32(const uint32_t index) const override;
@@ -106,6 +111,8 @@ private:
 
     std::shared_ptr<AFNodeManager> GetNodeManager() const;
 
+    bool IsFrozen() const;
+
     int OnDataCallBack(AFINode* pNode, const AFIData& old_data, const AFIData& new_data);
 };
 
@@ -23,6 +23,7 @@
 #include "base/AFMap.hpp"
 #include "kernel/interface/AFIStaticEntity.hpp"
 #include "kernel/interface/AFITable.hpp"
+#include "AFStaticLayout.hpp"
 
 namespace ark {
 
@@ -33,21 +34,27 @@ public:
 
 private:
     friend class AFCKernelModule;
+    friend class AFConfigImage;
+    friend class AFCConfigModule;
 
     // config id
     ID_TYPE config_id_{0};
 
-    // class meta
-    std::shared_ptr<AFClassMeta> class_meta_{nullptr};
+    // class layout
+    std::shared_ptr<AFStaticLayout> layout_{nullptr};
 
-    // data
-    std::shared_ptr<AFNodeManager> m_pNodeManager{nullptr};
+    // data, numeric fields packed at layout offsets
+    std::vector<char> value_list_;
+    std::vector<std::string> string_list_;
 
 public:
     AFCStaticEntity() = delete;
 
+    // empty row with default values, filled in place by the config image
+    explicit AFCStaticEntity(std::shared_ptr<AFStaticLayout> pLayout, const ID_TYPE config_id);
+
     explicit AFCStaticEntity(
-        std::shared_ptr<AFClassMeta> pClassMeta, std::shared_ptr<AFNodeManager> pNodeManager, const ID_TYPE config_id);
+        std::shared_ptr<AFStaticLayout> pLayout, const AFNodeManager* pNodeManager, const ID_TYPE config_id);
 
     // query data
     const std::string& GetClassName() const override;
@@ -73,7 +80,37 @@ public:
     const std::wstring& GetWString(const uint32_t index) const override;
 
 private:
-    std::shared_ptr<AFNodeManager> GetNodeManager() const;
+    AFGUID GetGUID(const uint32_t index) const;
+
+    // create the nodes of an entity from this config
+    bool CopyTo(AFNodeManager* pNodeManager) const;
+
+    // whether a reloaded row carries the same data
+    bool IsSameData(const AFNodeManager* pNodeManager) const;
+
+    std::shared_ptr<AFStaticLayout> GetLayout() const;
+
+    template<typename T>
+    T GetValue(const uint32_t index, const ArkDataType type, const T default_value) const
+    {
+        auto pField = layout_->FindField(index);
+        ARK_ASSERT_RET_VAL(pField != nullptr, default_value);
+
+        if (pField->type_ != type)
+        {
+            return default_value;
+        }
+
+        T value;
+        memcpy(&value, value_list_.data() + pField->offset_, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    void SetValue(const AFStaticLayout::Field& field, const T value)
+    {
+        memcpy(value_list_.data() + field.offset_, &value, sizeof(T));
+    }
 };
 
 } // namespace ark
@@ -28,7 +28,7 @@
 
 namespace ark {
 
-class AFCTable final : public AFITable
+class AFCTable final : public AFITable, public AFAllocTagged
 {
 public:
     using TableData = AFMap<uint32_t, AFIRow>;
@@ -53,11 +53,18 @@ private:
     // call back
     TABLE_CALLBACK_FUNCTOR func_;
 
+    // frozen flag of the owner entity
+    std::shared_ptr<const bool> frozen_{nullptr};
+
+    // rows added later are counted with the tag the table was created with
+    uint32_t alloc_tag_{AFAllocCounter::CurrentTag()};
+
 public:
     AFCTable() = delete;
 
     // constructor
-    explicit AFCTable(std::shared_ptr<AFTableMeta> pTableMeta, TABLE_CALLBACK_FUNCTOR&& func);
+    explicit AFCTable(
+        std::shared_ptr<AFTableMeta> pTableMeta, std::shared_ptr<const bool> frozen, TABLE_CALLBACK_FUNCTOR&& func);
 
     const std::string& GetName() const override;
 
@@ -84,6 +91,8 @@ public:
 
     void Clear() override;
 
+    size_t GetMemUsage() const override;
+
     // find
     uint32_t FindInt32(const uint32_t index, const int32_t value) const override;
     uint32_t FindInt64(const uint32_t index, const int64_t value) const override;
@@ -103,6 +112,8 @@ public:
 private:
     uint32_t SelectRow() const;
 
+    bool IsFrozen() const;
+
     void ReleaseRow(AFIRow* row_data);
 
     void OnTableChanged(uint32_t row, ArkTableOpType op_type);
@@ -0,0 +1,96 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPlatform.hpp"
+
+namespace ark {
+
+// call count and cost of one registered kernel call back
+class AFCallBackStat final
+{
+public:
+    AFCallBackStat(const std::string& class_name, const std::string& type, const uint32_t index,
+        const std::string& owner)
+        : class_name_(class_name)
+        , type_(type)
+        , index_(index)
+        , owner_(owner)
+    {
+    }
+
+    void Reset()
+    {
+        count_ = 0;
+        total_ns_ = 0;
+        max_ns_ = 0;
+    }
+
+    std::string class_name_;
+    // class, node, table, container, leave_scene, enter_scene, move
+    std::string type_;
+    // node/table/container index, 0 for the others
+    uint32_t index_{0};
+    // module which registered the call back
+    std::string owner_;
+
+    uint64_t count_{0};
+    uint64_t total_ns_{0};
+    uint64_t max_ns_{0};
+};
+
+// time one call back invoking, does nothing but a branch when profiling is disabled
+class AFCallBackTimer final
+{
+public:
+    AFCallBackTimer(AFCallBackStat* pStat, const bool enable)
+    {
+        if (enable && pStat != nullptr)
+        {
+            stat_ = pStat;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~AFCallBackTimer()
+    {
+        if (stat_ == nullptr)
+        {
+            return;
+        }
+
+        auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+        auto cost_ns = static_cast<uint64_t>(cost.count());
+
+        ++stat_->count_;
+        stat_->total_ns_ += cost_ns;
+        if (cost_ns > stat_->max_ns_)
+        {
+            stat_->max_ns_ = cost_ns;
+        }
+    }
+
+private:
+    AFCallBackStat* stat_{nullptr};
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace ark
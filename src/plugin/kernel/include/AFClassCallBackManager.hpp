@@ -25,6 +25,7 @@
 #include "base/AFList.hpp"
 #include "base/AFDefine.hpp"
 #include "kernel/include/AFCData.hpp"
+#include "kernel/include/AFCallBackProfile.hpp"
 #include <set>
 #include "kernel/interface/AFIEntity.hpp"
 
@@ -66,9 +67,25 @@ struct AFDelaySyncData
     std::map<uint32_t, AFDelaySyncContainer> container_list_;
 };
 
+// registered call back with its profile stat
+template<typename FUNCTOR>
+struct AFCallBackNode
+{
+    AFCallBackNode(FUNCTOR&& func, AFCallBackStat* pStat)
+        : func_(std::forward<FUNCTOR>(func))
+        , stat_(pStat)
+    {
+    }
+
+    FUNCTOR func_;
+    AFCallBackStat* stat_{nullptr};
+};
+
 class AFClassCallBackManager final
 {
 public:
+    using StatList = std::list<AFCallBackStat>;
+
     // delay sync data
     using DelaySyncMaskData = std::map<ArkDataMask, AFDelaySyncData>;
     using DelaySyncDataList = std::map<AFGUID, DelaySyncMaskData>;
@@ -83,30 +100,36 @@ public:
     using DELAY_SYNC_FUNCTOR = std::function<int(const AFGUID&, const ArkDataMask, const AFDelaySyncData& data)>;
 
 private:
+    std::string class_name_;
+
     // class event list
-    std::multimap<int32_t, CLASS_EVENT_FUNCTOR> class_events_;
+    std::multimap<int32_t, AFCallBackNode<CLASS_EVENT_FUNCTOR>> class_events_;
 
     // data call backs list
-    using NodeCallBacks = std::multimap<int32_t, DATA_NODE_EVENT_FUNCTOR>;
+    using NodeCallBacks = std::multimap<int32_t, AFCallBackNode<DATA_NODE_EVENT_FUNCTOR>>;
     std::map<uint32_t, NodeCallBacks> data_call_backs_list_;
 
     // table call backs list
-    using TableCallBacks = std::multimap<int32_t, DATA_TABLE_EVENT_FUNCTOR>;
+    using TableCallBacks = std::multimap<int32_t, AFCallBackNode<DATA_TABLE_EVENT_FUNCTOR>>;
     std::map<uint32_t, TableCallBacks> table_call_backs_list_;
 
     // container call backs list
-    using ContainerCallBacks = std::multimap<int32_t, CONTAINER_EVENT_FUNCTOR>;
+    using ContainerCallBacks = std::multimap<int32_t, AFCallBackNode<CONTAINER_EVENT_FUNCTOR>>;
     std::map<uint32_t, ContainerCallBacks> container_call_backs_list_;
 
     // scene event
-    using SceneEvents = std::multimap<int32_t, SCENE_EVENT_FUNCTOR>;
+    using SceneEvents = std::multimap<int32_t, AFCallBackNode<SCENE_EVENT_FUNCTOR>>;
     SceneEvents leave_scene_events_;
     SceneEvents enter_scene_events_;
 
     // move event
-    using MoveEvents = std::multimap<int32_t, MOVE_EVENT_FUNCTOR>;
+    using MoveEvents = std::multimap<int32_t, AFCallBackNode<MOVE_EVENT_FUNCTOR>>;
     MoveEvents move_events_;
 
+    // profile stat of every call back above, list keeps the address stable
+    StatList stat_list_;
+    static bool profile_enable_;
+
     // sync call back
     using NodeSyncCallBacks = std::map<ArkDataMask, NODE_SYNC_FUNCTOR>;
     static NodeSyncCallBacks node_sync_call_back_list_;
@@ -125,14 +148,25 @@ private:
     static DelaySyncDataList delay_sync_data_list_;
 
 public:
-    // add call back
-    bool AddClassCallBack(CLASS_EVENT_FUNCTOR&& cb, const int32_t prio);
-    bool AddDataCallBack(const uint32_t index, DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio);
-    bool AddTableCallBack(const uint32_t index, DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio);
-    bool AddContainerCallBack(const uint32_t index, CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio);
-    bool AddLeaveSceneEvent(SCENE_EVENT_FUNCTOR&& cb, const int32_t prio);
-    bool AddEnterSceneEvent(SCENE_EVENT_FUNCTOR&& cb, const int32_t prio);
-    bool AddMoveEvent(MOVE_EVENT_FUNCTOR&& cb, const int32_t prio);
+    explicit AFClassCallBackManager(const std::string& class_name);
+
+    // add call back, owner is the name of registering module
+    bool AddClassCallBack(CLASS_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner);
+    bool AddDataCallBack(
+        const uint32_t index, DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner);
+    bool AddTableCallBack(
+        const uint32_t index, DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner);
+    bool AddContainerCallBack(
+        const uint32_t index, CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner);
+    bool AddLeaveSceneEvent(SCENE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner);
+    bool AddEnterSceneEvent(SCENE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner);
+    bool AddMoveEvent(MOVE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner);
+
+    // call back profile
+    static void SetProfileEnable(const bool value);
+    static bool IsProfileEnable();
+    const StatList& GetStatList() const;
+    void ResetStat();
 
     // data call back
     bool OnClassEvent(const AFGUID& id, const std::string& class_name, const ArkEntityEvent eClassEvent,
@@ -161,6 +195,8 @@ public:
     static bool OnDelaySync();
 
 private:
+    AFCallBackStat* CreateStat(const std::string& type, const uint32_t index, const std::string& owner);
+
     DelaySyncMaskData& GetDelaySyncMaskData(const AFGUID& self);
     AFDelaySyncTable& GetDelaySyncMaskTable(
         DelaySyncMaskData& mask_data_map, const ArkDataMask mask_value, uint32_t index);
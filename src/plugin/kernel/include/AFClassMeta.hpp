@@ -24,6 +24,7 @@
 #include "base/AFMap.hpp"
 #include "base/AFDefine.hpp"
 #include "base/AFEnum.hpp"
+#include "base/AFCoreDef.hpp"
 #include "AFNodeMeta.hpp"
 #include "AFTableMeta.hpp"
 #include "AFClassCallBackManager.hpp"
@@ -48,6 +49,9 @@ private:
     // res path
     std::string res_path_{NULL_STR};
 
+    // alloc tag, objects of entities of this class are counted with it
+    uint32_t alloc_tag_{AFAllocCounter::NULL_TAG};
+
     // name index
     NameIndexList name_index_list_;
 
@@ -75,6 +79,8 @@ public:
     void SetResPath(const std::string& value);
     const std::string& GetResPath() const;
 
+    uint32_t GetAllocTag() const;
+
     // create data meta
     std::shared_ptr<AFNodeMeta> CreateDataMeta(const std::string& name, const uint32_t index);
     std::shared_ptr<AFNodeMeta> FindDataMeta(const uint32_t index) const;
@@ -0,0 +1,120 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPlatform.hpp"
+#include "base/AFMacros.hpp"
+#include "AFClassMeta.hpp"
+#include "AFClassMetaManager.hpp"
+#include "AFStaticEntityManager.hpp"
+
+namespace ark {
+
+// Precompiled binary image of all config classes.
+//
+// layout: [image head][class block]...
+// class block: [class head][name][row]...
+// row: [config_id][field value]... (fields in class meta index order)
+//
+// Every class block records the size and crc64 of its xml source and a signature of its meta,
+// a block is stale and ignored as soon as one of them changes.
+// A missing, truncated or corrupt image is not an error, the classes are loaded from xml instead.
+class AFConfigImage final
+{
+public:
+    static const uint32_t IMAGE_MAGIC = 0x434B5241; // ARKC
+    static const uint32_t IMAGE_VERSION = 2;
+
+#pragma pack(push, 1)
+    struct ImageHead
+    {
+        uint32_t magic_{0};
+        uint32_t version_{0};
+        uint32_t class_count_{0};
+    };
+
+    struct ClassHead
+    {
+        uint32_t name_size_{0};
+        uint64_t source_size_{0};
+        uint64_t source_hash_{0};
+        uint64_t meta_sign_{0};
+        uint32_t row_count_{0};
+        uint64_t data_size_{0};
+    };
+#pragma pack(pop)
+
+    // source file info used to detect stale image
+    struct SourceInfo
+    {
+        uint64_t size_{0};
+        uint64_t hash_{0}; // crc64 of the content, modify time has a one second resolution
+    };
+
+    // class name -> source info
+    using SourceInfoList = std::unordered_map<std::string, SourceInfo>;
+
+    AFConfigImage() = default;
+    ~AFConfigImage();
+
+    // map an image file, return false if not exist or broken
+    bool Open(const std::string& file_path);
+    void Close();
+
+    bool IsOpen() const;
+
+    // create static entities of a class from image, return false if the class is missing or stale
+    // source info is the one of the current xml source, taken by caller so the file is hashed only once
+    bool LoadClass(std::shared_ptr<AFClassMeta> pClassMeta, const SourceInfo& source_info,
+        AFStaticEntityManager* pStaticEntityManager) const;
+
+    // compile all static entities into a new image, a class without source info is left out
+    static bool Save(const std::string& file_path, const AFClassMetaManager::ClassMetaList& class_meta_list,
+        const SourceInfoList& source_info_list, AFStaticEntityManager* pStaticEntityManager);
+
+    static bool GetSourceInfo(const std::string& file_path, SourceInfo& info);
+    static uint64_t GetMetaSign(std::shared_ptr<AFClassMeta> pClassMeta);
+
+private:
+    struct ClassBlock
+    {
+        const ClassHead* head_{nullptr};
+        const char* data_{nullptr};
+    };
+
+    static bool WriteRow(
+        std::string& out, std::shared_ptr<AFClassMeta> pClassMeta, const AFCStaticEntity* pStaticEntity);
+
+    // read a row straight into the value buffer of a static entity
+    static bool ReadRow(const char*& pos, const char* end, AFCStaticEntity* pStaticEntity);
+
+    const char* data_{nullptr};
+    size_t size_{0};
+
+#ifdef ARK_PLATFORM_WIN
+    // no mmap on windows, read the whole image instead
+    std::vector<char> buffer_;
+#endif
+
+    std::unordered_map<std::string, ClassBlock> class_blocks_;
+};
+
+} // namespace ark
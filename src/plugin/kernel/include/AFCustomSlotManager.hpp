@@ -0,0 +1,118 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPlatform.hpp"
+#include "base/AFMacros.hpp"
+#include "base/AFEnum.hpp"
+
+namespace ark {
+
+// Custom data slots shared by all entities.
+// A slot is registered once by name and type, then entities keep its value in a flat array indexed by slot.
+// Slot names are process wide and never freed, so only fixed names registered by modules become slots,
+// names used only through the string api are kept by each entity in its own name keyed list.
+// Registering a name again with another type fails, modules sharing a name must agree on its type.
+// The name map is sealed by kernel before the first frame, after that it is read only and Find takes no lock,
+// so slots must be registered in module Init or PostInit.
+class AFCustomSlotManager final
+{
+public:
+    static const uint32_t INVALID_SLOT = UINT32_MAX;
+
+    // slot types are never reallocated, entity threads read them without lock
+    static const uint32_t MAX_SLOT_COUNT = 1024;
+
+    // one instance in kernel plugin
+    static AFCustomSlotManager& Instance();
+
+    AFCustomSlotManager()
+    {
+        slot_types_.resize(MAX_SLOT_COUNT, ArkDataType::DT_EMPTY);
+    }
+
+    // return the slot of name, the same slot if registered again with the same type
+    uint32_t Register(const std::string& name, const ArkDataType type)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        ARK_ASSERT_RET_VAL(!sealed_.load(std::memory_order_relaxed), INVALID_SLOT);
+
+        auto iter = slot_names_.find(name);
+        if (iter != slot_names_.end())
+        {
+            return (slot_types_[iter->second] == type) ? iter->second : INVALID_SLOT;
+        }
+
+        uint32_t slot = slot_count_.load(std::memory_order_relaxed);
+        if (slot >= MAX_SLOT_COUNT)
+        {
+            return INVALID_SLOT;
+        }
+
+        slot_types_[slot] = type;
+        slot_names_.insert(std::make_pair(name, slot));
+        slot_count_.store(slot + 1, std::memory_order_release);
+        return slot;
+    }
+
+    uint32_t Find(const std::string& name) const
+    {
+        if (sealed_.load(std::memory_order_acquire))
+        {
+            return FindSlot(name);
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        return FindSlot(name);
+    }
+
+    // no more register, the name map is read only from now on
+    void Seal()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        sealed_.store(true, std::memory_order_release);
+    }
+
+    ArkDataType GetType(const uint32_t slot) const
+    {
+        return (slot < GetCount()) ? slot_types_[slot] : ArkDataType::DT_EMPTY;
+    }
+
+    size_t GetCount() const
+    {
+        return slot_count_.load(std::memory_order_acquire);
+    }
+
+private:
+    uint32_t FindSlot(const std::string& name) const
+    {
+        auto iter = slot_names_.find(name);
+        return (iter != slot_names_.end()) ? iter->second : INVALID_SLOT;
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, uint32_t> slot_names_;
+    std::vector<ArkDataType> slot_types_;
+    std::atomic<uint32_t> slot_count_{0};
+    std::atomic<bool> sealed_{false};
+};
+
+} // namespace ark
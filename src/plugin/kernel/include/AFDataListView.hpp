@@ -0,0 +1,479 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "kernel/interface/AFIData.hpp"
+#include "kernel/interface/AFIDataList.hpp"
+#include "base/AFMisc.hpp"
+
+namespace ark {
+
+// Non-owning data list, strings and user data are borrowed instead of copied and nothing is allocated.
+// The referenced data must outlive the view, use it for arguments passed down a call chain,
+// e.g. DoEvent(self, class_name, event, AFDataListView() << name), and AFCDataList to keep data.
+template<size_t DATA_SIZE>
+class AFBaseDataListView final : public AFIDataList
+{
+private:
+    using self_t = AFBaseDataListView<DATA_SIZE>;
+
+    struct user_data_t
+    {
+        const void* mpData;
+        size_t mnSize;
+        void* mpRawData;
+    };
+
+    struct view_data_t
+    {
+        ArkDataType nType;
+        union
+        {
+            bool mbValue;
+            int mnValue;
+            uint32_t mnUValue;
+            int64_t mn64Value;
+            uint64_t mnU64Value;
+            float mfValue;
+            double mdValue;
+            const char* mstrValue;
+            void* mpVaule;
+            user_data_t mxUserData;
+        };
+    };
+
+public:
+    AFBaseDataListView()
+    {
+        assert(DATA_SIZE > 0);
+    }
+
+    // borrow [start, start + count) of another list
+    AFBaseDataListView(const AFIDataList& src, size_t start, size_t count)
+    {
+        assert(DATA_SIZE > 0);
+        Append(src, start, count);
+    }
+
+    AFBaseDataListView(const self_t& src) = default;
+    self_t& operator=(const self_t& src) = default;
+
+    virtual ~AFBaseDataListView() = default;
+
+    bool Concat(const AFIDataList& src) override
+    {
+        return InnerAppend(src, 0, src.GetCount());
+    }
+
+    bool Split(const std::string& src, const std::string& split) override
+    {
+        // sub strings would have no owner
+        ARK_ASSERT_RET_VAL(0, false);
+    }
+
+    bool Append(const AFIData& data) override
+    {
+        switch (data.GetType())
+        {
+            case ArkDataType::DT_BOOLEAN:
+                return AddBool(data.GetBool());
+            case ArkDataType::DT_INT32:
+                return AddInt(data.GetInt());
+            case ArkDataType::DT_INT64:
+                return AddInt64(data.GetInt64());
+            case ArkDataType::DT_UINT32:
+                return AddUInt(data.GetUInt());
+            case ArkDataType::DT_UINT64:
+                return AddUInt64(data.GetUInt64());
+            case ArkDataType::DT_FLOAT:
+                return AddFloat(data.GetFloat());
+            case ArkDataType::DT_DOUBLE:
+                return AddDouble(data.GetDouble());
+            case ArkDataType::DT_STRING:
+                return AddString(data.GetString());
+            case ArkDataType::DT_POINTER:
+                return AddPointer(data.GetPointer());
+            case ArkDataType::DT_USERDATA:
+            {
+                size_t size;
+                const void* pData = data.GetUserData(size);
+                return AddUserData(pData, size);
+            }
+            default:
+                ARK_ASSERT_RET_VAL(0, false);
+        }
+    }
+
+    bool Append(const AFIDataList& src, size_t start, size_t count) override
+    {
+        if (start >= src.GetCount())
+        {
+            return false;
+        }
+
+        size_t end = start + count;
+        if (end > src.GetCount())
+        {
+            return false;
+        }
+
+        return InnerAppend(src, start, end);
+    }
+
+    void Clear() override
+    {
+        mnDataUsed = 0;
+    }
+
+    bool Empty() const override
+    {
+        return (0 == mnDataUsed);
+    }
+
+    size_t GetCount() const override
+    {
+        return mnDataUsed;
+    }
+
+    ArkDataType GetType(size_t index) const override
+    {
+        if (index >= mnDataUsed)
+        {
+            return ArkDataType::DT_EMPTY;
+        }
+
+        return mxData[index].nType;
+    }
+
+    // add data
+    bool AddBool(bool value) override
+    {
+        view_data_t* p = AddViewData(ArkDataType::DT_BOOLEAN);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mbValue = value;
+        return true;
+    }
+
+    bool AddInt(int value) override
+    {
+        view_data_t* p = AddViewData(ArkDataType::DT_INT32);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mnValue = value;
+        return true;
+    }
+
+    bool AddInt64(int64_t value) override
+    {
+        view_data_t* p = AddViewData(ArkDataType::DT_INT64);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mn64Value = value;
+        return true;
+    }
+
+    bool AddUInt(uint32_t value) override
+    {
+        view_data_t* p = AddViewData(ArkDataType::DT_UINT32);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mnUValue = value;
+        return true;
+    }
+
+    bool AddUInt64(uint64_t value) override
+    {
+        view_data_t* p = AddViewData(ArkDataType::DT_UINT64);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mnU64Value = value;
+        return true;
+    }
+
+    bool AddFloat(float value) override
+    {
+        view_data_t* p = AddViewData(ArkDataType::DT_FLOAT);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mfValue = value;
+        return true;
+    }
+
+    bool AddDouble(double value) override
+    {
+        view_data_t* p = AddViewData(ArkDataType::DT_DOUBLE);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mdValue = value;
+        return true;
+    }
+
+    bool AddString(const char* value) override
+    {
+        assert(value != nullptr);
+        view_data_t* p = AddViewData(ArkDataType::DT_STRING);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mstrValue = value;
+        return true;
+    }
+
+    bool AddPointer(void* value) override
+    {
+        view_data_t* p = AddViewData(ArkDataType::DT_POINTER);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mpVaule = value;
+        return true;
+    }
+
+    bool AddUserData(const void* pData, size_t size) override
+    {
+        assert(pData != nullptr);
+        view_data_t* p = AddViewData(ArkDataType::DT_USERDATA);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mxUserData.mpData = pData;
+        p->mxUserData.mnSize = size;
+        p->mxUserData.mpRawData = nullptr;
+        return true;
+    }
+
+    bool AddRawUserData(void* value) override
+    {
+        assert(value != nullptr);
+        view_data_t* p = AddViewData(ArkDataType::DT_USERDATA);
+        ARK_ASSERT_RET_VAL(p != nullptr, false);
+        p->mxUserData.mpData = AFIData::GetUserData(value);
+        p->mxUserData.mnSize = AFIData::GetUserDataSize(value);
+        p->mxUserData.mpRawData = value;
+        return true;
+    }
+
+    // get data
+    bool Bool(size_t index) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_BOOLEAN);
+        return (p != nullptr) ? p->mbValue : NULL_BOOLEAN;
+    }
+
+    int Int(size_t index) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_INT32);
+        return (p != nullptr) ? p->mnValue : NULL_INT;
+    }
+
+    int64_t Int64(size_t index) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_INT64);
+        return (p != nullptr) ? p->mn64Value : NULL_INT64;
+    }
+
+    uint32_t UInt(size_t index) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_UINT32);
+        return (p != nullptr) ? p->mnUValue : NULL_INT;
+    }
+
+    uint64_t UInt64(size_t index) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_UINT64);
+        return (p != nullptr) ? p->mnU64Value : NULL_INT64;
+    }
+
+    float Float(size_t index) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_FLOAT);
+        return (p != nullptr) ? p->mfValue : NULL_FLOAT;
+    }
+
+    double Double(size_t index) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_DOUBLE);
+        return (p != nullptr) ? p->mdValue : NULL_DOUBLE;
+    }
+
+    const char* String(size_t index) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_STRING);
+        return (p != nullptr) ? p->mstrValue : NULL_STR.c_str();
+    }
+
+    void* Pointer(size_t index) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_POINTER);
+        return (p != nullptr) ? p->mpVaule : nullptr;
+    }
+
+    const void* UserData(size_t index, size_t& size) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_USERDATA);
+        if (p == nullptr)
+        {
+            size = 0;
+            return nullptr;
+        }
+
+        size = p->mxUserData.mnSize;
+        return p->mxUserData.mpData;
+    }
+
+    // only user data added by AddRawUserData has a raw buffer
+    void* RawUserData(size_t index) const override
+    {
+        const view_data_t* p = GetViewData(index, ArkDataType::DT_USERDATA);
+        return (p != nullptr) ? p->mxUserData.mpRawData : nullptr;
+    }
+
+    const std::string ToString(size_t index) override
+    {
+        if (index >= mnDataUsed)
+        {
+            return NULL_STR;
+        }
+
+        std::string data;
+        switch (mxData[index].nType)
+        {
+            case ArkDataType::DT_BOOLEAN:
+                data = ARK_TO_STRING(mxData[index].mbValue);
+                break;
+            case ArkDataType::DT_INT32:
+                data = ARK_TO_STRING(mxData[index].mnValue);
+                break;
+            case ArkDataType::DT_INT64:
+                data = ARK_TO_STRING(mxData[index].mn64Value);
+                break;
+            case ArkDataType::DT_UINT32:
+                data = ARK_TO_STRING(mxData[index].mnUValue);
+                break;
+            case ArkDataType::DT_UINT64:
+                data = ARK_TO_STRING(mxData[index].mnU64Value);
+                break;
+            case ArkDataType::DT_FLOAT:
+                data = ARK_TO_STRING(mxData[index].mfValue);
+                break;
+            case ArkDataType::DT_DOUBLE:
+                data = ARK_TO_STRING(mxData[index].mdValue);
+                break;
+            case ArkDataType::DT_STRING:
+                data = mxData[index].mstrValue;
+                break;
+            case ArkDataType::DT_POINTER:
+                break;
+            case ArkDataType::DT_USERDATA:
+                break;
+            default:
+                assert(0);
+                break;
+        }
+
+        return data;
+    }
+
+    size_t GetMemUsage() const override
+    {
+        return sizeof(self_t);
+    }
+
+protected:
+    view_data_t* AddViewData(ArkDataType type)
+    {
+        // fixed capacity, never grow
+        if (mnDataUsed >= DATA_SIZE)
+        {
+            return nullptr;
+        }
+
+        view_data_t* p = mxData + mnDataUsed++;
+        p->nType = type;
+        return p;
+    }
+
+    const view_data_t* GetViewData(size_t index, ArkDataType type) const
+    {
+        if (index >= mnDataUsed || mxData[index].nType != type)
+        {
+            return nullptr;
+        }
+
+        return mxData + index;
+    }
+
+    bool InnerAppend(const AFIDataList& src, size_t start, size_t end)
+    {
+        bool bRet(true);
+
+        for (size_t i = start; i < end && bRet; ++i)
+        {
+            switch (src.GetType(i))
+            {
+                case ArkDataType::DT_BOOLEAN:
+                    bRet = AddBool(src.Bool(i));
+                    break;
+                case ArkDataType::DT_INT32:
+                    bRet = AddInt(src.Int(i));
+                    break;
+                case ArkDataType::DT_INT64:
+                    bRet = AddInt64(src.Int64(i));
+                    break;
+                case ArkDataType::DT_UINT32:
+                    bRet = AddUInt(src.UInt(i));
+                    break;
+                case ArkDataType::DT_UINT64:
+                    bRet = AddUInt64(src.UInt64(i));
+                    break;
+                case ArkDataType::DT_FLOAT:
+                    bRet = AddFloat(src.Float(i));
+                    break;
+                case ArkDataType::DT_DOUBLE:
+                    bRet = AddDouble(src.Double(i));
+                    break;
+                case ArkDataType::DT_STRING:
+                    bRet = AddString(src.String(i));
+                    break;
+                case ArkDataType::DT_POINTER:
+                    bRet = AddPointer(src.Pointer(i));
+                    break;
+                case ArkDataType::DT_USERDATA:
+                {
+                    void* pRawData = src.RawUserData(i);
+                    if (pRawData != nullptr)
+                    {
+                        bRet = AddRawUserData(pRawData);
+                    }
+                    else
+                    {
+                        size_t size;
+                        const void* pData = src.UserData(i, size);
+                        bRet = AddUserData(pData, size);
+                    }
+                }
+                break;
+                default:
+                    ARK_ASSERT_NO_EFFECT(0);
+                    bRet = false;
+                    break;
+            }
+        }
+
+        return bRet;
+    }
+
+private:
+    view_data_t mxData[DATA_SIZE];
+    size_t mnDataUsed{0};
+};
+
+using AFDataListView = AFBaseDataListView<8>;
+
+} // namespace ark
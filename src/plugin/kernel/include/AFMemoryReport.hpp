@@ -0,0 +1,108 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPlatform.hpp"
+#include "base/AFMacros.hpp"
+#include "base/AFDefine.hpp"
+
+namespace ark {
+
+// Memory usage of entities in a process, filled by AFIKernelModule::GetMemoryReport.
+// Bytes per class, table, container and entity are estimates summed from object and container sizes.
+// Allocator stats are measured: entity objects, nodes, tables, rows and containers are counted with
+// the alloc tag of the entity class when allocated, data buffers with the tag of the thread.
+class AFMemoryReport final
+{
+public:
+    struct Stat
+    {
+        uint64_t count_{0};
+        uint64_t bytes_{0};
+    };
+
+    using StatList = std::map<std::string, Stat>;
+    using EntityStat = std::pair<AFGUID, uint64_t>;
+
+    // entity count and bytes per class
+    StatList class_stats_;
+
+    // row count and bytes per table, key is class.table
+    StatList table_stats_;
+
+    // entity count and bytes per container, key is class.container, contained entities are counted by class
+    StatList container_stats_;
+
+    // heaviest entities, sorted by bytes
+    std::vector<EntityStat> top_entities_;
+
+    // live allocations of kernel allocator, counted by allocator itself
+    Stat alloc_stat_;
+    uint64_t total_alloc_count_{0};
+
+    // live allocations per alloc tag, key is class name or untagged
+    StatList alloc_class_stats_;
+
+    std::string ToString() const
+    {
+        std::string out;
+
+        uint64_t total_bytes = 0;
+        out += "[class] count estimated_bytes\n";
+        for (auto& iter : class_stats_)
+        {
+            total_bytes += iter.second.bytes_;
+            out += ARK_FORMAT("{} {} {}\n", iter.first, iter.second.count_, iter.second.bytes_);
+        }
+
+        out += "[table] rows estimated_bytes\n";
+        for (auto& iter : table_stats_)
+        {
+            out += ARK_FORMAT("{} {} {}\n", iter.first, iter.second.count_, iter.second.bytes_);
+        }
+
+        out += "[container] entities estimated_bytes\n";
+        for (auto& iter : container_stats_)
+        {
+            out += ARK_FORMAT("{} {} {}\n", iter.first, iter.second.count_, iter.second.bytes_);
+        }
+
+        out += "[top entity] id estimated_bytes\n";
+        for (auto& iter : top_entities_)
+        {
+            out += ARK_FORMAT("{} {}\n", iter.first, iter.second);
+        }
+
+        out += "[allocator class, measured] live_count live_bytes\n";
+        for (auto& iter : alloc_class_stats_)
+        {
+            out += ARK_FORMAT("{} {} {}\n", iter.first, iter.second.count_, iter.second.bytes_);
+        }
+
+        out += ARK_FORMAT("[allocator, measured, whole module] live_count = {} live_bytes = {} total_count = {}\n",
+            alloc_stat_.count_, alloc_stat_.bytes_, total_alloc_count_);
+        out += ARK_FORMAT("[total] estimated_entity_bytes = {}\n", total_bytes);
+
+        return out;
+    }
+};
+
+} // namespace ark
@@ -42,6 +42,9 @@ private:
     // data list
     DataList data_list_;
 
+    // nodes created later are counted with the tag the manager was created with
+    uint32_t alloc_tag_{AFAllocCounter::CurrentTag()};
+
 public:
     AFNodeManager() = delete;
 
@@ -111,6 +114,8 @@ public:
     // other query
     const DataList& GetDataList() const;
 
+    size_t GetMemUsage() const;
+
 private:
     uint32_t GetIndex(const std::string& name) const;
 
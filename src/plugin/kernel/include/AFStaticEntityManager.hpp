@@ -25,10 +25,17 @@
 
 namespace ark {
 
+// Static entities are kept in a flat array sorted by config id, rows of a class share one packed layout.
+// A batch of creation is appended and sorted once in BuildIndex, lookup is then a binary search,
+// or a direct index on dense ids.
 class AFStaticEntityManager final
 {
 public:
-    using StaticObjectList = AFSmartPtrMap<ID_TYPE, AFIStaticEntity>;
+    using StaticObject = std::pair<ID_TYPE, std::shared_ptr<AFIStaticEntity>>;
+    using StaticObjectList = std::vector<StaticObject>;
+
+    // build direct index only when ids fill at least 1/DIRECT_INDEX_RATIO of the range
+    static const size_t DIRECT_INDEX_RATIO = 4;
 
     AFStaticEntityManager() = default;
     virtual ~AFStaticEntityManager() = default;
@@ -39,26 +46,150 @@ public:
         ARK_ASSERT_RET_VAL(pClassMeta != nullptr && pNodeManager != nullptr, nullptr);
 
         // return nullptr if existed
-        auto iter = static_object_list_.find(config_id);
-        ARK_ASSERT_RET_VAL(iter == static_object_list_.end(), nullptr);
+        ARK_ASSERT_RET_VAL(FindObject(config_id) == nullptr, nullptr);
 
         // create new class
-        auto pObject = std::make_shared<AFCStaticEntity>(pClassMeta, pNodeManager, config_id);
-        if (!static_object_list_.insert(config_id, pObject).second)
+        auto pObject = std::make_shared<AFCStaticEntity>(GetLayout(pClassMeta), pNodeManager.get(), config_id);
+        AddStaticEntity(pObject);
+
+        return pObject;
+    }
+
+    // add a static entity built on a layout of this manager, return false if existed
+    bool AddStaticEntity(std::shared_ptr<AFCStaticEntity> pObject)
+    {
+        ARK_ASSERT_RET_VAL(pObject != nullptr, false);
+
+        const ID_TYPE config_id = pObject->GetConfigID();
+        ARK_ASSERT_RET_VAL(FindObject(config_id) == nullptr, false);
+
+        // append, sorted in BuildIndex
+        pending_index_.insert(std::make_pair(config_id, static_object_list_.size()));
+        static_object_list_.emplace_back(config_id, pObject);
+
+        // positions will move, fall back to search until index rebuilt
+        direct_index_.clear();
+
+        return true;
+    }
+
+    // replace the data of a config, the old entity stays valid for whom still hold it
+    std::shared_ptr<AFIStaticEntity> ReplaceStaticEntity(
+        std::shared_ptr<AFClassMeta> pClassMeta, std::shared_ptr<AFNodeManager> pNodeManager, const ID_TYPE config_id)
+    {
+        ARK_ASSERT_RET_VAL(pClassMeta != nullptr && pNodeManager != nullptr, nullptr);
+
+        auto pos = FindPos(config_id);
+        if (pos == static_object_list_.size())
         {
-            return nullptr;
+            return CreateStaticEntity(pClassMeta, pNodeManager, config_id);
         }
 
+        auto pObject = std::make_shared<AFCStaticEntity>(GetLayout(pClassMeta), pNodeManager.get(), config_id);
+        static_object_list_[pos].second = pObject;
+
         return pObject;
     }
 
     std::shared_ptr<AFIStaticEntity> FindObject(const ID_TYPE config_id) const
     {
-        return static_object_list_.find_value(config_id);
+        auto pos = FindPos(config_id);
+        return pos == static_object_list_.size() ? nullptr : static_object_list_[pos].second;
+    }
+
+    // call after a batch of creation
+    void BuildIndex()
+    {
+        direct_index_.clear();
+
+        // sort the appended tail once and merge it into the sorted head, ids are unique
+        if (sorted_count_ < static_object_list_.size())
+        {
+            auto less = [](const StaticObject& left, const StaticObject& right) { return left.first < right.first; };
+            auto middle = static_object_list_.begin() + sorted_count_;
+            std::sort(middle, static_object_list_.end(), less);
+            std::inplace_merge(static_object_list_.begin(), middle, static_object_list_.end(), less);
+        }
+
+        sorted_count_ = static_object_list_.size();
+        pending_index_.clear();
+        static_object_list_.shrink_to_fit();
+
+        if (static_object_list_.empty())
+        {
+            return;
+        }
+
+        min_id_ = static_object_list_.front().first;
+        size_t range = static_cast<size_t>(static_object_list_.back().first - min_id_) + 1;
+        if (range > static_object_list_.size() * DIRECT_INDEX_RATIO)
+        {
+            return;
+        }
+
+        // store position + 1, 0 means empty
+        direct_index_.resize(range, 0);
+        for (size_t i = 0; i < static_object_list_.size(); ++i)
+        {
+            direct_index_[static_object_list_[i].first - min_id_] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+    const StaticObjectList& GetStaticObjectList() const
+    {
+        return static_object_list_;
+    }
+
+    // row layout of a class, rebuilt when the class meta changed
+    std::shared_ptr<AFStaticLayout> GetLayout(std::shared_ptr<AFClassMeta> pClassMeta)
+    {
+        auto& pLayout = layout_list_[pClassMeta->GetName()];
+        if (pLayout == nullptr || pLayout->GetClassMeta() != pClassMeta)
+        {
+            pLayout = std::make_shared<AFStaticLayout>(pClassMeta);
+        }
+
+        return pLayout;
     }
 
 private:
+    // position in static object list, list size if not found
+    size_t FindPos(const ID_TYPE config_id) const
+    {
+        if (!direct_index_.empty())
+        {
+            if (config_id < min_id_ || config_id - min_id_ >= direct_index_.size())
+            {
+                return static_object_list_.size();
+            }
+
+            uint32_t pos = direct_index_[config_id - min_id_];
+            return pos == 0 ? static_object_list_.size() : pos - 1;
+        }
+
+        auto sorted_end = static_object_list_.begin() + sorted_count_;
+        auto iter = std::lower_bound(static_object_list_.begin(), sorted_end, config_id,
+            [](const StaticObject& object, const ID_TYPE id) { return object.first < id; });
+        if (iter != sorted_end && iter->first == config_id)
+        {
+            return static_cast<size_t>(iter - static_object_list_.begin());
+        }
+
+        auto iter_pending = pending_index_.find(config_id);
+        return iter_pending == pending_index_.end() ? static_object_list_.size() : iter_pending->second;
+    }
+
     StaticObjectList static_object_list_;
+
+    // head of the list is sorted, the tail is appended since last BuildIndex
+    size_t sorted_count_{0};
+    std::unordered_map<ID_TYPE, size_t> pending_index_;
+
+    ID_TYPE min_id_{0};
+    std::vector<uint32_t> direct_index_;
+
+    // class name -> row layout
+    std::unordered_map<std::string, std::shared_ptr<AFStaticLayout>> layout_list_;
 };
 
 } // namespace ark
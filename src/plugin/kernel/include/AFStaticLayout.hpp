@@ -0,0 +1,141 @@
+/*
+ * This source file is part of ArkNX
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFMacros.hpp"
+#include "base/AFEnum.hpp"
+#include "base/AFDefine.hpp"
+#include "AFClassMeta.hpp"
+
+namespace ark {
+
+// Row layout shared by all static entities of a class.
+// Numeric fields of a row are packed into one value buffer at fixed offsets,
+// string fields go to the string list of the row, so a row is two allocations instead of one node per field.
+class AFStaticLayout final
+{
+public:
+    struct Field
+    {
+        std::shared_ptr<AFNodeMeta> meta_{nullptr};
+        ArkDataType type_{ArkDataType::DT_EMPTY};
+
+        // byte offset in value buffer, or position in string list
+        uint32_t offset_{0};
+    };
+
+    using FieldList = std::vector<Field>;
+
+    AFStaticLayout() = delete;
+
+    explicit AFStaticLayout(std::shared_ptr<AFClassMeta> pClassMeta)
+        : class_meta_(pClassMeta)
+    {
+        for (auto iter : pClassMeta->GetDataMetaList())
+        {
+            auto pDataMeta = iter.second;
+
+            Field field;
+            field.meta_ = pDataMeta;
+            field.type_ = pDataMeta->GetType();
+            if (field.type_ == ArkDataType::DT_STRING)
+            {
+                field.offset_ = string_count_++;
+            }
+            else
+            {
+                // types without a node, e.g. table, are kept with zero size
+                field.offset_ = value_size_;
+                value_size_ += GetValueSize(field.type_);
+            }
+
+            field_index_.insert(std::make_pair(iter.first, static_cast<uint32_t>(field_list_.size())));
+            field_list_.push_back(field);
+        }
+    }
+
+    std::shared_ptr<AFClassMeta> GetClassMeta() const
+    {
+        return class_meta_;
+    }
+
+    const FieldList& GetFieldList() const
+    {
+        return field_list_;
+    }
+
+    const Field* FindField(const uint32_t index) const
+    {
+        auto iter = field_index_.find(index);
+        return iter == field_index_.end() ? nullptr : &field_list_[iter->second];
+    }
+
+    const Field* FindField(const std::string& name) const
+    {
+        return FindField(class_meta_->GetIndex(name));
+    }
+
+    uint32_t GetValueSize() const
+    {
+        return value_size_;
+    }
+
+    uint32_t GetStringCount() const
+    {
+        return string_count_;
+    }
+
+    static uint32_t GetValueSize(const ArkDataType type)
+    {
+        switch (type)
+        {
+            case ArkDataType::DT_BOOLEAN:
+                return sizeof(bool);
+            case ArkDataType::DT_INT32:
+            case ArkDataType::DT_UINT32:
+                return sizeof(int32_t);
+            case ArkDataType::DT_INT64:
+            case ArkDataType::DT_UINT64:
+                return sizeof(int64_t);
+            case ArkDataType::DT_FLOAT:
+                return sizeof(float);
+            case ArkDataType::DT_DOUBLE:
+                return sizeof(double);
+            case ArkDataType::DT_GUID:
+                return sizeof(AFGUID);
+            default:
+                return 0;
+        }
+    }
+
+private:
+    std::shared_ptr<AFClassMeta> class_meta_{nullptr};
+
+    FieldList field_list_;
+
+    // data meta index -> position in field list
+    std::unordered_map<uint32_t, uint32_t> field_index_;
+
+    uint32_t value_size_{0};
+    uint32_t string_count_{0};
+};
+
+} // namespace ark
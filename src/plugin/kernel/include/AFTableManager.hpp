@@ -38,12 +38,19 @@ private:
     // table list
     TableList table_list_;
 
+    // frozen flag of the owner entity
+    std::shared_ptr<const bool> frozen_{nullptr};
+
+    // tables created later are counted with the tag the manager was created with
+    uint32_t alloc_tag_{AFAllocCounter::CurrentTag()};
+
 public:
     AFTableManager() = delete;
 
-    explicit AFTableManager(std::shared_ptr<AFClassMeta> pClassMeta)
+    explicit AFTableManager(std::shared_ptr<AFClassMeta> pClassMeta, std::shared_ptr<const bool> frozen)
     {
         class_meta_ = pClassMeta;
+        frozen_ = frozen;
     }
 
     // table operation
@@ -57,7 +64,8 @@ public:
         auto pTableMeta = class_meta_->FindTableMeta(index);
         ARK_ASSERT_RET_VAL(pTableMeta != nullptr, nullptr);
 
-        pTable = ARK_NEW AFCTable(pTableMeta, std::forward<AFCTable::TABLE_CALLBACK_FUNCTOR>(func));
+        AFAllocTagScope alloc_scope(alloc_tag_);
+        pTable = ARK_NEW AFCTable(pTableMeta, frozen_, std::forward<AFCTable::TABLE_CALLBACK_FUNCTOR>(func));
         ARK_ASSERT_RET_VAL(pTable != nullptr, nullptr);
 
         if (!table_list_.insert(index, pTable).second)
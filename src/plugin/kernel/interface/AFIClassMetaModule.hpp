@@ -33,7 +33,8 @@ class AFIClassMetaModule : public AFIModule
 public:
     virtual bool Load() = 0;
 
-    virtual bool AddClassCallBack(const std::string& class_name, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
+    virtual bool AddClassCallBack(
+        const std::string& class_name, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) = 0;
 
     virtual bool DoClassEvent(
         const AFGUID& id, const std::string& class_name, const ArkEntityEvent class_event, const AFIDataList& args) = 0;
@@ -33,6 +33,20 @@ public:
     virtual bool Save() = 0;
     virtual bool Clear() = 0;
 
+    // parse changed config files in background, changes are applied at the next frame
+    virtual bool Reload() = 0;
+
+    template<typename BaseType>
+    bool AddReloadCallBack(
+        BaseType* pBase, void (BaseType::*handler)(const std::string&, const std::vector<ID_TYPE>&))
+    {
+        auto functor = std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2);
+        return AddReloadCallBack(std::move(functor));
+    }
+
+    // called with class name and changed config ids after a reload is applied
+    virtual bool AddReloadCallBack(CONFIG_RELOAD_FUNCTOR&& cb) = 0;
+
     // find config
     virtual std::shared_ptr<AFIStaticEntity> FindStaticEntity(const ID_TYPE config_id) = 0;
 };
@@ -58,6 +58,9 @@ public:
 
     virtual bool Destroy(const uint32_t index) = 0;
     virtual bool Destroy(const AFGUID& id) = 0;
+
+    // memory usage in bytes, contained entities are not included
+    virtual size_t GetMemUsage() const = 0;
 };
 
 } // namespace ark
@@ -43,6 +43,10 @@ public:
 
     virtual void Update() = 0;
 
+    // a frozen entity refuses node, position and scene writes, e.g. while it is migrating to another game
+    virtual void SetFrozen(const bool value) = 0;
+    virtual bool IsFrozen() const = 0;
+
     // get base data
     virtual bool IsPublic(const std::string& name) const = 0;
     virtual bool IsPublic(const uint32_t index) const = 0;
@@ -168,8 +172,35 @@ public:
     virtual bool FindCustomData(const std::string& name) const = 0;
     virtual bool RemoveCustomData(const std::string& name) = 0;
 
+    // custom data by slot, slot is registered once by AFIKernelModule::RegisterCustomData
+    virtual bool SetCustomBool(const uint32_t slot, bool value) = 0;
+    virtual bool SetCustomInt32(const uint32_t slot, const int32_t value) = 0;
+    virtual bool SetCustomUInt32(const uint32_t slot, const uint32_t value) = 0;
+    virtual bool SetCustomInt64(const uint32_t slot, const int64_t value) = 0;
+    virtual bool SetCustomFloat(const uint32_t slot, const float value) = 0;
+    virtual bool SetCustomDouble(const uint32_t slot, const double value) = 0;
+    virtual bool SetCustomString(const uint32_t slot, const std::string& value) = 0;
+
+    virtual bool GetCustomBool(const uint32_t slot) const = 0;
+    virtual int32_t GetCustomInt32(const uint32_t slot) const = 0;
+    virtual uint32_t GetCustomUInt32(const uint32_t slot) const = 0;
+    virtual int64_t GetCustomInt64(const uint32_t slot) const = 0;
+    virtual float GetCustomFloat(const uint32_t slot) const = 0;
+    virtual double GetCustomDouble(const uint32_t slot) const = 0;
+    virtual const char* GetCustomString(const uint32_t slot) const = 0;
+
+    virtual bool FindCustomData(const uint32_t slot) const = 0;
+    virtual bool RemoveCustomData(const uint32_t slot) = 0;
+
     virtual bool IsSent() const = 0;
     virtual void UpdateSent() = 0;
+
+    // increased on every node or table change, used to invalidate cached data
+    virtual uint32_t GetDataVersion() const = 0;
+
+    // estimated memory usage in bytes of nodes, tables, containers and custom data,
+    // summed from object and container sizes, not measured by the allocator
+    virtual size_t GetMemUsage() const = 0;
 };
 
 } // namespace ark
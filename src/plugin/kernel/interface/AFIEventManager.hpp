@@ -26,29 +26,74 @@
 
 namespace ark {
 
+// callback of typed event, payload points to the event struct
+using TYPED_EVENT_FUNCTOR = std::function<int(const AFGUID&, const int, const void*)>;
+
+// Event registry shared by all entities.
+//
+// A typed event is a struct with a unique EVENT_ID, e.g.
+// struct AFDamageEvent
+// {
+//     static const int EVENT_ID = 1001;
+//     AFGUID attacker_{NULL_GUID};
+//     int32_t damage_{0};
+// };
 class AFIEventManager
 {
 public:
+    virtual ~AFIEventManager() = default;
+
+    // deliver queued events and apply removed callbacks, once per frame
     virtual void Update() = 0;
 
-    template<typename BaseType>
-    bool AddEventCallBack(
-        const int nEventID, BaseType* pBase, int (BaseType::*handler)(const AFGUID&, const int, const AFIDataList&))
+    virtual bool AddEventCallBack(const AFGUID& self, const int event_id, EVENT_PROCESS_FUNCTOR&& cb) = 0;
+
+    // remove all callbacks of an event, list and typed
+    virtual bool RemoveEventCallBack(const AFGUID& self, const int event_id) = 0;
+
+    // remove all callbacks of an entity
+    virtual bool Clear(const AFGUID& self) = 0;
+
+    // deliver at once
+    virtual bool DoEvent(const AFGUID& self, const int event_id, const AFIDataList& args) = 0;
+
+    // queued and delivered in Update
+    virtual bool PostEvent(const AFGUID& self, const int event_id, const AFIDataList& args) = 0;
+
+    template<typename EVENT>
+    bool AddEventCallBack(const AFGUID& self, std::function<int(const AFGUID&, const EVENT&)>&& cb)
     {
-        EVENT_PROCESS_FUNCTOR functor =
-            std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        return AddEventCallBack(nEventID, std::move(functor));
-    }
+        TYPED_EVENT_FUNCTOR functor = [cb](const AFGUID& id, const int event_id, const void* pEvent) -> int {
+            return cb(id, *static_cast<const EVENT*>(pEvent));
+        };
 
-    virtual bool RemoveEventCallBack(const int nEventID) = 0;
+        return AddTypedEventCallBack(self, EVENT::EVENT_ID, std::move(functor));
+    }
 
-    virtual bool DoEvent(const int nEventID, const AFIDataList& valueList) = 0;
+    template<typename BaseType, typename EVENT>
+    bool AddEventCallBack(const AFGUID& self, BaseType* pBase, int (BaseType::*handler)(const AFGUID&, const EVENT&))
+    {
+        std::function<int(const AFGUID&, const EVENT&)> functor =
+            std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2);
+        return AddEventCallBack<EVENT>(self, std::move(functor));
+    }
 
-    virtual bool AddEventCallBack(const int nEventID, EVENT_PROCESS_FUNCTOR&& cb) = 0;
+    template<typename EVENT>
+    bool DoEvent(const AFGUID& self, const EVENT& event)
+    {
+        return DoTypedEvent(self, EVENT::EVENT_ID, &event);
+    }
 
-    virtual bool Clear() = 0;
+    template<typename EVENT>
+    bool PostEvent(const AFGUID& self, EVENT event)
+    {
+        return PostTypedEvent(self, EVENT::EVENT_ID, std::make_shared<EVENT>(std::move(event)));
+    }
 
 protected:
-    virtual bool HasEventCallBack(const int nEventID) = 0;
+    virtual bool AddTypedEventCallBack(const AFGUID& self, const int event_id, TYPED_EVENT_FUNCTOR&& cb) = 0;
+    virtual bool DoTypedEvent(const AFGUID& self, const int event_id, const void* pEvent) = 0;
+    virtual bool PostTypedEvent(const AFGUID& self, const int event_id, std::shared_ptr<void> pEvent) = 0;
 };
-} // namespace ark
\ No newline at end of file
+
+} // namespace ark
@@ -22,8 +22,11 @@
 
 #include "interface/AFIModule.hpp"
 #include "kernel/interface/AFIEntity.hpp"
+#include "kernel/interface/AFIEventManager.hpp"
 #include "proto/AFProtoCPP.hpp"
 #include "AFIStaticEntity.hpp"
+#include "kernel/include/AFMemoryReport.hpp"
+#include "kernel/include/AFCallBackProfile.hpp"
 
 namespace ark {
 
@@ -37,7 +40,7 @@ public:
     {
         auto functor = std::bind(
             handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-        return AddCommonClassEvent(std::move(functor), prio);
+        return AddCommonClassEvent(std::move(functor), prio, GET_CLASS_NAME(BaseType));
     }
 
     /////////////////////////////////////////////////////////////////
@@ -49,6 +52,27 @@ public:
         return AddEventCallBack(self, nEventID, std::move(functor));
     }
 
+    // typed event, see AFIEventManager
+    template<typename BaseType, typename EVENT>
+    bool AddEventCallBack(const AFGUID& self, BaseType* pBase, int (BaseType::*handler)(const AFGUID&, const EVENT&))
+    {
+        ARK_ASSERT_RET_VAL(Exist(self), false);
+        return GetEventManager()->AddEventCallBack(self, pBase, handler);
+    }
+
+    template<typename EVENT>
+    bool DoEvent(const AFGUID& self, const EVENT& event)
+    {
+        return GetEventManager()->DoEvent(self, event);
+    }
+
+    // delivered at the end of frame
+    template<typename EVENT>
+    bool PostEvent(const AFGUID& self, EVENT event)
+    {
+        return GetEventManager()->PostEvent(self, std::move(event));
+    }
+
     template<typename BaseType>
     bool AddClassCallBack(const std::string& name, BaseType* pBase,
         int (BaseType::*handler)(const AFGUID&, const std::string&, const ArkEntityEvent, const AFIDataList&),
@@ -56,7 +80,7 @@ public:
     {
         auto functor = std::bind(
             handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-        return AddClassCallBack(name, std::move(functor), prio);
+        return AddClassCallBack(name, std::move(functor), prio, GET_CLASS_NAME(BaseType));
     }
 
     template<typename BaseType>
@@ -67,7 +91,7 @@ public:
         return AddNodeCallBack(class_name, name,
             std::move(std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
                 std::placeholders::_4, std::placeholders::_5)),
-            prio);
+            prio, GET_CLASS_NAME(BaseType));
     }
 
     template<typename BaseType>
@@ -78,7 +102,7 @@ public:
         return AddTableCallBack(class_name, name,
             std::move(std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
                 std::placeholders::_4)),
-            prio);
+            prio, GET_CLASS_NAME(BaseType));
     }
 
     // call back by index
@@ -90,7 +114,7 @@ public:
         return AddNodeCallBack(class_name, index,
             std::move(std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
                 std::placeholders::_4, std::placeholders::_5)),
-            prio);
+            prio, GET_CLASS_NAME(BaseType));
     }
 
     template<typename BaseType>
@@ -101,7 +125,7 @@ public:
         return AddTableCallBack(class_name, index,
             std::move(std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
                 std::placeholders::_4)),
-            prio);
+            prio, GET_CLASS_NAME(BaseType));
     }
 
     // container call back
@@ -114,7 +138,7 @@ public:
         return AddContainerCallBack(class_name, index,
             std::move(std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
                 std::placeholders::_4, std::placeholders::_5)),
-            prio);
+            prio, GET_CLASS_NAME(BaseType));
     }
 
     // only for player
@@ -127,7 +151,7 @@ public:
         return AddCommonContainerCallBack(
             std::move(std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3,
                 std::placeholders::_4, std::placeholders::_5)),
-            prio);
+            prio, GET_CLASS_NAME(BaseType));
     }
 
     // scene event call back
@@ -137,7 +161,7 @@ public:
     {
         return AddLeaveSceneEvent(class_name,
             std::move(std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)),
-            prio);
+            prio, GET_CLASS_NAME(BaseType));
     }
 
     template<typename BaseType>
@@ -146,7 +170,7 @@ public:
     {
         return AddEnterSceneEvent(class_name,
             std::move(std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)),
-            prio);
+            prio, GET_CLASS_NAME(BaseType));
     }
 
     // move event call back
@@ -156,7 +180,7 @@ public:
     {
         return AddMoveEvent(class_name,
             std::move(std::bind(handler, pBase, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)),
-            prio);
+            prio, GET_CLASS_NAME(BaseType));
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -164,6 +188,11 @@ public:
     virtual bool DoEvent(
         const AFGUID& self, const std::string& name, ArkEntityEvent eEvent, const AFIDataList& valueList) = 0;
     virtual bool DoEvent(const AFGUID& self, const int nEventID, const AFIDataList& valueList) = 0;
+    // delivered at the end of frame
+    virtual bool PostEvent(const AFGUID& self, const int nEventID, const AFIDataList& valueList) = 0;
+
+    // shared by all entities, allocated on first use
+    virtual std::shared_ptr<AFIEventManager> GetEventManager() = 0;
 
     /////////////////////////////////////////////////////////////////
     virtual std::shared_ptr<AFIEntity> CreateEntity(const AFGUID& self, const int map_id, const int map_instance_id,
@@ -175,6 +204,10 @@ public:
     virtual std::shared_ptr<AFIEntity> GetEntity(const AFGUID& self) = 0;
     virtual std::shared_ptr<AFIStaticEntity> GetStaticEntity(const ID_TYPE config_id) = 0;
 
+    // register a custom data slot once in module Init or PostInit, then use it with AFIEntity::SetCustomXXX(slot, ...)
+    // slot names are process wide, return UINT32_MAX if the name is registered with another type
+    virtual uint32_t RegisterCustomData(const std::string& name, const ArkDataType type) = 0;
+
     virtual bool DestroyEntity(const AFGUID& self) = 0;
     virtual bool DestroyAll() = 0;
 
@@ -191,6 +224,15 @@ public:
 
     virtual int LogObjectData(const AFGUID& guid) = 0;
 
+    // estimated memory usage of all entities by class, table and container, with top_count heaviest entities
+    virtual bool GetMemoryReport(AFMemoryReport& report, const size_t top_count) = 0;
+    virtual bool DumpMemoryReport(const std::string& file_path, const size_t top_count) = 0;
+
+    // call back profile, stats are written to log every dump_interval milliseconds, 0 means never
+    virtual void SetCallBackProfile(const bool enable, const int64_t dump_interval) = 0;
+    virtual bool GetCallBackProfile(std::vector<AFCallBackStat>& stat_list) = 0;
+    virtual void DumpCallBackProfile() = 0;
+
     // entity to pb
     virtual bool NodeToPBData(const uint32_t index, const AFIData& data, AFMsg::pb_entity_data* pb_data) = 0;
     virtual bool RowToPBData(AFIRow* pRow, const uint32_t index, AFMsg::pb_entity_data* pb_data) = 0;
@@ -203,27 +245,33 @@ public:
 
 protected:
     virtual bool AddEventCallBack(const AFGUID& self, const int nEventID, EVENT_PROCESS_FUNCTOR&& cb) = 0;
-    virtual bool AddClassCallBack(const std::string& strClassName, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
-
-    virtual bool AddNodeCallBack(
-        const std::string& class_name, const std::string& name, DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
-    virtual bool AddTableCallBack(
-        const std::string& class_name, const std::string& name, DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
-
-    virtual bool AddNodeCallBack(
-        const std::string& class_name, const uint32_t index, DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
-    virtual bool AddTableCallBack(
-        const std::string& class_name, const uint32_t index, DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
-
-    virtual bool AddContainerCallBack(
-        const std::string& class_name, const uint32_t index, CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
-    virtual bool AddCommonContainerCallBack(CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
-
-    virtual bool AddCommonClassEvent(CLASS_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
-
-    virtual bool AddLeaveSceneEvent(const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
-    virtual bool AddEnterSceneEvent(const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
-    virtual bool AddMoveEvent(const std::string& class_name, MOVE_EVENT_FUNCTOR&& cb, const int32_t prio) = 0;
+    // owner is the registering module, used by call back profile
+    virtual bool AddClassCallBack(const std::string& strClassName, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio,
+        const std::string& owner) = 0;
+
+    virtual bool AddNodeCallBack(const std::string& class_name, const std::string& name, DATA_NODE_EVENT_FUNCTOR&& cb,
+        const int32_t prio, const std::string& owner) = 0;
+    virtual bool AddTableCallBack(const std::string& class_name, const std::string& name,
+        DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) = 0;
+
+    virtual bool AddNodeCallBack(const std::string& class_name, const uint32_t index, DATA_NODE_EVENT_FUNCTOR&& cb,
+        const int32_t prio, const std::string& owner) = 0;
+    virtual bool AddTableCallBack(const std::string& class_name, const uint32_t index, DATA_TABLE_EVENT_FUNCTOR&& cb,
+        const int32_t prio, const std::string& owner) = 0;
+
+    virtual bool AddContainerCallBack(const std::string& class_name, const uint32_t index,
+        CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) = 0;
+    virtual bool AddCommonContainerCallBack(
+        CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) = 0;
+
+    virtual bool AddCommonClassEvent(CLASS_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) = 0;
+
+    virtual bool AddLeaveSceneEvent(
+        const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) = 0;
+    virtual bool AddEnterSceneEvent(
+        const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) = 0;
+    virtual bool AddMoveEvent(
+        const std::string& class_name, MOVE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner) = 0;
 };
 
 } // namespace ark
@@ -162,6 +162,9 @@ public:
     virtual bool ReleaseMapInstance(const int map_id, const int inst_id) = 0;
     virtual bool ExitMapInstance(const int map_id, const int inst_id) = 0;
 
+    // thread safe, run in main loop update, e.g. for an AFMailbox to reach entities
+    virtual void PostMainMessage(SCHEDULER_FUNCTOR&& func) = 0;
+
     virtual bool GetInstEntityList(const int map_id, const int inst_id, AFIDataList& list) = 0;
     virtual int GetEntityByDataNode(
         const int map_id, const std::string& data_node, const AFIDataList& args, AFIDataList& entities) = 0;
@@ -21,11 +21,12 @@
 #pragma once
 
 #include "base/AFPlatform.hpp"
+#include "base/AFCoreDef.hpp"
 #include "kernel/include/AFNodeMeta.hpp"
 
 namespace ark {
 
-class AFINode
+class AFINode : public AFAllocTagged
 {
 public:
     virtual ~AFINode() = default;
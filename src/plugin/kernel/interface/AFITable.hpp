@@ -33,6 +33,9 @@ public:
     // query row
     virtual uint32_t GetRow() const = 0;
 
+    // estimated memory usage in bytes
+    virtual size_t GetMemUsage() const = 0;
+
     // get row data
     virtual bool GetBool(const uint32_t index) const = 0;
     virtual int32_t GetInt32(const uint32_t index) const = 0;
@@ -120,6 +123,9 @@ public:
     virtual AFIRow* FindRow(uint32_t row) const = 0;
     virtual bool RemoveRow(uint32_t row) = 0;
     virtual void Clear() = 0;
+
+    // memory usage in bytes, rows included
+    virtual size_t GetMemUsage() const = 0;
 };
 
 } // namespace ark
@@ -157,6 +157,7 @@ bool AFCClassMetaModule::LoadEntityMeta(const std::string& schema_path)
         uint32_t feature_sync_self = meta_node.GetUint32("sync_self");
         uint32_t feature_save = meta_node.GetUint32("save");
         uint32_t feature_real_time = meta_node.GetUint32("real_time");
+        uint32_t feature_intern = meta_node.GetUint32("intern");
 
         // class meta
         auto pClassMeta = m_pClassMetaManager->CreateMeta(class_name);
@@ -173,6 +174,7 @@ bool AFCClassMetaModule::LoadEntityMeta(const std::string& schema_path)
         mask[(size_t)ArkDataMask::PF_SYNC_SELF] = (feature_sync_self > 0 ? 1 : 0);
         mask[(size_t)ArkDataMask::PF_SAVE] = (feature_save > 0 ? 1 : 0);
         mask[(size_t)ArkDataMask::PF_REAL_TIME] = (feature_real_time > 0 ? 1 : 0);
+        mask[(size_t)ArkDataMask::PF_INTERN] = (feature_intern > 0 ? 1 : 0);
 
         if (type_name == "container")
         {
@@ -259,7 +261,8 @@ ArkDataType AFCClassMetaModule::ConvertDataType(const std::string& type_name)
     return data_type;
 }
 
-bool AFCClassMetaModule::AddClassCallBack(const std::string& class_name, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCClassMetaModule::AddClassCallBack(
+    const std::string& class_name, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto pClassMeta = m_pClassMetaManager->FindMeta(class_name);
     ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
@@ -267,7 +270,7 @@ bool AFCClassMetaModule::AddClassCallBack(const std::string& class_name, CLASS_E
     auto pCallBack = pClassMeta->GetClassCallBackManager();
     ARK_ASSERT_RET_VAL(pCallBack != nullptr, false);
 
-    return pCallBack->AddClassCallBack(std::forward<CLASS_EVENT_FUNCTOR>(cb), prio);
+    return pCallBack->AddClassCallBack(std::forward<CLASS_EVENT_FUNCTOR>(cb), prio, owner);
 }
 
 bool AFCClassMetaModule::DoClassEvent(
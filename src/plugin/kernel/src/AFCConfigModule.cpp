@@ -28,6 +28,8 @@
 #include "kernel/include/AFCNode.hpp"
 #include "base/AFXml.hpp"
 #include "kernel/include/AFNodeManager.hpp"
+#include "base/AFDateTime.hpp"
+#include <ctpl/ctpl_stl.h>
 
 namespace ark {
 
@@ -43,9 +45,26 @@ bool AFCConfigModule::Init()
 
 bool AFCConfigModule::Shut()
 {
+    if (reload_future_.valid())
+    {
+        reload_future_.wait();
+    }
+
     return Clear();
 }
 
+bool AFCConfigModule::Update()
+{
+    // apply a finished reload at frame boundary
+    if (reload_future_.valid() && reload_future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        auto result_list = reload_future_.get();
+        ApplyReload(result_list);
+    }
+
+    return true;
+}
+
 bool AFCConfigModule::Load()
 {
     if (loaded_)
@@ -53,11 +72,53 @@ bool AFCConfigModule::Load()
         return false;
     }
 
+    const std::string& res_path = GetPluginManager()->GetResPath();
+    std::string image_path = res_path + CONFIG_IMAGE_FILE_PATH;
+
+    // load from precompiled image first, fall back to xml for missing or stale classes
+    AFConfigImage config_image;
+    config_image.Open(image_path);
+
+    bool image_dirty = !config_image.IsOpen();
+    std::vector<std::shared_ptr<AFClassMeta>> xml_class_list;
     auto& class_meta_list = m_pClassModule->GetStaticMetaList();
     for (auto iter : class_meta_list)
     {
         auto class_meta = iter.second;
-        ARK_ASSERT_RET_VAL(LoadConfig(class_meta), false);
+        if (class_meta->GetResPath().empty())
+        {
+            continue;
+        }
+
+        // hash the source once, the same info checks the image block and stamps the new image
+        AFConfigImage::SourceInfo source_info;
+        if (AFConfigImage::GetSourceInfo(res_path + class_meta->GetResPath(), source_info))
+        {
+            source_info_list_[class_meta->GetName()] = source_info;
+            if (config_image.LoadClass(class_meta, source_info, m_pStaticEntityManager))
+            {
+                continue;
+            }
+        }
+
+        xml_class_list.push_back(class_meta);
+    }
+
+    config_image.Close();
+
+    if (!xml_class_list.empty())
+    {
+        ARK_ASSERT_RET_VAL(LoadConfigParallel(xml_class_list), false);
+        image_dirty = true;
+    }
+
+    m_pStaticEntityManager->BuildIndex();
+
+    // rebuild the image for next startup
+    if (image_dirty &&
+        !AFConfigImage::Save(image_path, class_meta_list, source_info_list_, m_pStaticEntityManager))
+    {
+        ARK_LOG_WARN("Save config image failed, file = {}", image_path);
     }
 
     loaded_ = true;
@@ -76,9 +137,207 @@ bool AFCConfigModule::Clear()
     return true;
 }
 
-bool AFCConfigModule::LoadConfig(std::shared_ptr<AFClassMeta> pClassMeta)
+bool AFCConfigModule::Reload()
+{
+    ARK_ASSERT_RET_VAL(loaded_, false);
+
+    if (reload_future_.valid())
+    {
+        ARK_LOG_WARN("Config reload is still in progress");
+        return false;
+    }
+
+    const std::string& res_path = GetPluginManager()->GetResPath();
+
+    // find changed files
+    std::vector<std::pair<std::shared_ptr<AFClassMeta>, AFConfigImage::SourceInfo>> changed_list;
+    for (auto iter : m_pClassModule->GetStaticMetaList())
+    {
+        auto pClassMeta = iter.second;
+        if (pClassMeta->GetResPath().empty())
+        {
+            continue;
+        }
+
+        AFConfigImage::SourceInfo source_info;
+        if (!AFConfigImage::GetSourceInfo(res_path + pClassMeta->GetResPath(), source_info))
+        {
+            continue;
+        }
+
+        auto iter_info = source_info_list_.find(pClassMeta->GetName());
+        if (iter_info != source_info_list_.end() && iter_info->second.size_ == source_info.size_ &&
+            iter_info->second.hash_ == source_info.hash_)
+        {
+            continue;
+        }
+
+        changed_list.emplace_back(pClassMeta, source_info);
+    }
+
+    if (changed_list.empty())
+    {
+        ARK_LOG_INFO("Reload config, no file changed");
+        return true;
+    }
+
+    // parse in background, do not block the frame
+    reload_future_ = std::async(std::launch::async, [this, changed_list]() {
+        ReloadResultList result_list;
+        for (auto& changed : changed_list)
+        {
+            ReloadResult result;
+            result.class_meta_ = changed.first;
+            result.source_info_ = changed.second;
+            result.ret_ = LoadConfig(changed.first, result.rows_);
+            result_list.emplace_back(std::move(result));
+        }
+
+        return result_list;
+    });
+
+    return true;
+}
+
+bool AFCConfigModule::AddReloadCallBack(CONFIG_RELOAD_FUNCTOR&& cb)
+{
+    reload_call_backs_.emplace_back(std::forward<CONFIG_RELOAD_FUNCTOR>(cb));
+    return true;
+}
+
+void AFCConfigModule::ApplyReload(ReloadResultList& result_list)
+{
+    // swap all classes first, callbacks always see a consistent config set
+    std::vector<std::pair<std::string, std::vector<ID_TYPE>>> changed_class_list;
+    for (auto& result : result_list)
+    {
+        auto pClassMeta = result.class_meta_;
+        const std::string& class_name = pClassMeta->GetName();
+        if (!result.ret_)
+        {
+            // keep the live data, the file will be tried again on next reload
+            ARK_LOG_ERROR("Reload data config failed, class = {}", class_name);
+            continue;
+        }
+
+        std::vector<ID_TYPE> changed_id_list;
+        for (auto& row : result.rows_)
+        {
+            auto pOldEntity = std::dynamic_pointer_cast<AFCStaticEntity>(m_pStaticEntityManager->FindObject(row.first));
+            if (pOldEntity != nullptr)
+            {
+                if (pOldEntity->GetClassName() != class_name)
+                {
+                    ARK_LOG_ERROR("Reload data config, config id is used by another class, class = {} config_id = {}",
+                        class_name, row.first);
+                    continue;
+                }
+
+                if (pOldEntity->IsSameData(row.second.get()))
+                {
+                    continue;
+                }
+            }
+
+            auto pObj = m_pStaticEntityManager->ReplaceStaticEntity(pClassMeta, row.second, row.first);
+            ARK_ASSERT_CONTINUE(pObj != nullptr);
+
+            changed_id_list.push_back(row.first);
+        }
+
+        // configs removed from the file are kept, entities may still reference them by config id
+        source_info_list_[class_name] = result.source_info_;
+
+        ARK_LOG_INFO("Reload data config, class = {} changed = {}", class_name, changed_id_list.size());
+        if (!changed_id_list.empty())
+        {
+            changed_class_list.emplace_back(class_name, std::move(changed_id_list));
+        }
+    }
+
+    m_pStaticEntityManager->BuildIndex();
+
+    for (auto& changed : changed_class_list)
+    {
+        for (auto& cb : reload_call_backs_)
+        {
+            cb(changed.first, changed.second);
+        }
+    }
+
+    if (!changed_class_list.empty())
+    {
+        const std::string& res_path = GetPluginManager()->GetResPath();
+        AFConfigImage::Save(res_path + CONFIG_IMAGE_FILE_PATH, m_pClassModule->GetStaticMetaList(), source_info_list_,
+            m_pStaticEntityManager);
+    }
+}
+
+bool AFCConfigModule::LoadConfigParallel(const std::vector<std::shared_ptr<AFClassMeta>>& class_meta_list)
 {
-    ARK_ASSERT_RET_VAL(pClassMeta != nullptr, true);
+    struct LoadResult
+    {
+        bool ret_{false};
+        int64_t cost_{0};
+        ConfigRows rows_;
+    };
+
+    int thread_count = static_cast<int>(std::thread::hardware_concurrency());
+    thread_count = std::max(1, std::min(thread_count, static_cast<int>(class_meta_list.size())));
+
+    int64_t begin_time = AFDateTime::GetNowTime();
+
+    ctpl::thread_pool pool(thread_count);
+    std::vector<std::future<LoadResult>> futures;
+    futures.reserve(class_meta_list.size());
+    for (auto pClassMeta : class_meta_list)
+    {
+        futures.emplace_back(pool.push([this, pClassMeta](int) {
+            LoadResult result;
+            int64_t start_time = AFDateTime::GetNowTime();
+            result.ret_ = LoadConfig(pClassMeta, result.rows_);
+            result.cost_ = AFDateTime::GetNowTime() - start_time;
+            return result;
+        }));
+    }
+
+    // merge on main thread in class order, duplicated config id fails the same way as serial loading
+    bool ret = true;
+    for (size_t i = 0; i < futures.size(); ++i)
+    {
+        auto pClassMeta = class_meta_list[i];
+        LoadResult result = futures[i].get();
+
+        std::string file_path = GetPluginManager()->GetResPath() + pClassMeta->GetResPath();
+        if (!result.ret_)
+        {
+            ARK_LOG_ERROR("Load data config file failed, file = {}", file_path);
+            ret = false;
+            continue;
+        }
+
+        ARK_LOG_INFO("Load data config file: {} rows = {} cost = {}ms", file_path, result.rows_.size(), result.cost_);
+
+        for (auto& row : result.rows_)
+        {
+            auto pObj = m_pStaticEntityManager->CreateStaticEntity(pClassMeta, row.second, row.first);
+            if (pObj == nullptr)
+            {
+                ARK_LOG_ERROR("Create static entity failed, file = {} config_id = {}", file_path, row.first);
+                ret = false;
+            }
+        }
+    }
+
+    ARK_LOG_INFO("Load {} data config files with {} threads, cost = {}ms", class_meta_list.size(), thread_count,
+        AFDateTime::GetNowTime() - begin_time);
+
+    return ret;
+}
+
+bool AFCConfigModule::LoadConfig(std::shared_ptr<AFClassMeta> pClassMeta, ConfigRows& rows)
+{
+    ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
 
     const std::string& res_path = pClassMeta->GetResPath();
     if (res_path.empty())
@@ -88,8 +347,6 @@ bool AFCConfigModule::LoadConfig(std::shared_ptr<AFClassMeta> pClassMeta)
 
     std::string file_path = GetPluginManager()->GetResPath() + res_path;
 
-    ARK_LOG_INFO("Load data config files: {}", file_path);
-
     AFXml xml_doc(file_path);
     auto root_node = xml_doc.GetRootNode();
     ARK_ASSERT_RET_VAL(root_node.IsValid(), false);
@@ -111,8 +368,7 @@ bool AFCConfigModule::LoadConfig(std::shared_ptr<AFClassMeta> pClassMeta)
         auto pNodeManager = std::make_shared<AFNodeManager>(pClassMeta);
         ARK_ASSERT_RET_VAL(pNodeManager != nullptr, false);
 
-        auto pObj = m_pStaticEntityManager->CreateStaticEntity(pClassMeta, pNodeManager, pIDData->GetValue());
-        ARK_ASSERT_RET_VAL(pObj != nullptr, false);
+        rows.emplace_back(pIDData->GetValue(), pNodeManager);
 
         // delete id data do not need it
         ARK_DELETE(pIDData);
@@ -120,7 +376,6 @@ bool AFCConfigModule::LoadConfig(std::shared_ptr<AFClassMeta> pClassMeta)
         // read by class meta
         for (auto iter : data_meta_list)
         {
-            auto& data_name = iter.first;
             auto pDataMeta = iter.second;
             ARK_ASSERT_RET_VAL(pDataMeta != nullptr, false);
 
@@ -23,11 +23,12 @@
 namespace ark {
 
 AFCContainer::AFCContainer(std::shared_ptr<AFContainerMeta> container_meta, const AFGUID& parent_id,
-    std::shared_ptr<AFClassCallBackManager> call_back_mgr)
+    std::shared_ptr<AFClassCallBackManager> call_back_mgr, std::shared_ptr<const bool> frozen)
     : parent_(parent_id)
 {
     container_meta_ = container_meta;
     call_back_mgr_ = call_back_mgr;
+    frozen_ = frozen;
 }
 
 // get parent unique id
@@ -110,6 +111,8 @@ bool AFCContainer::Place(std::shared_ptr<AFIEntity> pEntity)
 
 bool AFCContainer::Place(uint32_t index, std::shared_ptr<AFIEntity> pEntity)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
+
     // class should be same
     if (!pEntity || !container_meta_ || pEntity->GetClassName() != container_meta_->GetClassName())
     {
@@ -135,6 +138,7 @@ bool AFCContainer::Place(uint32_t index, std::shared_ptr<AFIEntity> pEntity)
 bool AFCContainer::Swap(const uint32_t src_index, const uint32_t dest_index)
 {
     ARK_ASSERT_RET_VAL(src_index > 0u && dest_index > 0u && src_index != dest_index, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     auto iter_src = entity_data_list_.find(src_index);
     if (iter_src == entity_data_list_.end())
@@ -186,6 +190,9 @@ bool AFCContainer::Swap(
         return false;
     }
 
+    // the source container checks its own owner in Remove
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
+
     auto pSrcEntity = pSrcContainer->Find(src_index);
     if (pSrcEntity == nullptr)
     {
@@ -248,6 +255,8 @@ bool AFCContainer::Swap(
 
 bool AFCContainer::Remove(const uint32_t index)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
+
     auto pEntity = entity_data_list_.find_value(index);
     if (nullptr == pEntity)
     {
@@ -286,6 +295,11 @@ bool AFCContainer::Destroy(const AFGUID& id)
     return Destroy(index);
 }
 
+bool AFCContainer::IsFrozen() const
+{
+    return frozen_ != nullptr && *frozen_;
+}
+
 uint32_t AFCContainer::SelectIndex() const
 {
     if (entity_data_list_.size() == current_index_)
@@ -380,4 +394,9 @@ const ArkMaskType AFCContainer::GetMask() const
     return container_meta_->GetMask();
 }
 
+size_t AFCContainer::GetMemUsage() const
+{
+    return sizeof(AFCContainer) + entity_data_list_.GetMemUsage();
+}
+
 } // namespace ark
@@ -46,7 +46,9 @@ std::shared_ptr<AFIContainer> AFCContainerManager::CreateContainer(
     auto pCallBack = pClassMeta->GetClassCallBackManager();
     ARK_ASSERT_RET_VAL(pCallBack != nullptr, nullptr);
 
-    pContainer = std::make_shared<AFCContainer>(pContainerClassMeta, parent_id, pCallBack);
+    AFAllocTagScope alloc_scope(alloc_tag_);
+    pContainer = std::allocate_shared<AFCContainer>(
+        AFTagAllocator<AFCContainer>(), pContainerClassMeta, parent_id, pCallBack, frozen_);
     ARK_ASSERT_RET_VAL(pContainer != nullptr, nullptr);
 
     container_data_.insert(index, pContainer);
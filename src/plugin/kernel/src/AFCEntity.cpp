@@ -22,7 +22,7 @@
 #include "kernel/include/AFCData.hpp"
 #include "kernel/include/AFCContainer.hpp"
 #include "kernel/include/AFCStaticEntity.hpp"
-#include "kernel/include/AFCEventManager.hpp"
+#include "kernel/include/AFCustomSlotManager.hpp"
 #include "kernel/include/AFCContainerManager.hpp"
 #include "kernel/include/AFCEntity.hpp"
 
@@ -36,17 +36,18 @@ AFCEntity::AFCEntity(std::shared_ptr<AFClassMeta> pClassMeta, const AFGUID& guid
     class_meta_ = pClassMeta;
 
     // todo : create by class name
-    opt_charactor_ = std::make_shared<AFEntityOptCharactor>(map_id, map_entity_id);
+    opt_charactor_ = std::allocate_shared<AFEntityOptCharactor>(
+        AFTagAllocator<AFEntityOptCharactor>(), map_id, map_entity_id, frozen_);
 
     // data node
     auto func = std::bind(
         &AFCEntity::OnDataCallBack, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-    m_pNodeManager = std::make_shared<AFNodeManager>(pClassMeta, data_list, std::move(func));
+    m_pNodeManager =
+        std::allocate_shared<AFNodeManager>(AFTagAllocator<AFNodeManager>(), pClassMeta, data_list, std::move(func));
 
     // data table
-    m_pTableManager = std::make_shared<AFTableManager>(pClassMeta);
+    m_pTableManager = std::allocate_shared<AFTableManager>(AFTagAllocator<AFTableManager>(), pClassMeta, frozen_);
 
-    m_pEventManager = std::make_shared<AFCEventManager>(guid_);
     m_pCallBackManager = pClassMeta->GetClassCallBackManager();
 }
 
@@ -55,6 +56,16 @@ void AFCEntity::Update()
     //
 }
 
+void AFCEntity::SetFrozen(const bool value)
+{
+    *frozen_ = value;
+}
+
+bool AFCEntity::IsFrozen() const
+{
+    return *frozen_;
+}
+
 // get unique id
 const AFGUID& AFCEntity::GetID() const
 {
@@ -212,6 +223,7 @@ int32_t AFCEntity::GetMapEntityID() const
 bool AFCEntity::SwitchScene(const int32_t map_id, const int32_t map_inst_id, const AFVector3D& pos)
 {
     ARK_ASSERT_RET_VAL(m_pCallBackManager != nullptr && opt_charactor_ != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     if (opt_charactor_->map_id_ == map_id && opt_charactor_->map_entity_id_ == map_inst_id)
     {
@@ -267,6 +279,7 @@ float AFCEntity::GetOrient() const
 bool AFCEntity::SetPosition(const AFVector3D& position, const float orient)
 {
     ARK_ASSERT_RET_VAL(m_pCallBackManager != nullptr && opt_charactor_ != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     if (opt_charactor_->pos_ == position && opt_charactor_->orient_ == orient)
     {
@@ -286,6 +299,7 @@ bool AFCEntity::SetPosition(const AFVector3D& position, const float orient)
 bool AFCEntity::SetPosition(const float x, const float y, const float z, const float orient)
 {
     ARK_ASSERT_RET_VAL(m_pCallBackManager != nullptr && opt_charactor_ != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     if (opt_charactor_->pos_.x == x && opt_charactor_->pos_.y == y && opt_charactor_->pos_.z == z &&
         opt_charactor_->orient_ == orient)
@@ -309,6 +323,7 @@ bool AFCEntity::SetPosition(const float x, const float y, const float z, const f
 bool AFCEntity::SetBool(const std::string& name, bool value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetBool(name, value);
 }
@@ -316,6 +331,7 @@ bool AFCEntity::SetBool(const std::string& name, bool value)
 bool AFCEntity::SetInt32(const std::string& name, const int32_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetInt32(name, value);
 }
@@ -323,6 +339,7 @@ bool AFCEntity::SetInt32(const std::string& name, const int32_t value)
 bool AFCEntity::SetUInt32(const std::string& name, const uint32_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetUInt32(name, value);
 }
@@ -330,6 +347,7 @@ bool AFCEntity::SetUInt32(const std::string& name, const uint32_t value)
 bool AFCEntity::SetInt64(const std::string& name, const int64_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetInt64(name, value);
 }
@@ -337,6 +355,7 @@ bool AFCEntity::SetInt64(const std::string& name, const int64_t value)
 bool AFCEntity::SetUInt64(const std::string& name, const uint64_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetUInt64(name, value);
 }
@@ -344,6 +363,7 @@ bool AFCEntity::SetUInt64(const std::string& name, const uint64_t value)
 bool AFCEntity::SetFloat(const std::string& name, const float value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetFloat(name, value);
 }
@@ -351,6 +371,7 @@ bool AFCEntity::SetFloat(const std::string& name, const float value)
 bool AFCEntity::SetDouble(const std::string& name, const double value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetDouble(name, value);
 }
@@ -358,6 +379,7 @@ bool AFCEntity::SetDouble(const std::string& name, const double value)
 bool AFCEntity::SetString(const std::string& name, const std::string& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetString(name, value);
 }
@@ -365,6 +387,7 @@ bool AFCEntity::SetString(const std::string& name, const std::string& value)
 bool AFCEntity::SetWString(const std::string& name, const std::wstring& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetWString(name, value);
 }
@@ -372,6 +395,7 @@ bool AFCEntity::SetWString(const std::string& name, const std::wstring& value)
 bool AFCEntity::SetGUID(const std::string& name, const AFGUID& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetGUID(name, value);
 }
@@ -379,6 +403,7 @@ bool AFCEntity::SetGUID(const std::string& name, const AFGUID& value)
 bool AFCEntity::SetBool(const uint32_t index, bool value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetBool(index, value);
 }
@@ -386,6 +411,7 @@ bool AFCEntity::SetBool(const uint32_t index, bool value)
 bool AFCEntity::SetInt32(const uint32_t index, const int32_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetInt32(index, value);
 }
@@ -393,6 +419,7 @@ bool AFCEntity::SetInt32(const uint32_t index, const int32_t value)
 bool AFCEntity::SetUInt32(const uint32_t index, const uint32_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetUInt32(index, value);
 }
@@ -400,6 +427,7 @@ bool AFCEntity::SetUInt32(const uint32_t index, const uint32_t value)
 bool AFCEntity::SetInt64(const uint32_t index, const int64_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetInt64(index, value);
 }
@@ -407,6 +435,7 @@ bool AFCEntity::SetInt64(const uint32_t index, const int64_t value)
 bool AFCEntity::SetUInt64(const uint32_t index, const uint64_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetUInt64(index, value);
 }
@@ -414,6 +443,7 @@ bool AFCEntity::SetUInt64(const uint32_t index, const uint64_t value)
 bool AFCEntity::SetFloat(const uint32_t index, const float value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetFloat(index, value);
 }
@@ -421,6 +451,7 @@ bool AFCEntity::SetFloat(const uint32_t index, const float value)
 bool AFCEntity::SetDouble(const uint32_t index, const double value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetDouble(index, value);
 }
@@ -428,6 +459,7 @@ bool AFCEntity::SetDouble(const uint32_t index, const double value)
 bool AFCEntity::SetString(const uint32_t index, const std::string& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetString(index, value);
 }
@@ -435,6 +467,7 @@ bool AFCEntity::SetString(const uint32_t index, const std::string& value)
 bool AFCEntity::SetWString(const uint32_t index, const std::wstring& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetWString(index, value);
 }
@@ -442,6 +475,7 @@ bool AFCEntity::SetWString(const uint32_t index, const std::wstring& value)
 bool AFCEntity::SetGUID(const uint32_t index, const AFGUID& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
 
     return m_pNodeManager->SetGUID(index, value);
 }
@@ -657,11 +691,6 @@ AFITable* AFCEntity::FindTable(const uint32_t index)
     return pTable;
 }
 
-std::shared_ptr<AFIEventManager> AFCEntity::GetEventManager() const
-{
-    return m_pEventManager;
-}
-
 std::shared_ptr<AFClassMeta> AFCEntity::GetClassMeta() const
 {
     return class_meta_;
@@ -688,6 +717,7 @@ int AFCEntity::OnDataCallBack(AFINode* pNode, const AFIData& old_data, const AFI
 {
     ARK_ASSERT_RET_VAL(m_pCallBackManager != nullptr, 0);
 
+    ++data_version_;
     m_pCallBackManager->OnNodeCallBack(guid_, pNode, old_data, new_data);
 
     return 0;
@@ -698,6 +728,7 @@ int AFCEntity::OnTableCallBack(const ArkMaskType mask, AFINode* pNode, const TAB
 {
     ARK_ASSERT_RET_VAL(m_pCallBackManager != nullptr, 0);
 
+    ++data_version_;
     m_pCallBackManager->OnTableCallBack(guid_, mask, pNode, event_data, old_data, new_data);
 
     return 0;
@@ -705,6 +736,15 @@ int AFCEntity::OnTableCallBack(const ArkMaskType mask, AFINode* pNode, const TAB
 
 bool AFCEntity::AddCustomBool(const std::string& name, bool value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_BOOLEAN);
+    if (slot != AFCustomSlotManager::INVALID_SLOT)
+    {
+        ARK_ASSERT_RET_VAL(!FindCustomData(slot), false);
+        return SetCustomBool(slot, value);
+    }
+
     ARK_ASSERT_RET_VAL(custom_data_list_.find(name) == custom_data_list_.end(), false);
 
     AFIData* pData = ARK_NEW AFCData;
@@ -722,6 +762,15 @@ bool AFCEntity::AddCustomBool(const std::string& name, bool value)
 
 bool AFCEntity::AddCustomInt32(const std::string& name, const int32_t value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_INT32);
+    if (slot != AFCustomSlotManager::INVALID_SLOT)
+    {
+        ARK_ASSERT_RET_VAL(!FindCustomData(slot), false);
+        return SetCustomInt32(slot, value);
+    }
+
     ARK_ASSERT_RET_VAL(custom_data_list_.find(name) == custom_data_list_.end(), false);
 
     AFIData* pData = ARK_NEW AFCData;
@@ -739,6 +788,15 @@ bool AFCEntity::AddCustomInt32(const std::string& name, const int32_t value)
 
 bool AFCEntity::AddCustomUInt32(const std::string& name, const uint32_t value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_UINT32);
+    if (slot != AFCustomSlotManager::INVALID_SLOT)
+    {
+        ARK_ASSERT_RET_VAL(!FindCustomData(slot), false);
+        return SetCustomUInt32(slot, value);
+    }
+
     ARK_ASSERT_RET_VAL(custom_data_list_.find(name) == custom_data_list_.end(), false);
 
     AFIData* pData = ARK_NEW AFCData;
@@ -756,6 +814,15 @@ bool AFCEntity::AddCustomUInt32(const std::string& name, const uint32_t value)
 
 bool AFCEntity::AddCustomInt64(const std::string& name, const int64_t value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_INT64);
+    if (slot != AFCustomSlotManager::INVALID_SLOT)
+    {
+        ARK_ASSERT_RET_VAL(!FindCustomData(slot), false);
+        return SetCustomInt64(slot, value);
+    }
+
     ARK_ASSERT_RET_VAL(custom_data_list_.find(name) == custom_data_list_.end(), false);
 
     AFIData* pData = ARK_NEW AFCData;
@@ -773,6 +840,15 @@ bool AFCEntity::AddCustomInt64(const std::string& name, const int64_t value)
 
 bool AFCEntity::AddCustomFloat(const std::string& name, const float value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_FLOAT);
+    if (slot != AFCustomSlotManager::INVALID_SLOT)
+    {
+        ARK_ASSERT_RET_VAL(!FindCustomData(slot), false);
+        return SetCustomFloat(slot, value);
+    }
+
     ARK_ASSERT_RET_VAL(custom_data_list_.find(name) == custom_data_list_.end(), false);
 
     AFIData* pData = ARK_NEW AFCData;
@@ -790,6 +866,15 @@ bool AFCEntity::AddCustomFloat(const std::string& name, const float value)
 
 bool AFCEntity::AddCustomDouble(const std::string& name, const double value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_DOUBLE);
+    if (slot != AFCustomSlotManager::INVALID_SLOT)
+    {
+        ARK_ASSERT_RET_VAL(!FindCustomData(slot), false);
+        return SetCustomDouble(slot, value);
+    }
+
     ARK_ASSERT_RET_VAL(custom_data_list_.find(name) == custom_data_list_.end(), false);
 
     AFIData* pData = ARK_NEW AFCData;
@@ -807,6 +892,15 @@ bool AFCEntity::AddCustomDouble(const std::string& name, const double value)
 
 bool AFCEntity::AddCustomString(const std::string& name, const std::string& value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_STRING);
+    if (slot != AFCustomSlotManager::INVALID_SLOT)
+    {
+        ARK_ASSERT_RET_VAL(!FindCustomData(slot), false);
+        return SetCustomString(slot, value);
+    }
+
     ARK_ASSERT_RET_VAL(custom_data_list_.find(name) == custom_data_list_.end(), false);
 
     AFIData* pData = ARK_NEW AFCData;
@@ -834,6 +928,14 @@ bool AFCEntity::AddCustomGUID(const std::string& name, const AFGUID& value)
 
 bool AFCEntity::SetCustomBool(const std::string& name, bool value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_BOOLEAN);
+    if (FindCustomData(slot))
+    {
+        return SetCustomBool(slot, value);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, false);
 
@@ -846,6 +948,14 @@ bool AFCEntity::SetCustomBool(const std::string& name, bool value)
 
 bool AFCEntity::SetCustomInt32(const std::string& name, const int32_t value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_INT32);
+    if (FindCustomData(slot))
+    {
+        return SetCustomInt32(slot, value);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, false);
 
@@ -858,11 +968,27 @@ bool AFCEntity::SetCustomInt32(const std::string& name, const int32_t value)
 
 bool AFCEntity::SetCustomUInt32(const std::string& name, const uint32_t value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_UINT32);
+    if (FindCustomData(slot))
+    {
+        return SetCustomUInt32(slot, value);
+    }
+
     return false;
 }
 
 bool AFCEntity::SetCustomInt64(const std::string& name, const int64_t value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_INT64);
+    if (FindCustomData(slot))
+    {
+        return SetCustomInt64(slot, value);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, false);
 
@@ -875,6 +1001,14 @@ bool AFCEntity::SetCustomInt64(const std::string& name, const int64_t value)
 
 bool AFCEntity::SetCustomFloat(const std::string& name, const float value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_FLOAT);
+    if (FindCustomData(slot))
+    {
+        return SetCustomFloat(slot, value);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, false);
 
@@ -887,6 +1021,14 @@ bool AFCEntity::SetCustomFloat(const std::string& name, const float value)
 
 bool AFCEntity::SetCustomDouble(const std::string& name, const double value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_DOUBLE);
+    if (FindCustomData(slot))
+    {
+        return SetCustomDouble(slot, value);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, false);
 
@@ -899,6 +1041,14 @@ bool AFCEntity::SetCustomDouble(const std::string& name, const double value)
 
 bool AFCEntity::SetCustomString(const std::string& name, const std::string& value)
 {
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto slot = GetCustomSlot(name, ArkDataType::DT_STRING);
+    if (FindCustomData(slot))
+    {
+        return SetCustomString(slot, value);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, false);
 
@@ -921,6 +1071,12 @@ bool AFCEntity::SetCustomGUID(const std::string& name, const AFGUID& value)
 
 bool AFCEntity::GetCustomBool(const std::string& name) const
 {
+    auto slot = GetCustomSlot(name, ArkDataType::DT_BOOLEAN);
+    if (FindCustomData(slot))
+    {
+        return GetCustomBool(slot);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, false);
 
@@ -929,6 +1085,12 @@ bool AFCEntity::GetCustomBool(const std::string& name) const
 
 int32_t AFCEntity::GetCustomInt32(const std::string& name) const
 {
+    auto slot = GetCustomSlot(name, ArkDataType::DT_INT32);
+    if (FindCustomData(slot))
+    {
+        return GetCustomInt32(slot);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, NULL_INT);
 
@@ -937,6 +1099,12 @@ int32_t AFCEntity::GetCustomInt32(const std::string& name) const
 
 uint32_t AFCEntity::GetCustomUInt32(const std::string& name) const
 {
+    auto slot = GetCustomSlot(name, ArkDataType::DT_UINT32);
+    if (FindCustomData(slot))
+    {
+        return GetCustomUInt32(slot);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, NULL_INT);
 
@@ -945,6 +1113,12 @@ uint32_t AFCEntity::GetCustomUInt32(const std::string& name) const
 
 int64_t AFCEntity::GetCustomInt64(const std::string& name) const
 {
+    auto slot = GetCustomSlot(name, ArkDataType::DT_INT64);
+    if (FindCustomData(slot))
+    {
+        return GetCustomInt64(slot);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, NULL_INT);
 
@@ -953,6 +1127,12 @@ int64_t AFCEntity::GetCustomInt64(const std::string& name) const
 
 float AFCEntity::GetCustomFloat(const std::string& name) const
 {
+    auto slot = GetCustomSlot(name, ArkDataType::DT_FLOAT);
+    if (FindCustomData(slot))
+    {
+        return GetCustomFloat(slot);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, NULL_FLOAT);
 
@@ -961,6 +1141,12 @@ float AFCEntity::GetCustomFloat(const std::string& name) const
 
 double AFCEntity::GetCustomDouble(const std::string& name) const
 {
+    auto slot = GetCustomSlot(name, ArkDataType::DT_DOUBLE);
+    if (FindCustomData(slot))
+    {
+        return GetCustomDouble(slot);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, NULL_DOUBLE);
 
@@ -969,6 +1155,12 @@ double AFCEntity::GetCustomDouble(const std::string& name) const
 
 const char* AFCEntity::GetCustomString(const std::string& name) const
 {
+    auto slot = GetCustomSlot(name, ArkDataType::DT_STRING);
+    if (FindCustomData(slot))
+    {
+        return GetCustomString(slot);
+    }
+
     auto pData = custom_data_list_.find_value(name);
     ARK_ASSERT_RET_VAL(pData != nullptr, NULL_STR.c_str());
 
@@ -987,12 +1179,240 @@ const AFGUID& AFCEntity::GetCustomGUID(const std::string& name) const
 
 bool AFCEntity::FindCustomData(const std::string& name) const
 {
+    if (FindCustomData(AFCustomSlotManager::Instance().Find(name)))
+    {
+        return true;
+    }
+
     return custom_data_list_.find(name) != custom_data_list_.end();
 }
 
 bool AFCEntity::RemoveCustomData(const std::string& name)
 {
-    return custom_data_list_.erase(name);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    bool slot_removed = RemoveCustomData(AFCustomSlotManager::Instance().Find(name));
+    bool name_removed = custom_data_list_.erase(name);
+    return slot_removed || name_removed;
+}
+
+bool AFCEntity::SetCustomBool(const uint32_t slot, bool value)
+{
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto pData = PrepareCustomSlot(slot, ArkDataType::DT_BOOLEAN);
+    ARK_ASSERT_RET_VAL(pData != nullptr, false);
+
+    pData->SetBool(value);
+
+    return true;
+}
+
+bool AFCEntity::SetCustomInt32(const uint32_t slot, const int32_t value)
+{
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto pData = PrepareCustomSlot(slot, ArkDataType::DT_INT32);
+    ARK_ASSERT_RET_VAL(pData != nullptr, false);
+
+    pData->SetInt(value);
+
+    return true;
+}
+
+bool AFCEntity::SetCustomUInt32(const uint32_t slot, const uint32_t value)
+{
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto pData = PrepareCustomSlot(slot, ArkDataType::DT_UINT32);
+    ARK_ASSERT_RET_VAL(pData != nullptr, false);
+
+    pData->SetUInt(value);
+
+    return true;
+}
+
+bool AFCEntity::SetCustomInt64(const uint32_t slot, const int64_t value)
+{
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto pData = PrepareCustomSlot(slot, ArkDataType::DT_INT64);
+    ARK_ASSERT_RET_VAL(pData != nullptr, false);
+
+    pData->SetInt64(value);
+
+    return true;
+}
+
+bool AFCEntity::SetCustomFloat(const uint32_t slot, const float value)
+{
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto pData = PrepareCustomSlot(slot, ArkDataType::DT_FLOAT);
+    ARK_ASSERT_RET_VAL(pData != nullptr, false);
+
+    pData->SetFloat(value);
+
+    return true;
+}
+
+bool AFCEntity::SetCustomDouble(const uint32_t slot, const double value)
+{
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto pData = PrepareCustomSlot(slot, ArkDataType::DT_DOUBLE);
+    ARK_ASSERT_RET_VAL(pData != nullptr, false);
+
+    pData->SetDouble(value);
+
+    return true;
+}
+
+bool AFCEntity::SetCustomString(const uint32_t slot, const std::string& value)
+{
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    auto pData = PrepareCustomSlot(slot, ArkDataType::DT_STRING);
+    ARK_ASSERT_RET_VAL(pData != nullptr, false);
+
+    pData->SetString(value.c_str());
+
+    return true;
+}
+
+bool AFCEntity::GetCustomBool(const uint32_t slot) const
+{
+    auto pData = FindCustomSlot(slot);
+    if (pData == nullptr || pData->GetType() != ArkDataType::DT_BOOLEAN)
+    {
+        return NULL_BOOLEAN;
+    }
+
+    return pData->GetBool();
+}
+
+int32_t AFCEntity::GetCustomInt32(const uint32_t slot) const
+{
+    auto pData = FindCustomSlot(slot);
+    if (pData == nullptr || pData->GetType() != ArkDataType::DT_INT32)
+    {
+        return NULL_INT;
+    }
+
+    return pData->GetInt();
+}
+
+uint32_t AFCEntity::GetCustomUInt32(const uint32_t slot) const
+{
+    auto pData = FindCustomSlot(slot);
+    if (pData == nullptr || pData->GetType() != ArkDataType::DT_UINT32)
+    {
+        return NULL_INT;
+    }
+
+    return pData->GetUInt();
+}
+
+int64_t AFCEntity::GetCustomInt64(const uint32_t slot) const
+{
+    auto pData = FindCustomSlot(slot);
+    if (pData == nullptr || pData->GetType() != ArkDataType::DT_INT64)
+    {
+        return NULL_INT64;
+    }
+
+    return pData->GetInt64();
+}
+
+float AFCEntity::GetCustomFloat(const uint32_t slot) const
+{
+    auto pData = FindCustomSlot(slot);
+    if (pData == nullptr || pData->GetType() != ArkDataType::DT_FLOAT)
+    {
+        return NULL_FLOAT;
+    }
+
+    return pData->GetFloat();
+}
+
+double AFCEntity::GetCustomDouble(const uint32_t slot) const
+{
+    auto pData = FindCustomSlot(slot);
+    if (pData == nullptr || pData->GetType() != ArkDataType::DT_DOUBLE)
+    {
+        return NULL_DOUBLE;
+    }
+
+    return pData->GetDouble();
+}
+
+const char* AFCEntity::GetCustomString(const uint32_t slot) const
+{
+    auto pData = FindCustomSlot(slot);
+    if (pData == nullptr || pData->GetType() != ArkDataType::DT_STRING)
+    {
+        return NULL_STR.c_str();
+    }
+
+    return pData->GetString();
+}
+
+bool AFCEntity::FindCustomData(const uint32_t slot) const
+{
+    return FindCustomSlot(slot) != nullptr;
+}
+
+bool AFCEntity::RemoveCustomData(const uint32_t slot)
+{
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!*frozen_, false);
+
+    if (FindCustomSlot(slot) == nullptr)
+    {
+        return false;
+    }
+
+    // swap out to release the value, AFCData can not be assigned an empty value
+    AFCData empty_data;
+    custom_slot_list_[slot].Swap(empty_data);
+    return true;
+}
+
+const AFIData* AFCEntity::FindCustomSlot(const uint32_t slot) const
+{
+    if (slot >= custom_slot_list_.size())
+    {
+        return nullptr;
+    }
+
+    const AFIData* pData = &custom_slot_list_[slot];
+    return (pData->GetType() != ArkDataType::DT_EMPTY) ? pData : nullptr;
+}
+
+uint32_t AFCEntity::GetCustomSlot(const std::string& name, const ArkDataType type) const
+{
+    auto& slot_manager = AFCustomSlotManager::Instance();
+    auto slot = slot_manager.Find(name);
+    return (slot_manager.GetType(slot) == type) ? slot : AFCustomSlotManager::INVALID_SLOT;
+}
+
+AFIData* AFCEntity::PrepareCustomSlot(const uint32_t slot, const ArkDataType type)
+{
+    auto& slot_manager = AFCustomSlotManager::Instance();
+    ARK_ASSERT_RET_VAL(slot_manager.GetType(slot) == type, nullptr);
+
+    if (slot >= custom_slot_list_.size())
+    {
+        // grow to the slot only, move values by swap as AFCData copy asserts on empty value
+        CustomSlotList new_list(slot + 1);
+        for (size_t i = 0; i < custom_slot_list_.size(); ++i)
+        {
+            new_list[i].Swap(custom_slot_list_[i]);
+        }
+
+        custom_slot_list_.swap(new_list);
+    }
+
+    return &custom_slot_list_[slot];
 }
 
 bool AFCEntity::IsSent() const
@@ -1005,4 +1425,53 @@ void AFCEntity::UpdateSent()
     sent_ = true;
 }
 
+uint32_t AFCEntity::GetDataVersion() const
+{
+    return data_version_;
+}
+
+size_t AFCEntity::GetMemUsage() const
+{
+    size_t size = sizeof(AFCEntity);
+
+    if (m_pNodeManager != nullptr)
+    {
+        size += m_pNodeManager->GetMemUsage();
+    }
+
+    if (m_pTableManager != nullptr)
+    {
+        for (auto& iter : m_pTableManager->GetTableList())
+        {
+            size += iter.second->GetMemUsage();
+        }
+    }
+
+    if (opt_charactor_ != nullptr)
+    {
+        size += sizeof(AFEntityOptCharactor);
+
+        for (auto& iter : opt_charactor_->m_pContainerManager->GetContainerList())
+        {
+            size += iter.second->GetMemUsage();
+        }
+    }
+
+    // custom data, heap part is counted by AFCData itself
+    for (auto& data : custom_slot_list_)
+    {
+        size += data.GetMemUsage();
+    }
+
+    size += (custom_slot_list_.capacity() - custom_slot_list_.size()) * sizeof(AFCData);
+
+    size += custom_data_list_.GetMemUsage();
+    for (auto& iter : custom_data_list_)
+    {
+        size += iter.second->GetMemUsage();
+    }
+
+    return size;
+}
+
 } // namespace ark
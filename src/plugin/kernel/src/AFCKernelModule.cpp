@@ -24,7 +24,11 @@
 #include "log/interface/AFILogModule.hpp"
 #include "kernel/include/AFCTable.hpp"
 #include "kernel/include/AFCDataList.hpp"
+#include "kernel/include/AFDataListView.hpp"
+#include "kernel/include/AFCustomSlotManager.hpp"
 #include "kernel/include/AFCContainer.hpp"
+#include "kernel/include/AFCEventManager.hpp"
+#include "base/AFMailbox.hpp"
 
 namespace ark {
 
@@ -53,13 +57,21 @@ bool AFCKernelModule::Init()
 
     auto container_func = std::bind(&AFCKernelModule::OnContainerCallBack, this, std::placeholders::_1,
         std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5);
-    AddCommonContainerCallBack(std::move(container_func), 999999); // after other callbacks being done
+    AddCommonContainerCallBack(std::move(container_func), 999999, GetName()); // after other callbacks being done
 
     AddSyncCallBack();
 
     return true;
 }
 
+bool AFCKernelModule::PreUpdate()
+{
+    // all modules registered their custom slots in Init or PostInit, lookups are lock free from now on
+    AFCustomSlotManager::Instance().Seal();
+
+    return true;
+}
+
 bool AFCKernelModule::Update()
 {
     cur_exec_object_ = NULL_GUID;
@@ -85,8 +97,23 @@ bool AFCKernelModule::Update()
         pEntity->Update();
     }
 
+    if (m_pEventManager != nullptr)
+    {
+        m_pEventManager->Update();
+    }
+
     AFClassCallBackManager::OnDelaySync();
 
+    if (profile_dump_interval_ > 0 && AFClassCallBackManager::IsProfileEnable())
+    {
+        auto now = GetPluginManager()->GetNowTime();
+        if (now >= last_profile_dump_time_ + profile_dump_interval_)
+        {
+            last_profile_dump_time_ = now;
+            DumpCallBackProfile();
+        }
+    }
+
     return true;
 }
 
@@ -95,6 +122,14 @@ bool AFCKernelModule::PreShut()
     return DestroyAll();
 }
 
+std::shared_ptr<AFCEntity> AFCKernelModule::NewEntity(std::shared_ptr<AFClassMeta> pClassMeta, const AFGUID& guid,
+    const ID_TYPE config_id, const int32_t map_id, const int32_t map_entity_id, const AFIDataList& data_list)
+{
+    AFAllocTagScope alloc_scope(pClassMeta->GetAllocTag());
+    return std::allocate_shared<AFCEntity>(
+        AFTagAllocator<AFCEntity>(), pClassMeta, guid, config_id, map_id, map_entity_id, data_list);
+}
+
 bool AFCKernelModule::CopyData(std::shared_ptr<AFIEntity> pEntity, std::shared_ptr<AFIStaticEntity> pStaticEntity)
 {
     if (pEntity == nullptr || nullptr == pStaticEntity)
@@ -102,9 +137,8 @@ bool AFCKernelModule::CopyData(std::shared_ptr<AFIEntity> pEntity, std::shared_p
         return false;
     }
 
-    // static node manager must be not empty
-    auto pStaticNodeManager = GetNodeManager(pStaticEntity);
-    if (pStaticNodeManager == nullptr || pStaticNodeManager->IsEmpty())
+    auto pCStaticEntity = std::dynamic_pointer_cast<AFCStaticEntity>(pStaticEntity);
+    if (pCStaticEntity == nullptr)
     {
         return false;
     }
@@ -117,19 +151,15 @@ bool AFCKernelModule::CopyData(std::shared_ptr<AFIEntity> pEntity, std::shared_p
     }
 
     // copy data
-    auto& data_list = pStaticNodeManager->GetDataList();
-    for (auto& iter : data_list)
-    {
-        auto pData = iter.second;
-        pNodeManager->CreateData(pData);
-    }
-
-    return true;
+    return pCStaticEntity->CopyTo(pNodeManager.get());
 }
 
 std::shared_ptr<AFIEntity> AFCKernelModule::CreateEntity(const AFGUID& self, const int map_id,
     const int map_instance_id, const std::string& class_name, const ID_TYPE config_id, const AFIDataList& args)
 {
+    // entities belong to the main loop, mailboxes post to it
+    ARK_ASSERT_RET_VAL(AFMailbox::Current() == nullptr, nullptr);
+
     AFGUID object_id = self;
 
     auto pMapInfo = m_pMapModule->GetMapInfo(map_id);
@@ -189,8 +219,7 @@ std::shared_ptr<AFIEntity> AFCKernelModule::CreateEntity(const AFGUID& self, con
         return nullptr;
     }
 
-    std::shared_ptr<AFIEntity> pEntity =
-        std::make_shared<AFCEntity>(pClassMeta, object_id, config_id, map_id, map_instance_id, args);
+    std::shared_ptr<AFIEntity> pEntity = NewEntity(pClassMeta, object_id, config_id, map_id, map_instance_id, args);
 
     objects_.insert(object_id, pEntity);
 
@@ -283,7 +312,7 @@ std::shared_ptr<AFIEntity> AFCKernelModule::CreateContainerEntity(
     }
 
     std::shared_ptr<AFIEntity> pContainerEntity =
-        std::make_shared<AFCEntity>(pClassMeta, object_id, config_id, map_id, map_instance_id, AFCDataList());
+        NewEntity(pClassMeta, object_id, config_id, map_id, map_instance_id, AFCDataList());
 
     objects_.insert(object_id, pContainerEntity);
 
@@ -291,7 +320,7 @@ std::shared_ptr<AFIEntity> AFCKernelModule::CreateContainerEntity(
 
     pContainer->Place(pContainerEntity);
 
-    AFCDataList args;
+    AFDataListView args;
     DoEvent(object_id, class_name, ArkEntityEvent::ENTITY_EVT_PRE_LOAD_DATA, args);
 
     DoEvent(object_id, class_name, ArkEntityEvent::ENTITY_EVT_LOAD_DATA, args);
@@ -308,6 +337,17 @@ std::shared_ptr<AFIStaticEntity> AFCKernelModule::GetStaticEntity(const ID_TYPE
     return m_pConfigModule->FindStaticEntity(config_id);
 }
 
+uint32_t AFCKernelModule::RegisterCustomData(const std::string& name, const ArkDataType type)
+{
+    auto slot = AFCustomSlotManager::Instance().Register(name, type);
+    if (slot == AFCustomSlotManager::INVALID_SLOT)
+    {
+        ARK_LOG_ERROR("Register custom data failed, name = {} type = {}", name, static_cast<uint32_t>(type));
+    }
+
+    return slot;
+}
+
 std::shared_ptr<AFIEntity> AFCKernelModule::GetEntity(const AFGUID& self)
 {
     return objects_.find_value(self);
@@ -334,6 +374,8 @@ bool AFCKernelModule::DestroyAll()
 
 bool AFCKernelModule::DestroyEntity(const AFGUID& self)
 {
+    ARK_ASSERT_RET_VAL(AFMailbox::Current() == nullptr, false);
+
     if (self == cur_exec_object_ && self != NULL_GUID)
     {
         return DestroySelf(self);
@@ -384,8 +426,13 @@ bool AFCKernelModule::InnerDestroyEntity(std::shared_ptr<AFIEntity> pEntity)
         pMapInfo->RemoveEntityFromInstance(
             inst_id, self, ((class_name == AFEntityMetaPlayer::self_name()) ? true : false));
 
-        DoEvent(self, class_name, ArkEntityEvent::ENTITY_EVT_PRE_DESTROY, AFCDataList());
-        DoEvent(self, class_name, ArkEntityEvent::ENTITY_EVT_DESTROY, AFCDataList());
+        DoEvent(self, class_name, ArkEntityEvent::ENTITY_EVT_PRE_DESTROY, AFDataListView());
+        DoEvent(self, class_name, ArkEntityEvent::ENTITY_EVT_DESTROY, AFDataListView());
+
+        if (m_pEventManager != nullptr)
+        {
+            m_pEventManager->Clear(self);
+        }
 
         return objects_.erase(self);
     }
@@ -398,22 +445,19 @@ bool AFCKernelModule::InnerDestroyEntity(std::shared_ptr<AFIEntity> pEntity)
 
 bool AFCKernelModule::AddEventCallBack(const AFGUID& self, const int nEventID, EVENT_PROCESS_FUNCTOR&& cb)
 {
-    std::shared_ptr<AFIEntity> pEntity = GetEntity(self);
-    ARK_ASSERT_RET_VAL(pEntity != nullptr, false);
+    ARK_ASSERT_RET_VAL(Exist(self), false);
 
-    auto pEventManager = GetEventManager(pEntity);
-    ARK_ASSERT_RET_VAL(pEventManager != nullptr, false);
-
-    return pEventManager->AddEventCallBack(nEventID, std::forward<EVENT_PROCESS_FUNCTOR>(cb));
+    return GetEventManager()->AddEventCallBack(self, nEventID, std::forward<EVENT_PROCESS_FUNCTOR>(cb));
 }
 
-bool AFCKernelModule::AddClassCallBack(const std::string& class_name, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddClassCallBack(
+    const std::string& class_name, CLASS_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
-    return m_pClassModule->AddClassCallBack(class_name, std::forward<CLASS_EVENT_FUNCTOR>(cb), prio);
+    return m_pClassModule->AddClassCallBack(class_name, std::forward<CLASS_EVENT_FUNCTOR>(cb), prio, owner);
 }
 
-bool AFCKernelModule::AddNodeCallBack(
-    const std::string& class_name, const std::string& name, DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddNodeCallBack(const std::string& class_name, const std::string& name,
+    DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto pClassMeta = m_pClassModule->FindMeta(class_name);
     ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
@@ -424,13 +468,13 @@ bool AFCKernelModule::AddNodeCallBack(
         return false;
     }
 
-    AddNodeCallBack(class_name, index, std::forward<DATA_NODE_EVENT_FUNCTOR>(cb), prio);
+    AddNodeCallBack(class_name, index, std::forward<DATA_NODE_EVENT_FUNCTOR>(cb), prio, owner);
 
     return true;
 }
 
-bool AFCKernelModule::AddTableCallBack(
-    const std::string& class_name, const std::string& name, DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddTableCallBack(const std::string& class_name, const std::string& name,
+    DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto pClassMeta = m_pClassModule->FindMeta(class_name);
     ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
@@ -441,13 +485,13 @@ bool AFCKernelModule::AddTableCallBack(
         return false;
     }
 
-    AddTableCallBack(class_name, index, std::forward<DATA_TABLE_EVENT_FUNCTOR>(cb), prio);
+    AddTableCallBack(class_name, index, std::forward<DATA_TABLE_EVENT_FUNCTOR>(cb), prio, owner);
 
     return true;
 }
 
-bool AFCKernelModule::AddNodeCallBack(
-    const std::string& class_name, const uint32_t index, DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddNodeCallBack(const std::string& class_name, const uint32_t index,
+    DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto pClassMeta = m_pClassModule->FindMeta(class_name);
     ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
@@ -458,13 +502,13 @@ bool AFCKernelModule::AddNodeCallBack(
     auto pCallBack = pClassMeta->GetClassCallBackManager();
     ARK_ASSERT_RET_VAL(pCallBack != nullptr, false);
 
-    pCallBack->AddDataCallBack(index, std::forward<DATA_NODE_EVENT_FUNCTOR>(cb), prio);
+    pCallBack->AddDataCallBack(index, std::forward<DATA_NODE_EVENT_FUNCTOR>(cb), prio, owner);
 
     return true;
 }
 
-bool AFCKernelModule::AddTableCallBack(
-    const std::string& class_name, const uint32_t index, DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddTableCallBack(const std::string& class_name, const uint32_t index,
+    DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto pClassMeta = m_pClassModule->FindMeta(class_name);
     ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
@@ -475,13 +519,13 @@ bool AFCKernelModule::AddTableCallBack(
     auto pCallBack = pClassMeta->GetClassCallBackManager();
     ARK_ASSERT_RET_VAL(pCallBack != nullptr, false);
 
-    pCallBack->AddTableCallBack(index, std::forward<DATA_TABLE_EVENT_FUNCTOR>(cb), prio);
+    pCallBack->AddTableCallBack(index, std::forward<DATA_TABLE_EVENT_FUNCTOR>(cb), prio, owner);
 
     return true;
 }
 
-bool AFCKernelModule::AddContainerCallBack(
-    const std::string& class_name, const uint32_t index, CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddContainerCallBack(const std::string& class_name, const uint32_t index,
+    CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto pClassMeta = m_pClassModule->FindMeta(class_name);
     ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
@@ -492,12 +536,13 @@ bool AFCKernelModule::AddContainerCallBack(
     auto pCallBack = pClassMeta->GetClassCallBackManager();
     ARK_ASSERT_RET_VAL(pCallBack != nullptr, false);
 
-    pCallBack->AddContainerCallBack(index, std::forward<CONTAINER_EVENT_FUNCTOR>(cb), prio);
+    pCallBack->AddContainerCallBack(index, std::forward<CONTAINER_EVENT_FUNCTOR>(cb), prio, owner);
 
     return true;
 }
 
-bool AFCKernelModule::AddCommonContainerCallBack(CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddCommonContainerCallBack(
+    CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto pClassMeta = m_pClassModule->FindMeta(AFEntityMetaPlayer::self_name());
     ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
@@ -511,14 +556,14 @@ bool AFCKernelModule::AddCommonContainerCallBack(CONTAINER_EVENT_FUNCTOR&& cb, c
             continue;
         }
 
-        AddContainerCallBack(
-            AFEntityMetaPlayer::self_name(), pMeta->GetIndex(), std::forward<CONTAINER_EVENT_FUNCTOR>(cb), prio);
+        AddContainerCallBack(AFEntityMetaPlayer::self_name(), pMeta->GetIndex(),
+            std::forward<CONTAINER_EVENT_FUNCTOR>(cb), prio, owner);
     }
 
     return true;
 }
 
-bool AFCKernelModule::AddCommonClassEvent(CLASS_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddCommonClassEvent(CLASS_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto& class_meta_list = m_pClassModule->GetMetaList();
     for (auto& iter : class_meta_list)
@@ -529,13 +574,14 @@ bool AFCKernelModule::AddCommonClassEvent(CLASS_EVENT_FUNCTOR&& cb, const int32_
             continue;
         }
 
-        AddClassCallBack(iter.first, std::forward<CLASS_EVENT_FUNCTOR>(cb), prio);
+        AddClassCallBack(iter.first, std::forward<CLASS_EVENT_FUNCTOR>(cb), prio, owner);
     }
 
     return true;
 }
 
-bool AFCKernelModule::AddLeaveSceneEvent(const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddLeaveSceneEvent(
+    const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto pClassMeta = m_pClassModule->FindMeta(class_name);
     ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
@@ -543,10 +589,11 @@ bool AFCKernelModule::AddLeaveSceneEvent(const std::string& class_name, SCENE_EV
     auto pCallBack = pClassMeta->GetClassCallBackManager();
     ARK_ASSERT_RET_VAL(pCallBack != nullptr, false);
 
-    return pCallBack->AddLeaveSceneEvent(std::forward<SCENE_EVENT_FUNCTOR>(cb), prio);
+    return pCallBack->AddLeaveSceneEvent(std::forward<SCENE_EVENT_FUNCTOR>(cb), prio, owner);
 }
 
-bool AFCKernelModule::AddEnterSceneEvent(const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddEnterSceneEvent(
+    const std::string& class_name, SCENE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto pClassMeta = m_pClassModule->FindMeta(class_name);
     ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
@@ -554,10 +601,11 @@ bool AFCKernelModule::AddEnterSceneEvent(const std::string& class_name, SCENE_EV
     auto pCallBack = pClassMeta->GetClassCallBackManager();
     ARK_ASSERT_RET_VAL(pCallBack != nullptr, false);
 
-    return pCallBack->AddEnterSceneEvent(std::forward<SCENE_EVENT_FUNCTOR>(cb), prio);
+    return pCallBack->AddEnterSceneEvent(std::forward<SCENE_EVENT_FUNCTOR>(cb), prio, owner);
 }
 
-bool AFCKernelModule::AddMoveEvent(const std::string& class_name, MOVE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFCKernelModule::AddMoveEvent(
+    const std::string& class_name, MOVE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
     auto pClassMeta = m_pClassModule->FindMeta(class_name);
     ARK_ASSERT_RET_VAL(pClassMeta != nullptr, false);
@@ -565,7 +613,7 @@ bool AFCKernelModule::AddMoveEvent(const std::string& class_name, MOVE_EVENT_FUN
     auto pCallBack = pClassMeta->GetClassCallBackManager();
     ARK_ASSERT_RET_VAL(pCallBack != nullptr, false);
 
-    return pCallBack->AddMoveEvent(std::forward<MOVE_EVENT_FUNCTOR>(cb), prio);
+    return pCallBack->AddMoveEvent(std::forward<MOVE_EVENT_FUNCTOR>(cb), prio, owner);
 }
 
 void AFCKernelModule::AddSyncCallBack()
@@ -1177,7 +1225,7 @@ int AFCKernelModule::SendToView(const AFGUID& self, const google::protobuf::Mess
     auto map_id = pEntity->GetMapID();
     auto inst_id = pEntity->GetMapEntityID();
 
-    AFCDataList map_inst_entity_list;
+    AFCEntityList map_inst_entity_list;
     m_pMapModule->GetInstEntityList(map_id, inst_id, map_inst_entity_list);
 
     for (size_t i = 0; i < map_inst_entity_list.GetCount(); i++)
@@ -1212,13 +1260,31 @@ bool AFCKernelModule::DoEvent(
 
 bool AFCKernelModule::DoEvent(const AFGUID& self, const int event_id, const AFIDataList& args)
 {
-    std::shared_ptr<AFIEntity> pEntity = GetEntity(self);
-    ARK_ASSERT_RET_VAL(pEntity != nullptr, false);
+    ARK_ASSERT_RET_VAL(Exist(self), false);
+
+    if (m_pEventManager == nullptr)
+    {
+        return false;
+    }
+
+    return m_pEventManager->DoEvent(self, event_id, args);
+}
+
+bool AFCKernelModule::PostEvent(const AFGUID& self, const int event_id, const AFIDataList& args)
+{
+    ARK_ASSERT_RET_VAL(Exist(self), false);
 
-    auto pEventManager = GetEventManager(pEntity);
-    ARK_ASSERT_RET_VAL(pEventManager != nullptr, false);
+    return GetEventManager()->PostEvent(self, event_id, args);
+}
+
+std::shared_ptr<AFIEventManager> AFCKernelModule::GetEventManager()
+{
+    if (m_pEventManager == nullptr)
+    {
+        m_pEventManager = std::make_shared<AFCEventManager>();
+    }
 
-    return pEventManager->DoEvent(event_id, args);
+    return m_pEventManager;
 }
 
 bool AFCKernelModule::Exist(const AFGUID& self)
@@ -1292,6 +1358,183 @@ int AFCKernelModule::LogObjectData(const AFGUID& guid)
     return 0;
 }
 
+bool AFCKernelModule::GetMemoryReport(AFMemoryReport& report, const size_t top_count)
+{
+    for (auto& iter : objects_)
+    {
+        auto pEntity = iter.second;
+        if (pEntity == nullptr)
+        {
+            continue;
+        }
+
+        const std::string& class_name = pEntity->GetClassName();
+        const uint64_t bytes = pEntity->GetMemUsage();
+
+        auto& class_stat = report.class_stats_[class_name];
+        ++class_stat.count_;
+        class_stat.bytes_ += bytes;
+
+        report.top_entities_.emplace_back(pEntity->GetID(), bytes);
+
+        auto pTableManager = GetTableManager(pEntity);
+        if (pTableManager != nullptr)
+        {
+            for (auto& iter_table : pTableManager->GetTableList())
+            {
+                auto pTable = iter_table.second;
+                if (pTable == nullptr)
+                {
+                    continue;
+                }
+
+                auto& table_stat = report.table_stats_[class_name + "." + pTable->GetName()];
+                table_stat.count_ += pTable->GetRowCount();
+                table_stat.bytes_ += pTable->GetMemUsage();
+            }
+        }
+
+        auto pContainerManager = GetContainerManager(pEntity);
+        if (pContainerManager != nullptr)
+        {
+            for (auto& iter_container : pContainerManager->GetContainerList())
+            {
+                auto pContainer = iter_container.second;
+                if (pContainer == nullptr)
+                {
+                    continue;
+                }
+
+                auto& container_stat = report.container_stats_[class_name + "." + pContainer->GetName()];
+                container_stat.bytes_ += pContainer->GetMemUsage();
+                for (auto index = pContainer->First(); index != NULL_INT; index = pContainer->Next())
+                {
+                    ++container_stat.count_;
+                }
+            }
+        }
+    }
+
+    auto func = [](const AFMemoryReport::EntityStat& lhs, const AFMemoryReport::EntityStat& rhs) {
+        return lhs.second > rhs.second;
+    };
+
+    auto& top_entities = report.top_entities_;
+    const size_t count = std::min(top_count, top_entities.size());
+    std::partial_sort(top_entities.begin(), top_entities.begin() + count, top_entities.end(), func);
+    top_entities.resize(count);
+
+    auto& counter = AFAllocCounter::Instance();
+    report.alloc_stat_.count_ = counter.GetLiveCount();
+    report.alloc_stat_.bytes_ = counter.GetLiveBytes();
+    report.total_alloc_count_ = counter.GetAllocCount();
+
+    std::map<std::string, AFAllocCounter::TagStat> tag_stats;
+    counter.GetTagStats(tag_stats);
+    for (auto& iter : tag_stats)
+    {
+        auto& alloc_class_stat = report.alloc_class_stats_[iter.first];
+        alloc_class_stat.count_ = iter.second.live_count_;
+        alloc_class_stat.bytes_ = iter.second.live_bytes_;
+    }
+
+    return true;
+}
+
+bool AFCKernelModule::DumpMemoryReport(const std::string& file_path, const size_t top_count)
+{
+    AFMemoryReport report;
+    if (!GetMemoryReport(report, top_count))
+    {
+        return false;
+    }
+
+    std::ofstream file(file_path, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        ARK_LOG_ERROR("open memory report file failed, file = {}", file_path);
+        return false;
+    }
+
+    file << report.ToString();
+    file.close();
+
+    ARK_LOG_INFO("dump memory report, file = {} entity count = {} alloc bytes = {}", file_path, objects_.size(),
+        report.alloc_stat_.bytes_);
+    return true;
+}
+
+void AFCKernelModule::SetCallBackProfile(const bool enable, const int64_t dump_interval)
+{
+    AFClassCallBackManager::SetProfileEnable(enable);
+    profile_dump_interval_ = dump_interval;
+    last_profile_dump_time_ = GetPluginManager()->GetNowTime();
+
+    if (!enable)
+    {
+        return;
+    }
+
+    // start a new sample
+    for (auto& iter : m_pClassModule->GetMetaList())
+    {
+        auto pClassMeta = iter.second;
+        if (pClassMeta == nullptr || pClassMeta->GetClassCallBackManager() == nullptr)
+        {
+            continue;
+        }
+
+        pClassMeta->GetClassCallBackManager()->ResetStat();
+    }
+}
+
+bool AFCKernelModule::GetCallBackProfile(std::vector<AFCallBackStat>& stat_list)
+{
+    for (auto& iter : m_pClassModule->GetMetaList())
+    {
+        auto pClassMeta = iter.second;
+        if (pClassMeta == nullptr)
+        {
+            continue;
+        }
+
+        auto pCallBack = pClassMeta->GetClassCallBackManager();
+        if (pCallBack == nullptr)
+        {
+            continue;
+        }
+
+        for (auto& stat : pCallBack->GetStatList())
+        {
+            if (stat.count_ == 0)
+            {
+                continue;
+            }
+
+            stat_list.push_back(stat);
+        }
+    }
+
+    std::sort(stat_list.begin(), stat_list.end(),
+        [](const AFCallBackStat& lhs, const AFCallBackStat& rhs) { return lhs.total_ns_ > rhs.total_ns_; });
+
+    return true;
+}
+
+void AFCKernelModule::DumpCallBackProfile()
+{
+    std::vector<AFCallBackStat> stat_list;
+    GetCallBackProfile(stat_list);
+
+    ARK_LOG_INFO("call back profile, count = {}", stat_list.size());
+    for (auto& stat : stat_list)
+    {
+        ARK_LOG_INFO("class = {} type = {} index = {} owner = {} count = {} total_us = {} avg_us = {} max_us = {}",
+            stat.class_name_, stat.type_, stat.index_, stat.owner_, stat.count_, stat.total_ns_ / 1000,
+            stat.total_ns_ / stat.count_ / 1000, stat.max_ns_ / 1000);
+    }
+}
+
 bool AFCKernelModule::LogInfo(const AFGUID& id)
 {
     std::shared_ptr<AFIEntity> pEntity = GetEntity(id);
@@ -1306,7 +1549,7 @@ bool AFCKernelModule::LogInfo(const AFGUID& id)
         int map_id = pEntity->GetMapID();
 
         ARK_LOG_INFO("----------child object list-------- , id = {} mapid = {}", id, map_id);
-        AFCDataList entity_list;
+        AFCEntityList entity_list;
         int online_count = m_pMapModule->GetMapOnlineList(map_id, entity_list);
         for (int i = 0; i < online_count; ++i)
         {
@@ -1455,7 +1698,7 @@ std::shared_ptr<AFIEntity> AFCKernelModule::CreateEntity(const AFMsg::pb_db_enti
         return nullptr;
     }
 
-    auto pCEntity = std::make_shared<AFCEntity>(pClassMeta, entity_id, NULL_INT, map_id, map_inst_id, AFCDataList());
+    auto pCEntity = NewEntity(pClassMeta, entity_id, pb_data.config_id(), map_id, map_inst_id, AFCDataList());
     pEntity = std::static_pointer_cast<AFIEntity>(pCEntity);
 
     objects_.insert(entity_id, pEntity);
@@ -1495,7 +1738,7 @@ std::shared_ptr<AFIEntity> AFCKernelModule::CreateEntity(const AFMsg::pb_db_enti
     }
 
     // todo : add new event?
-    AFCDataList args;
+    AFDataListView args;
     DoEvent(entity_id, class_name, ArkEntityEvent::ENTITY_EVT_PRE_LOAD_DATA, args);
 
     DoEvent(entity_id, class_name, ArkEntityEvent::ENTITY_EVT_LOAD_DATA, args);
@@ -2110,22 +2353,6 @@ bool AFCKernelModule::EntityTableToPBData(
 }
 
 // -----------get entity manager--------------
-std::shared_ptr<AFNodeManager> AFCKernelModule::GetNodeManager(std::shared_ptr<AFIStaticEntity> pStaticEntity) const
-{
-    if (pStaticEntity == nullptr)
-    {
-        return nullptr;
-    }
-
-    auto pCStaticEntity = std::dynamic_pointer_cast<AFCStaticEntity>(pStaticEntity);
-    if (pCStaticEntity == nullptr)
-    {
-        return nullptr;
-    }
-
-    return pCStaticEntity->GetNodeManager();
-}
-
 std::shared_ptr<AFNodeManager> AFCKernelModule::GetNodeManager(std::shared_ptr<AFIEntity> pEntity) const
 {
     if (pEntity == nullptr)
@@ -2190,20 +2417,4 @@ std::shared_ptr<AFIContainerManager> AFCKernelModule::GetContainerManager(std::s
     return pCEnity->GetContainerManager();
 }
 
-std::shared_ptr<AFIEventManager> AFCKernelModule::GetEventManager(std::shared_ptr<AFIEntity> pEntity) const
-{
-    if (pEntity == nullptr)
-    {
-        return nullptr;
-    }
-
-    auto pCEnity = std::dynamic_pointer_cast<AFCEntity>(pEntity);
-    if (pCEnity == nullptr)
-    {
-        return nullptr;
-    }
-
-    return pCEnity->GetEventManager();
-}
-
 } // namespace ark
@@ -34,6 +34,22 @@ bool AFCMapModule::Init()
     return true;
 }
 
+bool AFCMapModule::Update()
+{
+    std::vector<SCHEDULER_FUNCTOR> messages;
+    {
+        std::lock_guard<std::mutex> guard(main_message_mutex_);
+        messages.swap(main_messages_);
+    }
+
+    for (auto& func : messages)
+    {
+        func();
+    }
+
+    return true;
+}
+
 bool AFCMapModule::Shut()
 {
     map_infos_.clear();
@@ -271,7 +287,7 @@ bool AFCMapModule::ReleaseMapInstance(const int map_id, const int inst_id)
         return false;
     }
 
-    AFCDataList listObject;
+    AFCEntityList listObject;
 
     if (GetInstEntityList(map_id, inst_id, listObject))
     {
@@ -303,6 +319,12 @@ bool AFCMapModule::ExitMapInstance(const int map_id, const int inst_id)
     return (pMapInstance != nullptr);
 }
 
+void AFCMapModule::PostMainMessage(SCHEDULER_FUNCTOR&& func)
+{
+    std::lock_guard<std::mutex> guard(main_message_mutex_);
+    main_messages_.emplace_back(std::forward<SCHEDULER_FUNCTOR>(func));
+}
+
 bool AFCMapModule::GetInstEntityList(const int map_id, const int inst_id, AFIDataList& list)
 {
     auto pMapInfo = map_infos_.find_value(map_id);
@@ -333,7 +355,7 @@ bool AFCMapModule::GetInstEntityList(const int map_id, const int inst_id, AFIDat
 int AFCMapModule::GetEntityByDataNode(
     const int map_id, const std::string& name, const AFIDataList& value_args, AFIDataList& list)
 {
-    AFCDataList varObjectList;
+    AFCEntityList varObjectList;
     GetMapOnlineList(map_id, varObjectList);
     size_t entity_count = varObjectList.GetCount();
     for (size_t i = 0; i < entity_count; ++i)
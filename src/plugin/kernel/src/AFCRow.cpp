@@ -25,14 +25,17 @@
 namespace ark {
 
 // constructor
-AFCRow::AFCRow(
-    std::shared_ptr<AFClassMeta> pClassMeta, uint32_t row, const AFIDataList& args, ROW_CALLBACK_FUNCTOR&& func)
+AFCRow::AFCRow(std::shared_ptr<AFClassMeta> pClassMeta, uint32_t row, const AFIDataList& args,
+    std::shared_ptr<const bool> frozen, ROW_CALLBACK_FUNCTOR&& func)
     : row_(row)
 {
+    frozen_ = frozen;
+
     // data node
     auto function =
         std::bind(&AFCRow::OnDataCallBack, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-    m_pNodeManager = std::make_shared<AFNodeManager>(pClassMeta, args, std::move(function));
+    m_pNodeManager =
+        std::allocate_shared<AFNodeManager>(AFTagAllocator<AFNodeManager>(), pClassMeta, args, std::move(function));
 
     func_ = std::forward<ROW_CALLBACK_FUNCTOR>(func);
 }
@@ -43,6 +46,17 @@ uint32_t AFCRow::GetRow() const
     return row_;
 }
 
+size_t AFCRow::GetMemUsage() const
+{
+    size_t size = sizeof(AFCRow);
+    if (m_pNodeManager != nullptr)
+    {
+        size += m_pNodeManager->GetMemUsage();
+    }
+
+    return size;
+}
+
 // get row data
 bool AFCRow::GetBool(const uint32_t index) const
 {
@@ -188,6 +202,7 @@ const AFGUID& AFCRow::GetGUID(const std::string& name) const
 bool AFCRow::SetBool(const uint32_t index, bool value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetBool(index, value);
 }
@@ -195,6 +210,7 @@ bool AFCRow::SetBool(const uint32_t index, bool value)
 bool AFCRow::SetInt32(const uint32_t index, int32_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetInt32(index, value);
 }
@@ -202,6 +218,7 @@ bool AFCRow::SetInt32(const uint32_t index, int32_t value)
 bool AFCRow::SetInt64(const uint32_t index, int64_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetInt64(index, value);
 }
@@ -209,6 +226,7 @@ bool AFCRow::SetInt64(const uint32_t index, int64_t value)
 bool AFCRow::SetUInt32(const uint32_t index, uint32_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetUInt32(index, value);
 }
@@ -216,6 +234,7 @@ bool AFCRow::SetUInt32(const uint32_t index, uint32_t value)
 bool AFCRow::SetUInt64(const uint32_t index, uint64_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetUInt64(index, value);
 }
@@ -223,6 +242,7 @@ bool AFCRow::SetUInt64(const uint32_t index, uint64_t value)
 bool AFCRow::SetFloat(const uint32_t index, float value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetFloat(index, value);
 }
@@ -230,6 +250,7 @@ bool AFCRow::SetFloat(const uint32_t index, float value)
 bool AFCRow::SetDouble(const uint32_t index, double value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetDouble(index, value);
 }
@@ -237,6 +258,7 @@ bool AFCRow::SetDouble(const uint32_t index, double value)
 bool AFCRow::SetString(const uint32_t index, const std::string& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetString(index, value);
 }
@@ -244,6 +266,7 @@ bool AFCRow::SetString(const uint32_t index, const std::string& value)
 bool AFCRow::SetWString(const uint32_t index, const std::wstring& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetWString(index, value);
 }
@@ -251,6 +274,7 @@ bool AFCRow::SetWString(const uint32_t index, const std::wstring& value)
 bool AFCRow::SetGUID(const uint32_t index, const AFGUID& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetGUID(index, value);
 }
@@ -258,6 +282,7 @@ bool AFCRow::SetGUID(const uint32_t index, const AFGUID& value)
 bool AFCRow::SetBool(const std::string& name, bool value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetBool(name, value);
 }
@@ -265,6 +290,7 @@ bool AFCRow::SetBool(const std::string& name, bool value)
 bool AFCRow::SetInt32(const std::string& name, int32_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetInt32(name, value);
 }
@@ -272,6 +298,7 @@ bool AFCRow::SetInt32(const std::string& name, int32_t value)
 bool AFCRow::SetUInt32(const std::string& name, uint32_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetUInt32(name, value);
 }
@@ -279,6 +306,7 @@ bool AFCRow::SetUInt32(const std::string& name, uint32_t value)
 bool AFCRow::SetInt64(const std::string& name, int64_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetInt64(name, value);
 }
@@ -286,6 +314,7 @@ bool AFCRow::SetInt64(const std::string& name, int64_t value)
 bool AFCRow::SetUInt64(const std::string& name, uint64_t value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetUInt64(name, value);
 }
@@ -293,6 +322,7 @@ bool AFCRow::SetUInt64(const std::string& name, uint64_t value)
 bool AFCRow::SetFloat(const std::string& name, float value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetFloat(name, value);
 }
@@ -300,6 +330,7 @@ bool AFCRow::SetFloat(const std::string& name, float value)
 bool AFCRow::SetDouble(const std::string& name, double value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetDouble(name, value);
 }
@@ -307,6 +338,7 @@ bool AFCRow::SetDouble(const std::string& name, double value)
 bool AFCRow::SetString(const std::string& name, const std::string& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetString(name, value);
 }
@@ -314,6 +346,7 @@ bool AFCRow::SetString(const std::string& name, const std::string& value)
 bool AFCRow::SetWString(const std::string& name, const std::wstring& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetWString(name, value);
 }
@@ -321,10 +354,16 @@ bool AFCRow::SetWString(const std::string& name, const std::wstring& value)
 bool AFCRow::SetGUID(const std::string& name, const AFGUID& value)
 {
     ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     return m_pNodeManager->SetGUID(name, value);
 }
 
+bool AFCRow::IsFrozen() const
+{
+    return frozen_ != nullptr && *frozen_;
+}
+
 std::shared_ptr<AFNodeManager> AFCRow::GetNodeManager() const
 {
     return m_pNodeManager;
@@ -25,20 +25,70 @@
 
 namespace ark {
 
-AFCStaticEntity::AFCStaticEntity(
-    std::shared_ptr<AFClassMeta> pClassMeta, std::shared_ptr<AFNodeManager> pNodeManager, const ID_TYPE config_id)
+AFCStaticEntity::AFCStaticEntity(std::shared_ptr<AFStaticLayout> pLayout, const ID_TYPE config_id)
     : config_id_(config_id)
+    , layout_(pLayout)
+{
+    value_list_.resize(layout_->GetValueSize(), 0);
+    string_list_.resize(layout_->GetStringCount());
+}
+
+AFCStaticEntity::AFCStaticEntity(
+    std::shared_ptr<AFStaticLayout> pLayout, const AFNodeManager* pNodeManager, const ID_TYPE config_id)
+    : AFCStaticEntity(pLayout, config_id)
 {
-    class_meta_ = pClassMeta;
-    m_pNodeManager = pNodeManager;
+    ARK_ASSERT_RET_NONE(pNodeManager != nullptr);
+
+    // pack the row, a node not loaded keeps the default value
+    for (auto& field : layout_->GetFieldList())
+    {
+        AFINode* pNode = pNodeManager->GetNode(field.meta_->GetIndex());
+        if (pNode == nullptr)
+        {
+            continue;
+        }
+
+        switch (field.type_)
+        {
+            case ArkDataType::DT_BOOLEAN:
+                SetValue(field, pNode->GetBool());
+                break;
+            case ArkDataType::DT_INT32:
+                SetValue(field, pNode->GetInt32());
+                break;
+            case ArkDataType::DT_UINT32:
+                SetValue(field, pNode->GetUInt32());
+                break;
+            case ArkDataType::DT_INT64:
+                SetValue(field, pNode->GetInt64());
+                break;
+            case ArkDataType::DT_UINT64:
+                SetValue(field, pNode->GetUInt64());
+                break;
+            case ArkDataType::DT_FLOAT:
+                SetValue(field, pNode->GetFloat());
+                break;
+            case ArkDataType::DT_DOUBLE:
+                SetValue(field, pNode->GetDouble());
+                break;
+            case ArkDataType::DT_STRING:
+                string_list_[field.offset_] = pNode->GetString();
+                break;
+            case ArkDataType::DT_GUID:
+                SetValue(field, pNode->GetObject());
+                break;
+            default:
+                break;
+        }
+    }
 }
 
 // query data
 const std::string& AFCStaticEntity::GetClassName() const
 {
-    ARK_ASSERT_RET_VAL(class_meta_ != nullptr, NULL_STR);
+    ARK_ASSERT_RET_VAL(layout_ != nullptr, NULL_STR);
 
-    return class_meta_->GetName();
+    return layout_->GetClassMeta()->GetName();
 }
 
 ID_TYPE AFCStaticEntity::GetConfigID() const
@@ -48,133 +98,169 @@ ID_TYPE AFCStaticEntity::GetConfigID() const
 
 bool AFCStaticEntity::GetBool(const std::string& name) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_BOOLEAN);
-
-    return m_pNodeManager->GetBool(name);
+    return GetBool(layout_->GetClassMeta()->GetIndex(name));
 }
 
 int32_t AFCStaticEntity::GetInt32(const std::string& name) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_INT);
-
-    return m_pNodeManager->GetInt32(name);
+    return GetInt32(layout_->GetClassMeta()->GetIndex(name));
 }
 
 uint32_t AFCStaticEntity::GetUInt32(const std::string& name) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_INT);
-
-    return m_pNodeManager->GetUInt32(name);
+    return GetUInt32(layout_->GetClassMeta()->GetIndex(name));
 }
 
 int64_t AFCStaticEntity::GetInt64(const std::string& name) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_INT64);
-
-    return m_pNodeManager->GetInt64(name);
+    return GetInt64(layout_->GetClassMeta()->GetIndex(name));
 }
 
 int64_t AFCStaticEntity::GetUInt64(const std::string& name) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_INT64);
-
-    return m_pNodeManager->GetUInt64(name);
+    return GetUInt64(layout_->GetClassMeta()->GetIndex(name));
 }
 
 float AFCStaticEntity::GetFloat(const std::string& name) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_FLOAT);
-
-    return m_pNodeManager->GetFloat(name);
+    return GetFloat(layout_->GetClassMeta()->GetIndex(name));
 }
 
 double AFCStaticEntity::GetDouble(const std::string& name) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_DOUBLE);
-
-    return m_pNodeManager->GetDouble(name);
+    return GetDouble(layout_->GetClassMeta()->GetIndex(name));
 }
 
 const std::string& AFCStaticEntity::GetString(const std::string& name) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_STR);
-
-    return m_pNodeManager->GetString(name);
+    return GetString(layout_->GetClassMeta()->GetIndex(name));
 }
 
 const std::wstring& AFCStaticEntity::GetWString(const std::string& name) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_WIDESTR);
-
-    return m_pNodeManager->GetWString(name);
+    return GetWString(layout_->GetClassMeta()->GetIndex(name));
 }
 
 bool AFCStaticEntity::GetBool(const uint32_t index) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_BOOLEAN);
-
-    return m_pNodeManager->GetBool(index);
+    return GetValue(index, ArkDataType::DT_BOOLEAN, NULL_BOOLEAN);
 }
 
 int32_t AFCStaticEntity::GetInt32(const uint32_t index) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_INT);
-
-    return m_pNodeManager->GetInt32(index);
+    return GetValue<int32_t>(index, ArkDataType::DT_INT32, NULL_INT);
 }
 
 uint32_t AFCStaticEntity::GetUInt32(const uint32_t index) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_INT);
-
-    return m_pNodeManager->GetUInt32(index);
+    return GetValue<uint32_t>(index, ArkDataType::DT_UINT32, NULL_INT);
 }
 
 int64_t AFCStaticEntity::GetInt64(const uint32_t index) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_INT64);
-
-    return m_pNodeManager->GetInt64(index);
+    return GetValue<int64_t>(index, ArkDataType::DT_INT64, NULL_INT64);
 }
 
 int64_t AFCStaticEntity::GetUInt64(const uint32_t index) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_INT64);
-
-    return m_pNodeManager->GetUInt64(index);
+    return static_cast<int64_t>(GetValue<uint64_t>(index, ArkDataType::DT_UINT64, NULL_INT64));
 }
 
 float AFCStaticEntity::GetFloat(const uint32_t index) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_FLOAT);
-
-    return m_pNodeManager->GetFloat(index);
+    return GetValue<float>(index, ArkDataType::DT_FLOAT, NULL_FLOAT);
 }
 
 double AFCStaticEntity::GetDouble(const uint32_t index) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_DOUBLE);
-
-    return m_pNodeManager->GetDouble(index);
+    return GetValue<double>(index, ArkDataType::DT_DOUBLE, NULL_DOUBLE);
 }
 
 const std::string& AFCStaticEntity::GetString(const uint32_t index) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_STR);
+    auto pField = layout_->FindField(index);
+    ARK_ASSERT_RET_VAL(pField != nullptr, NULL_STR);
+
+    if (pField->type_ != ArkDataType::DT_STRING)
+    {
+        return NULL_STR;
+    }
 
-    return m_pNodeManager->GetString(index);
+    return string_list_[pField->offset_];
 }
 
 const std::wstring& AFCStaticEntity::GetWString(const uint32_t index) const
 {
-    ARK_ASSERT_RET_VAL(m_pNodeManager != nullptr, NULL_WIDESTR);
+    // no wide string node, same as node manager
+    return NULL_WIDESTR;
+}
+
+AFGUID AFCStaticEntity::GetGUID(const uint32_t index) const
+{
+    return GetValue<AFGUID>(index, ArkDataType::DT_GUID, NULL_GUID);
+}
+
+bool AFCStaticEntity::CopyTo(AFNodeManager* pNodeManager) const
+{
+    ARK_ASSERT_RET_VAL(pNodeManager != nullptr, false);
+
+    for (auto& field : layout_->GetFieldList())
+    {
+        AFINode* pNode = pNodeManager->CreateData(field.meta_);
+        if (pNode == nullptr)
+        {
+            continue;
+        }
+
+        const uint32_t index = field.meta_->GetIndex();
+        switch (field.type_)
+        {
+            case ArkDataType::DT_BOOLEAN:
+                pNode->SetBool(GetBool(index));
+                break;
+            case ArkDataType::DT_INT32:
+                pNode->SetInt32(GetInt32(index));
+                break;
+            case ArkDataType::DT_UINT32:
+                pNode->SetUInt32(GetUInt32(index));
+                break;
+            case ArkDataType::DT_INT64:
+                pNode->SetInt64(GetInt64(index));
+                break;
+            case ArkDataType::DT_UINT64:
+                pNode->SetUInt64(static_cast<uint64_t>(GetUInt64(index)));
+                break;
+            case ArkDataType::DT_FLOAT:
+                pNode->SetFloat(GetFloat(index));
+                break;
+            case ArkDataType::DT_DOUBLE:
+                pNode->SetDouble(GetDouble(index));
+                break;
+            case ArkDataType::DT_STRING:
+                pNode->SetString(string_list_[field.offset_]);
+                break;
+            case ArkDataType::DT_GUID:
+                pNode->SetObject(GetGUID(index));
+                break;
+            default:
+                break;
+        }
+    }
+
+    return true;
+}
+
+bool AFCStaticEntity::IsSameData(const AFNodeManager* pNodeManager) const
+{
+    ARK_ASSERT_RET_VAL(pNodeManager != nullptr, false);
 
-    return m_pNodeManager->GetWString(index);
+    AFCStaticEntity other(layout_, pNodeManager, config_id_);
+    return value_list_ == other.value_list_ && string_list_ == other.string_list_;
 }
 
-std::shared_ptr<AFNodeManager> AFCStaticEntity::GetNodeManager() const
+std::shared_ptr<AFStaticLayout> AFCStaticEntity::GetLayout() const
 {
-    return m_pNodeManager;
+    return layout_;
 }
 
 } // namespace ark
@@ -26,9 +26,11 @@
 namespace ark {
 
 // constructor
-AFCTable::AFCTable(std::shared_ptr<AFTableMeta> pTableMeta, TABLE_CALLBACK_FUNCTOR&& func)
+AFCTable::AFCTable(
+    std::shared_ptr<AFTableMeta> pTableMeta, std::shared_ptr<const bool> frozen, TABLE_CALLBACK_FUNCTOR&& func)
 {
     table_meta_ = pTableMeta;
+    frozen_ = frozen;
     func_ = std::forward<TABLE_CALLBACK_FUNCTOR>(func);
 }
 
@@ -110,6 +112,7 @@ AFIRow* AFCTable::AddRow(uint32_t row /* = 0u*/)
 AFIRow* AFCTable::AddRow(uint32_t row, const AFIDataList& args)
 {
     ARK_ASSERT_RET_VAL(args.GetCount() % 2 == 0, nullptr);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), nullptr);
 
     AFIRow* pRowData = nullptr;
     if (row == 0)
@@ -136,6 +139,7 @@ AFIRow* AFCTable::FindRow(uint32_t row) const
 bool AFCTable::RemoveRow(uint32_t row)
 {
     ARK_ASSERT_RET_VAL(data_.find_value(row) != nullptr, false);
+    ARK_ASSERT_RET_VAL_NO_EFFECT(!IsFrozen(), false);
 
     // call back
     OnTableChanged(row, ArkTableOpType::TABLE_DELETE);
@@ -147,10 +151,30 @@ bool AFCTable::RemoveRow(uint32_t row)
 
 void AFCTable::Clear()
 {
+    if (IsFrozen())
+    {
+        return;
+    }
+
     OnTableChanged(0u, ArkTableOpType::TABLE_CLEAR);
     data_.clear();
 }
 
+size_t AFCTable::GetMemUsage() const
+{
+    size_t size = sizeof(AFCTable) + data_.GetMemUsage();
+    for (auto& iter : data_)
+    {
+        auto pRowData = iter.second;
+        if (pRowData != nullptr)
+        {
+            size += pRowData->GetMemUsage();
+        }
+    }
+
+    return size;
+}
+
 // find
 uint32_t AFCTable::FindInt32(const uint32_t index, const int32_t value) const
 {
@@ -312,6 +336,11 @@ uint32_t AFCTable::GetIndex(const std::string& name) const
     return table_meta_->GetIndex(name);
 }
 
+bool AFCTable::IsFrozen() const
+{
+    return frozen_ != nullptr && *frozen_;
+}
+
 uint32_t AFCTable::SelectRow() const
 {
     if (data_.size() == current_row_)
@@ -385,7 +414,8 @@ AFIRow* AFCTable::CreateRow(uint32_t row, const AFIDataList& args)
     auto func = std::bind(&AFCTable::OnRowDataChanged, this, std::placeholders::_1, std::placeholders::_2,
         std::placeholders::_3, std::placeholders::_4);
 
-    auto pRow = ARK_NEW AFCRow(pClassMeta, row, args, std::move(func));
+    AFAllocTagScope alloc_scope(alloc_tag_);
+    auto pRow = ARK_NEW AFCRow(pClassMeta, row, args, frozen_, std::move(func));
     if (!data_.insert(row, pRow).second)
     {
         ARK_DELETE(pRow);
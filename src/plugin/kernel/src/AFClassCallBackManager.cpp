@@ -27,91 +27,112 @@ AFClassCallBackManager::TableSyncCallBacks AFClassCallBackManager::table_sync_ca
 AFClassCallBackManager::ContainerSyncCallBack AFClassCallBackManager::container_sync_call_backs_list_;
 AFClassCallBackManager::DataDelaySyncCallBacks AFClassCallBackManager::delay_sync_call_back_list_;
 AFClassCallBackManager::DelaySyncDataList AFClassCallBackManager::delay_sync_data_list_;
+bool AFClassCallBackManager::profile_enable_ = false;
 
-bool AFClassCallBackManager::AddClassCallBack(CLASS_EVENT_FUNCTOR&& cb, const int32_t prio)
+AFClassCallBackManager::AFClassCallBackManager(const std::string& class_name)
+    : class_name_(class_name)
 {
-    class_events_.insert(std::make_pair(prio, std::forward<CLASS_EVENT_FUNCTOR>(cb)));
+}
+
+bool AFClassCallBackManager::AddClassCallBack(CLASS_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
+{
+    auto pStat = CreateStat("class", 0, owner);
+    class_events_.insert(std::make_pair(
+        prio, AFCallBackNode<CLASS_EVENT_FUNCTOR>(std::forward<CLASS_EVENT_FUNCTOR>(cb), pStat)));
     return true;
 }
 
-bool AFClassCallBackManager::AddDataCallBack(const uint32_t index, DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFClassCallBackManager::AddDataCallBack(
+    const uint32_t index, DATA_NODE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
-    auto iter = data_call_backs_list_.find(index);
-    if (iter == data_call_backs_list_.end())
-    {
-        NodeCallBacks call_backs;
-        call_backs.insert(std::make_pair(prio, std::forward<DATA_NODE_EVENT_FUNCTOR>(cb)));
-        data_call_backs_list_.insert(std::make_pair(index, call_backs));
-    }
-    else
-    {
-        iter->second.insert(std::make_pair(prio, std::forward<DATA_NODE_EVENT_FUNCTOR>(cb)));
-    }
+    auto pStat = CreateStat("node", index, owner);
+    data_call_backs_list_[index].insert(std::make_pair(
+        prio, AFCallBackNode<DATA_NODE_EVENT_FUNCTOR>(std::forward<DATA_NODE_EVENT_FUNCTOR>(cb), pStat)));
 
     return true;
 }
 
-bool AFClassCallBackManager::AddTableCallBack(const uint32_t index, DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFClassCallBackManager::AddTableCallBack(
+    const uint32_t index, DATA_TABLE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
-    auto iter = table_call_backs_list_.find(index);
-    if (iter == table_call_backs_list_.end())
-    {
-        TableCallBacks call_backs;
-
-        call_backs.insert(std::make_pair(prio, std::forward<DATA_TABLE_EVENT_FUNCTOR>(cb)));
-        table_call_backs_list_.insert(std::make_pair(index, call_backs));
-    }
-    else
-    {
-        iter->second.insert(std::make_pair(prio, std::forward<DATA_TABLE_EVENT_FUNCTOR>(cb)));
-    }
+    auto pStat = CreateStat("table", index, owner);
+    table_call_backs_list_[index].insert(std::make_pair(
+        prio, AFCallBackNode<DATA_TABLE_EVENT_FUNCTOR>(std::forward<DATA_TABLE_EVENT_FUNCTOR>(cb), pStat)));
 
     return true;
 }
 
 bool AFClassCallBackManager::AddContainerCallBack(
-    const uint32_t index, CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio)
+    const uint32_t index, CONTAINER_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
-    auto iter = container_call_backs_list_.find(index);
-    if (iter == container_call_backs_list_.end())
-    {
-        ContainerCallBacks call_backs;
-
-        call_backs.insert(std::make_pair(prio, std::forward<CONTAINER_EVENT_FUNCTOR>(cb)));
-        container_call_backs_list_.insert(std::make_pair(index, call_backs));
-    }
-    else
-    {
-        iter->second.insert(std::make_pair(prio, std::forward<CONTAINER_EVENT_FUNCTOR>(cb)));
-    }
+    auto pStat = CreateStat("container", index, owner);
+    container_call_backs_list_[index].insert(std::make_pair(
+        prio, AFCallBackNode<CONTAINER_EVENT_FUNCTOR>(std::forward<CONTAINER_EVENT_FUNCTOR>(cb), pStat)));
 
     return true;
 }
 
-bool AFClassCallBackManager::AddLeaveSceneEvent(SCENE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFClassCallBackManager::AddLeaveSceneEvent(SCENE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
-    leave_scene_events_.insert(std::make_pair(prio, std::forward<SCENE_EVENT_FUNCTOR>(cb)));
+    auto pStat = CreateStat("leave_scene", 0, owner);
+    leave_scene_events_.insert(
+        std::make_pair(prio, AFCallBackNode<SCENE_EVENT_FUNCTOR>(std::forward<SCENE_EVENT_FUNCTOR>(cb), pStat)));
     return true;
 }
 
-bool AFClassCallBackManager::AddEnterSceneEvent(SCENE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFClassCallBackManager::AddEnterSceneEvent(SCENE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
-    enter_scene_events_.insert(std::make_pair(prio, std::forward<SCENE_EVENT_FUNCTOR>(cb)));
+    auto pStat = CreateStat("enter_scene", 0, owner);
+    enter_scene_events_.insert(
+        std::make_pair(prio, AFCallBackNode<SCENE_EVENT_FUNCTOR>(std::forward<SCENE_EVENT_FUNCTOR>(cb), pStat)));
     return true;
 }
 
-bool AFClassCallBackManager::AddMoveEvent(MOVE_EVENT_FUNCTOR&& cb, const int32_t prio)
+bool AFClassCallBackManager::AddMoveEvent(MOVE_EVENT_FUNCTOR&& cb, const int32_t prio, const std::string& owner)
 {
-    move_events_.insert(std::make_pair(prio, std::forward<MOVE_EVENT_FUNCTOR>(cb)));
+    auto pStat = CreateStat("move", 0, owner);
+    move_events_.insert(
+        std::make_pair(prio, AFCallBackNode<MOVE_EVENT_FUNCTOR>(std::forward<MOVE_EVENT_FUNCTOR>(cb), pStat)));
     return true;
 }
 
+void AFClassCallBackManager::SetProfileEnable(const bool value)
+{
+    profile_enable_ = value;
+}
+
+bool AFClassCallBackManager::IsProfileEnable()
+{
+    return profile_enable_;
+}
+
+const AFClassCallBackManager::StatList& AFClassCallBackManager::GetStatList() const
+{
+    return stat_list_;
+}
+
+void AFClassCallBackManager::ResetStat()
+{
+    for (auto& stat : stat_list_)
+    {
+        stat.Reset();
+    }
+}
+
+AFCallBackStat* AFClassCallBackManager::CreateStat(
+    const std::string& type, const uint32_t index, const std::string& owner)
+{
+    stat_list_.emplace_back(class_name_, type, index, owner);
+    return &stat_list_.back();
+}
+
 bool AFClassCallBackManager::OnClassEvent(
     const AFGUID& id, const std::string& class_name, const ArkEntityEvent eClassEvent, const AFIDataList& valueList)
 {
     for (auto& iter : class_events_)
     {
-        iter.second(id, class_name, eClassEvent, valueList);
+        AFCallBackTimer timer(iter.second.stat_, profile_enable_);
+        iter.second.func_(id, class_name, eClassEvent, valueList);
     }
 
     return true;
@@ -148,7 +169,8 @@ bool AFClassCallBackManager::OnNodeCallBack(
     {
         for (auto& iter : iter_call_backs->second)
         {
-            iter.second(self, name, index, old_data, new_data);
+            AFCallBackTimer timer(iter.second.stat_, profile_enable_);
+            iter.second.func_(self, name, index, old_data, new_data);
         }
     }
 
@@ -184,7 +206,8 @@ bool AFClassCallBackManager::OnTableCallBack(const AFGUID& self, const ArkMaskTy
     {
         for (auto& iter : iter_call_backs->second)
         {
-            iter.second(self, event_data, old_data, new_data);
+            AFCallBackTimer timer(iter.second.stat_, profile_enable_);
+            iter.second.func_(self, event_data, old_data, new_data);
         }
     }
 
@@ -219,7 +242,8 @@ bool AFClassCallBackManager::OnContainerCallBack(const AFGUID& self, const uint3
     {
         for (auto& iter : iter_call_backs->second)
         {
-            iter.second(self, index, op_type, src_index, dest_index);
+            AFCallBackTimer timer(iter.second.stat_, profile_enable_);
+            iter.second.func_(self, index, op_type, src_index, dest_index);
         }
     }
 
@@ -230,7 +254,8 @@ bool AFClassCallBackManager::OnLeaveSceneEvent(const AFGUID& self, const int map
 {
     for (auto& iter : leave_scene_events_)
     {
-        iter.second(self, map_id, map_inst_id);
+        AFCallBackTimer timer(iter.second.stat_, profile_enable_);
+        iter.second.func_(self, map_id, map_inst_id);
     }
 
     return true;
@@ -240,7 +265,8 @@ bool AFClassCallBackManager::OnEnterSceneEvent(const AFGUID& self, const int map
 {
     for (auto& iter : enter_scene_events_)
     {
-        iter.second(self, map_id, map_inst_id);
+        AFCallBackTimer timer(iter.second.stat_, profile_enable_);
+        iter.second.func_(self, map_id, map_inst_id);
     }
 
     return true;
@@ -250,7 +276,8 @@ bool AFClassCallBackManager::OnMoveEvent(const AFGUID& self, const AFVector3D& o
 {
     for (auto& iter : move_events_)
     {
-        iter.second(self, old_pos, new_pos);
+        AFCallBackTimer timer(iter.second.stat_, profile_enable_);
+        iter.second.func_(self, old_pos, new_pos);
     }
 
     return true;
@@ -25,7 +25,8 @@ namespace ark {
 AFClassMeta::AFClassMeta(const std::string& name)
     : name_(name)
 {
-    class_meta_call_back_ = std::make_shared<AFClassCallBackManager>();
+    class_meta_call_back_ = std::make_shared<AFClassCallBackManager>(name);
+    alloc_tag_ = AFAllocCounter::Instance().RegisterTag(name);
 }
 
 size_t AFClassMeta::GetNodeCount() const
@@ -48,6 +49,11 @@ const std::string& AFClassMeta::GetResPath() const
     return res_path_;
 }
 
+uint32_t AFClassMeta::GetAllocTag() const
+{
+    return alloc_tag_;
+}
+
 // create data meta
 std::shared_ptr<AFNodeMeta> AFClassMeta::CreateDataMeta(const std::string& name, const uint32_t index)
 {
@@ -0,0 +1,526 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "base/AFCRC.hpp"
+#include "kernel/include/AFConfigImage.hpp"
+#include "kernel/include/AFCStaticEntity.hpp"
+
+// after project headers, sys/mman.h defines MAP_TYPE
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifndef ARK_PLATFORM_WIN
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace ark {
+
+template<typename T>
+static void WriteImageValue(std::string& out, const T value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool ReadImageValue(const char*& pos, const char* end, T& value)
+{
+    if (static_cast<size_t>(end - pos) < sizeof(T))
+    {
+        return false;
+    }
+
+    memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+AFConfigImage::~AFConfigImage()
+{
+    Close();
+}
+
+bool AFConfigImage::Open(const std::string& file_path)
+{
+    Close();
+
+#ifdef ARK_PLATFORM_WIN
+    std::ifstream file(file_path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    buffer_.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    if (buffer_.empty() || !file.read(buffer_.data(), buffer_.size()))
+    {
+        buffer_.clear();
+        return false;
+    }
+
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#else
+    int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* addr = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return false;
+    }
+
+    data_ = static_cast<const char*>(addr);
+    size_ = static_cast<size_t>(file_stat.st_size);
+#endif
+
+    // build class index
+    const char* pos = data_;
+    const char* end = data_ + size_;
+
+    ImageHead image_head;
+    if (!ReadImageValue(pos, end, image_head) || image_head.magic_ != IMAGE_MAGIC ||
+        image_head.version_ != IMAGE_VERSION)
+    {
+        Close();
+        return false;
+    }
+
+    for (uint32_t i = 0; i < image_head.class_count_; ++i)
+    {
+        if (static_cast<size_t>(end - pos) < sizeof(ClassHead))
+        {
+            Close();
+            return false;
+        }
+
+        ClassBlock block;
+        block.head_ = reinterpret_cast<const ClassHead*>(pos);
+        pos += sizeof(ClassHead);
+
+        const uint32_t name_size = block.head_->name_size_;
+        const uint64_t data_size = block.head_->data_size_;
+        if (static_cast<uint64_t>(end - pos) < name_size + data_size)
+        {
+            Close();
+            return false;
+        }
+
+        std::string class_name(pos, name_size);
+        pos += name_size;
+
+        block.data_ = pos;
+        pos += data_size;
+
+        class_blocks_.insert(std::make_pair(class_name, block));
+    }
+
+    return true;
+}
+
+void AFConfigImage::Close()
+{
+    class_blocks_.clear();
+
+#ifdef ARK_PLATFORM_WIN
+    buffer_.clear();
+#else
+    if (data_ != nullptr)
+    {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
+bool AFConfigImage::IsOpen() const
+{
+    return data_ != nullptr;
+}
+
+bool AFConfigImage::LoadClass(std::shared_ptr<AFClassMeta> pClassMeta, const SourceInfo& source_info,
+    AFStaticEntityManager* pStaticEntityManager) const
+{
+    ARK_ASSERT_RET_VAL(pClassMeta != nullptr && pStaticEntityManager != nullptr, false);
+
+    auto iter = class_blocks_.find(pClassMeta->GetName());
+    if (iter == class_blocks_.end())
+    {
+        return false;
+    }
+
+    const ClassBlock& block = iter->second;
+
+    // stale check
+    if (block.head_->source_size_ != source_info.size_ || block.head_->source_hash_ != source_info.hash_ ||
+        block.head_->meta_sign_ != GetMetaSign(pClassMeta))
+    {
+        return false;
+    }
+
+    // read all rows first, do not leave half a class in manager when the block is broken
+    std::vector<std::shared_ptr<AFCStaticEntity>> rows;
+    // row count comes from the file, never reserve more than the block can hold
+    rows.reserve(std::min<uint64_t>(block.head_->row_count_, block.head_->data_size_ / sizeof(ID_TYPE)));
+
+    const char* pos = block.data_;
+    const char* end = block.data_ + block.head_->data_size_;
+
+    auto pLayout = pStaticEntityManager->GetLayout(pClassMeta);
+    for (uint32_t i = 0; i < block.head_->row_count_; ++i)
+    {
+        ID_TYPE config_id = 0;
+        if (!ReadImageValue(pos, end, config_id))
+        {
+            return false;
+        }
+
+        auto pStaticEntity = std::make_shared<AFCStaticEntity>(pLayout, config_id);
+        if (!ReadRow(pos, end, pStaticEntity.get()))
+        {
+            return false;
+        }
+
+        rows.emplace_back(pStaticEntity);
+    }
+
+    if (pos != end)
+    {
+        return false;
+    }
+
+    // a duplicated id would make AddStaticEntity fail in the middle of the class
+    std::unordered_set<ID_TYPE> row_ids;
+    for (auto& pStaticEntity : rows)
+    {
+        const ID_TYPE config_id = pStaticEntity->GetConfigID();
+        if (!row_ids.insert(config_id).second || pStaticEntityManager->FindObject(config_id) != nullptr)
+        {
+            return false;
+        }
+    }
+
+    for (auto& pStaticEntity : rows)
+    {
+        ARK_ASSERT_RET_VAL(pStaticEntityManager->AddStaticEntity(pStaticEntity), false);
+    }
+
+    return true;
+}
+
+bool AFConfigImage::Save(const std::string& file_path, const AFClassMetaManager::ClassMetaList& class_meta_list,
+    const SourceInfoList& source_info_list, AFStaticEntityManager* pStaticEntityManager)
+{
+    ARK_ASSERT_RET_VAL(pStaticEntityManager != nullptr, false);
+
+    // group static entities by class
+    std::unordered_map<std::string, std::vector<std::shared_ptr<AFCStaticEntity>>> class_entities;
+    for (auto& iter : pStaticEntityManager->GetStaticObjectList())
+    {
+        auto pStaticEntity = std::dynamic_pointer_cast<AFCStaticEntity>(iter.second);
+        if (pStaticEntity == nullptr)
+        {
+            continue;
+        }
+
+        class_entities[pStaticEntity->GetClassName()].push_back(pStaticEntity);
+    }
+
+    ImageHead image_head;
+    image_head.magic_ = IMAGE_MAGIC;
+    image_head.version_ = IMAGE_VERSION;
+
+    std::string out;
+    WriteImageValue(out, image_head);
+
+    for (auto& iter : class_meta_list)
+    {
+        auto pClassMeta = iter.second;
+        if (pClassMeta == nullptr || pClassMeta->GetResPath().empty())
+        {
+            continue;
+        }
+
+        auto iter_info = source_info_list.find(pClassMeta->GetName());
+        if (iter_info == source_info_list.end())
+        {
+            continue;
+        }
+
+        const SourceInfo& info = iter_info->second;
+
+        std::string class_data;
+        uint32_t row_count = 0;
+        bool class_ok = true;
+
+        auto iter_entity = class_entities.find(pClassMeta->GetName());
+        if (iter_entity != class_entities.end())
+        {
+            for (auto& pStaticEntity : iter_entity->second)
+            {
+                WriteImageValue(class_data, pStaticEntity->GetConfigID());
+                if (!WriteRow(class_data, pClassMeta, pStaticEntity.get()))
+                {
+                    class_ok = false;
+                    break;
+                }
+
+                ++row_count;
+            }
+        }
+
+        // class with unsupported data type keeps loading from xml
+        if (!class_ok)
+        {
+            continue;
+        }
+
+        const std::string& class_name = pClassMeta->GetName();
+
+        ClassHead class_head;
+        class_head.name_size_ = static_cast<uint32_t>(class_name.size());
+        class_head.source_size_ = info.size_;
+        class_head.source_hash_ = info.hash_;
+        class_head.meta_sign_ = GetMetaSign(pClassMeta);
+        class_head.row_count_ = row_count;
+        class_head.data_size_ = class_data.size();
+
+        WriteImageValue(out, class_head);
+        out.append(class_name);
+        out.append(class_data);
+
+        ++image_head.class_count_;
+    }
+
+    memcpy(&out[0], &image_head, sizeof(image_head));
+
+    // write to a temp file then replace, a broken image is never left behind
+    std::string temp_path = file_path + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        file.write(out.data(), out.size());
+        if (!file.good())
+        {
+            return false;
+        }
+    }
+
+    std::remove(file_path.c_str());
+    return std::rename(temp_path.c_str(), file_path.c_str()) == 0;
+}
+
+bool AFConfigImage::GetSourceInfo(const std::string& file_path, SourceInfo& info)
+{
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (file.bad())
+    {
+        return false;
+    }
+
+    info.size_ = static_cast<uint64_t>(content.size());
+    info.hash_ = AFCRC::crc64(content);
+    return true;
+}
+
+uint64_t AFConfigImage::GetMetaSign(std::shared_ptr<AFClassMeta> pClassMeta)
+{
+    ARK_ASSERT_RET_VAL(pClassMeta != nullptr, 0);
+
+    std::string meta_info;
+    for (auto iter : pClassMeta->GetDataMetaList())
+    {
+        auto pDataMeta = iter.second;
+        meta_info.append(ARK_TO_STRING(pDataMeta->GetIndex()));
+        meta_info.append(":");
+        meta_info.append(ARK_TO_STRING(static_cast<uint32_t>(pDataMeta->GetType())));
+        meta_info.append(":");
+        meta_info.append(pDataMeta->GetName());
+        meta_info.append(";");
+    }
+
+    return AFCRC::crc64(meta_info);
+}
+
+bool AFConfigImage::WriteRow(
+    std::string& out, std::shared_ptr<AFClassMeta> pClassMeta, const AFCStaticEntity* pStaticEntity)
+{
+    ARK_ASSERT_RET_VAL(pStaticEntity != nullptr, false);
+
+    for (auto iter : pClassMeta->GetDataMetaList())
+    {
+        const uint32_t index = iter.first;
+        switch (iter.second->GetType())
+        {
+            case ArkDataType::DT_BOOLEAN:
+                WriteImageValue<uint8_t>(out, pStaticEntity->GetBool(index) ? 1 : 0);
+                break;
+            case ArkDataType::DT_INT32:
+                WriteImageValue(out, pStaticEntity->GetInt32(index));
+                break;
+            case ArkDataType::DT_UINT32:
+                WriteImageValue(out, pStaticEntity->GetUInt32(index));
+                break;
+            case ArkDataType::DT_INT64:
+                WriteImageValue(out, pStaticEntity->GetInt64(index));
+                break;
+            case ArkDataType::DT_UINT64:
+                WriteImageValue(out, static_cast<uint64_t>(pStaticEntity->GetUInt64(index)));
+                break;
+            case ArkDataType::DT_FLOAT:
+                WriteImageValue(out, pStaticEntity->GetFloat(index));
+                break;
+            case ArkDataType::DT_DOUBLE:
+                WriteImageValue(out, pStaticEntity->GetDouble(index));
+                break;
+            case ArkDataType::DT_STRING:
+            {
+                auto& value = pStaticEntity->GetString(index);
+                WriteImageValue(out, static_cast<uint32_t>(value.size()));
+                out.append(value);
+            }
+            break;
+            case ArkDataType::DT_GUID:
+                WriteImageValue(out, pStaticEntity->GetGUID(index));
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool AFConfigImage::ReadRow(const char*& pos, const char* end, AFCStaticEntity* pStaticEntity)
+{
+    ARK_ASSERT_RET_VAL(pStaticEntity != nullptr, false);
+
+    // layout fields are in class meta index order, the same as WriteRow
+    for (auto& field : pStaticEntity->GetLayout()->GetFieldList())
+    {
+        bool ret = true;
+        switch (field.type_)
+        {
+            case ArkDataType::DT_BOOLEAN:
+            {
+                uint8_t value = 0;
+                ret = ReadImageValue(pos, end, value);
+                pStaticEntity->SetValue(field, value != 0);
+            }
+            break;
+            case ArkDataType::DT_INT32:
+            {
+                int32_t value = 0;
+                ret = ReadImageValue(pos, end, value);
+                pStaticEntity->SetValue(field, value);
+            }
+            break;
+            case ArkDataType::DT_UINT32:
+            {
+                uint32_t value = 0;
+                ret = ReadImageValue(pos, end, value);
+                pStaticEntity->SetValue(field, value);
+            }
+            break;
+            case ArkDataType::DT_INT64:
+            {
+                int64_t value = 0;
+                ret = ReadImageValue(pos, end, value);
+                pStaticEntity->SetValue(field, value);
+            }
+            break;
+            case ArkDataType::DT_UINT64:
+            {
+                uint64_t value = 0;
+                ret = ReadImageValue(pos, end, value);
+                pStaticEntity->SetValue(field, value);
+            }
+            break;
+            case ArkDataType::DT_FLOAT:
+            {
+                float value = 0;
+                ret = ReadImageValue(pos, end, value);
+                pStaticEntity->SetValue(field, value);
+            }
+            break;
+            case ArkDataType::DT_DOUBLE:
+            {
+                double value = 0;
+                ret = ReadImageValue(pos, end, value);
+                pStaticEntity->SetValue(field, value);
+            }
+            break;
+            case ArkDataType::DT_STRING:
+            {
+                uint32_t length = 0;
+                ret = ReadImageValue(pos, end, length) && static_cast<size_t>(end - pos) >= length;
+                if (ret)
+                {
+                    pStaticEntity->string_list_[field.offset_].assign(pos, length);
+                    pos += length;
+                }
+            }
+            break;
+            case ArkDataType::DT_GUID:
+            {
+                AFGUID value = NULL_GUID;
+                ret = ReadImageValue(pos, end, value);
+                pStaticEntity->SetValue(field, value);
+            }
+            break;
+            default:
+                ret = false;
+                break;
+        }
+
+        if (!ret)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace ark
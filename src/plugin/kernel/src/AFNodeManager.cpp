@@ -142,6 +142,7 @@ AFINode* AFNodeManager::CreateData(std::shared_ptr<AFNodeMeta> pDataMeta)
     ARK_ASSERT_RET_VAL(index > 0, nullptr);
     ARK_ASSERT_RET_VAL(data_list_.find_value(index) == nullptr, nullptr);
 
+    AFAllocTagScope alloc_scope(alloc_tag_);
     auto pData = CreateDataByMeta(pDataMeta);
     ARK_ASSERT_RET_VAL(pData != nullptr, nullptr);
 
@@ -159,6 +160,7 @@ bool AFNodeManager::CreateData(AFINode* pData)
 {
     ARK_ASSERT_RET_VAL(pData != nullptr, false);
 
+    AFAllocTagScope alloc_scope(alloc_tag_);
     auto pNewData = CreateDataByMeta(pData->GetMeta());
     ARK_ASSERT_RET_VAL(pNewData != nullptr, false);
 
@@ -620,20 +622,24 @@ bool AFNodeManager::SetString(const uint32_t index, const std::string& value)
     auto data_type = pData->GetType();
     ARK_ASSERT_RET_VAL(data_type == ArkDataType::DT_STRING, false);
 
-    auto old_value = pData->GetString();
-    if (old_value == value)
+    if (pData->GetString() == value)
     {
         return false;
     }
 
-    pData->SetString(value);
-
-    if (func_)
+    if (!func_)
     {
-        // data callbacks
-        func_(pData, AFCData(data_type, old_value.c_str()), AFCData(data_type, value.c_str()));
+        pData->SetString(value);
+        return true;
     }
 
+    // keep old value in AFCData, short strings do not allocate
+    AFCData old_data(data_type, pData->GetString().c_str());
+    pData->SetString(value);
+
+    // data callbacks
+    func_(pData, old_data, AFCData(data_type, value.c_str()));
+
     return true;
 }
 
@@ -695,6 +701,21 @@ const AFNodeManager::DataList& AFNodeManager::GetDataList() const
     return data_list_;
 }
 
+size_t AFNodeManager::GetMemUsage() const
+{
+    size_t size = sizeof(AFNodeManager) + data_list_.GetMemUsage();
+    for (auto& iter : data_list_)
+    {
+        auto pNode = iter.second;
+        if (pNode != nullptr)
+        {
+            size += pNode->GetMemUsage();
+        }
+    }
+
+    return size;
+}
+
 uint32_t AFNodeManager::GetIndex(const std::string& name) const
 {
     ARK_ASSERT_RET_VAL(class_meta_ != nullptr, NULL_INT);
@@ -710,6 +731,7 @@ AFINode* AFNodeManager::FindData(const uint32_t index)
         auto pDataMeta = class_meta_->FindDataMeta(index);
         ARK_ASSERT_RET_VAL(pDataMeta != nullptr, nullptr);
 
+        AFAllocTagScope alloc_scope(alloc_tag_);
         pData = CreateDataByMeta(pDataMeta);
         ARK_ASSERT_RET_VAL(pData != nullptr, nullptr);
 
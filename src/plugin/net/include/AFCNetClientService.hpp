@@ -46,6 +46,8 @@ public:
     //void Shutdown() override;
 
     bool RegMsgCallback(const int msg_id, const NET_MSG_FUNCTOR&& cb) override;
+    bool SetMsgMeta(const int msg_id, const AFNetMsgMeta& meta) override;
+    void GetMsgStats(std::vector<AFNetMsgStats>& stats) override;
     bool RegForwardMsgCallback(const NET_MSG_FUNCTOR&& cb) override;
     bool RegNetEventCallback(const NET_EVENT_FUNCTOR&& cb) override;
 
@@ -116,7 +118,7 @@ private:
 
     std::list<AFConnectionData> tmp_connections_;
 
-    std::map<int, NET_MSG_FUNCTOR> net_msg_callbacks_;
+    AFNetMsgHandlerTable net_msg_handlers_;
     std::list<NET_EVENT_FUNCTOR> net_event_callbacks_;
 
     // [NOT USE now] - forward to other processes
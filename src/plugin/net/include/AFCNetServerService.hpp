@@ -26,6 +26,7 @@
 #include "bus/interface/AFIMsgModule.hpp"
 #include "net/interface/AFINetServiceManagerModule.hpp"
 #include "net/interface/AFINetServerService.hpp"
+#include "net/include/AFNetMsgDispatcher.hpp"
 
 namespace ark {
 
@@ -36,17 +37,22 @@ public:
     //~AFCNetServerService() override;
 
     bool Start(const AFHeadLength len, const int bus_id, const AFEndpoint& ep, const uint8_t thread_count,
-        const uint32_t max_connection) override;
+        const uint32_t max_connection, const uint8_t logic_thread_count = 0) override;
     bool Update() override;
 
     std::shared_ptr<AFINet> GetNet() override;
+    AFHeadLength GetHeadLength() const override;
 
     bool RegMsgCallback(const int msg_id, NET_MSG_FUNCTOR&& cb) override;
+    bool SetMsgMeta(const int msg_id, const AFNetMsgMeta& meta) override;
+    void GetMsgStats(std::vector<AFNetMsgStats>& stats) override;
     bool RegForwardMsgCallback(NET_MSG_FUNCTOR&& cb) override;
     bool RegNetEventCallback(NET_EVENT_FUNCTOR&& cb) override;
+    bool RegActorFilter(NET_ACTOR_FILTER_FUNCTOR&& filter) override;
 
 protected:
     void OnNetMsg(const AFNetMsg* msg);
+    void HandleNetMsg(const AFNetMsg* msg);
     void OnNetEvent(const AFNetEvent* event);
 
     //void OnClientRegister(const AFNetMsg* msg, const int64_t session_id);
@@ -59,10 +65,15 @@ private:
     AFIMsgModule* m_pMsgModule;
 
     std::shared_ptr<AFINet> m_pNet{nullptr};
+    AFHeadLength head_len_{AFHeadLength::SS_HEAD_LENGTH};
 
-    std::map<int, NET_MSG_FUNCTOR> net_msg_callbacks_;
+    AFNetMsgHandlerTable net_msg_handlers_;
     std::list<NET_MSG_FUNCTOR> net_forward_msg_callbacks_;
     std::list<NET_EVENT_FUNCTOR> net_event_callbacks_;
+    NET_ACTOR_FILTER_FUNCTOR actor_filter_{nullptr};
+
+    // declared after the callbacks, workers stop before the callbacks are destroyed
+    std::unique_ptr<AFNetMsgDispatcher> dispatcher_{nullptr};
 
     //AFMapEx<int, AFServerData> reg_clients_;
 };
@@ -58,11 +58,17 @@ public:
 
     std::shared_ptr<AFINetClientService> GetClientService(const ARK_APP_TYPE app_type) override;
 
+    std::shared_ptr<AFNetFrameBudget> GetFrameBudget() override;
+
+    void SetLowPriorityMsg(const uint16_t msg_id, NET_COALESCE_KEY_FUNCTOR&& key_functor) override;
+    void InitSendPolicy(std::shared_ptr<AFINet> net) override;
+
 protected:
     ananas::Future<std::pair<bool, std::string>> RegisterToConsul(const int bus_id);
     int DeregisterFromConsul(const int bus_id);
 
     void HealthCheck(uint64_t timer_id, const AFGUID& entity_id);
+    void ReportNetStats(uint64_t timer_id, const AFGUID& entity_id);
 
     bool CreateClientService(const AFBusAddr& bus_addr, const std::string& ip, uint16_t port);
 
@@ -80,6 +86,10 @@ private:
     // All net relations, for finding AFINet
     AFSmartPtrMap<std::pair<int, int>, AFINet> net_bus_relations_;
 
+    std::shared_ptr<AFNetFrameBudget> frame_budget_{std::make_shared<AFNetFrameBudget>()};
+
+    std::unordered_map<uint16_t, NET_COALESCE_KEY_FUNCTOR> low_priority_msgs_;
+
     AFIBusModule* m_pBusModule;
     AFILogModule* m_pLogModule;
     AFIConsulModule* m_pConsulModule;
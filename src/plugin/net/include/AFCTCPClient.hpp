@@ -56,15 +56,18 @@ public:
 
     bool Shutdown() override final;
     bool SendMsg(AFMsgHead* head, const char* msg_data, const int64_t session_id) override;
+    bool SendMsgSpans(
+        AFMsgHead* head, const AFBufferSpan* body, const size_t body_count, const int64_t session_id) override;
 
     bool CloseSession(const AFGUID& session_id) override;
 
 protected:
     bool SendMsg(const char* msg, const size_t msg_len, const AFGUID& session_id = 0);
+    bool SendPacket(const AFNetPacketPtr& packet);
 
     void UpdateNetSession();
     void UpdateNetEvent(AFTCPSessionPtr session);
-    void UpdateNetMsg(AFTCPSessionPtr session);
+    void UpdateNetMsg(AFTCPSessionPtr session, AFNetFrameBudget& budget);
 
     bool CloseSession();
 
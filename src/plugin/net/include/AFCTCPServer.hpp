@@ -52,27 +52,60 @@ public:
     bool Shutdown() override final;
 
     bool SendMsg(AFMsgHead* head, const char* msg_data, const int64_t session_id) override;
+    bool SendMsgSpans(
+        AFMsgHead* head, const AFBufferSpan* body, const size_t body_count, const int64_t session_id) override;
     bool BroadcastMsg(AFMsgHead* head, const char* msg_data) override;
+    bool MulticastMsg(AFMsgHead* head, const char* msg_data, const std::vector<int64_t>& session_list) override;
 
     bool CloseSession(const int64_t& session_id) override;
 
+    size_t GetSendQueueSize(const int64_t session_id) override;
+    void GetSendStats(AFNetSendStats& stats) override;
+
 protected:
     bool SendMsgToAllClient(const char* msg, const size_t msg_len);
     bool SendMsg(const char* msg, const size_t msg_len, const int64_t& session_id);
+    // apply the send limit of the session, low priority messages may be coalesced or dropped while congested
+    bool SendPacket(AFTCPSessionPtr session, const AFMsgHead* head, const AFNetPacketPtr& packet);
+    void QueuePacket(AFTCPSessionPtr session, const AFNetPacketPtr& packet);
+    // watermark events are raised by the main thread, the session event queue has a single producer (io thread)
+    AFNetEvent* CreateSendEvent(AFTCPSessionPtr session, const AFNetEventType type);
 
     bool AddNetSession(AFTCPSessionPtr session);
     AFTCPSessionPtr GetNetSession(const int64_t& session_id);
     bool CloseSession(AFTCPSessionPtr& session);
 
+    // push the session to the ready queue if it is not there, called from io threads and main thread
+    void AddReadySession(AFTCPSessionPtr session);
     void UpdateNetSession();
+    // end congestion of drained sessions and send their coalesced messages
+    void UpdateCongestedSession();
     void UpdateNetEvent(AFTCPSessionPtr session);
-    void UpdateNetMsg(AFTCPSessionPtr session);
+    // handle at most max_count messages, return true if there are more
+    bool UpdateNetMsg(AFTCPSessionPtr session, const size_t max_count);
+    // handle all queued messages regardless of the budget, for a session being closed
+    void DrainNetMsg(AFTCPSessionPtr session);
 
     bool CloseAllSession();
 
 private:
     std::map<int64_t, AFTCPSessionPtr> sessions_;
     AFCReaderWriterLock rw_lock_;
+
+    // sessions with pending events or messages, only these are visited every frame
+    AFMpscQueue<int64_t> ready_sessions_;
+    std::vector<int64_t> ready_list_;
+    std::vector<AFTCPSessionPtr> active_list_;
+
+    // sessions above high watermark, only visited by main thread
+    std::vector<int64_t> congested_sessions_;
+    AFMpscQueue<int64_t> congest_sessions_;
+    std::vector<int64_t> congest_list_;
+    std::vector<AFNetEvent*> send_events_;
+    std::vector<AFNetSendQueue::CoalescedPacket> coalesced_packets_;
+    std::atomic<size_t> coalesced_count_{0};
+    std::atomic<size_t> dropped_count_{0};
+    std::atomic<size_t> kicked_count_{0};
     //int max_connection_{0}; // will use to limit the connection number
     int bus_id_{0};
 
@@ -62,7 +62,7 @@ protected:
 
     void UpdateNetSession();
     void UpdateNetEvent(AFHttpSessionPtr session);
-    void UpdateNetMsg(AFHttpSessionPtr session);
+    void UpdateNetMsg(AFHttpSessionPtr session, AFNetFrameBudget& budget);
 
     bool CloseSession();
 
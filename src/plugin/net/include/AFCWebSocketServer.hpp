@@ -69,7 +69,7 @@ protected:
 
     void UpdateNetSession();
     void UpdateNetEvent(AFHttpSessionPtr session);
-    void UpdateNetMsg(AFHttpSessionPtr session);
+    void UpdateNetMsg(AFHttpSessionPtr session, AFNetFrameBudget& budget);
 
     bool CloseAllSession();
 
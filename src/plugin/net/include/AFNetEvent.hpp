@@ -22,6 +22,7 @@
 
 #include "base/AFPlatform.hpp"
 #include "base/AFMacros.hpp"
+#include "net/include/AFNetMemPool.hpp"
 
 #pragma pack(push, 1)
 
@@ -33,6 +34,8 @@ enum class AFNetEventType : uint8_t
     CONNECTED = 1,
     DISCONNECTED = 2,
     RECV_DATA = 3,
+    SEND_HIGH_WATERMARK = 4, // outbound queue of the session is congested
+    SEND_LOW_WATERMARK = 5,  // outbound queue of the session is drained
 };
 
 class AFNetEvent final
@@ -40,12 +43,12 @@ class AFNetEvent final
 public:
     static AFNetEvent* AllocEvent()
     {
-        return ARK_NEW AFNetEvent();
+        return AFNetMemPool::New<AFNetEvent>();
     }
 
     static void Release(AFNetEvent*& event)
     {
-        ARK_DELETE(event);
+        AFNetMemPool::Delete(event);
     }
 
     AFNetEventType GetType() const
@@ -0,0 +1,109 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPlatform.hpp"
+
+namespace ark {
+
+// Time budget of inbound message processing in one frame.
+// Nets share one budget and handle messages of their sessions in small slices round robin until it runs out,
+// messages left are deferred to the next frame and counted here.
+class AFNetFrameBudget final
+{
+public:
+    static const int64_t DEFAULT_BUDGET = 2000; // us
+    static const size_t SLICE_MSG_COUNT = 16;   // messages of one session in one round
+
+    void SetBudget(const int64_t budget)
+    {
+        budget_ = (budget > 0 ? budget : DEFAULT_BUDGET);
+    }
+
+    int64_t GetBudget() const
+    {
+        return budget_;
+    }
+
+    // called once at the beginning of every frame
+    void Start()
+    {
+        if (deferred_session_count_ > 0)
+        {
+            ++deferred_frame_count_;
+        }
+
+        last_deferred_session_count_ = deferred_session_count_;
+        last_deferred_msg_count_ = deferred_msg_count_;
+        max_deferred_msg_count_ = std::max(max_deferred_msg_count_, deferred_msg_count_);
+
+        deferred_session_count_ = 0;
+        deferred_msg_count_ = 0;
+        deadline_ = std::chrono::steady_clock::now() + std::chrono::microseconds(budget_);
+    }
+
+    bool Expired() const
+    {
+        return std::chrono::steady_clock::now() >= deadline_;
+    }
+
+    void AddDeferred(const size_t msg_count)
+    {
+        ++deferred_session_count_;
+        deferred_msg_count_ += msg_count;
+    }
+
+    // backlog left by the last frame
+    size_t GetDeferredSessionCount() const
+    {
+        return last_deferred_session_count_;
+    }
+
+    size_t GetDeferredMsgCount() const
+    {
+        return last_deferred_msg_count_;
+    }
+
+    size_t GetMaxDeferredMsgCount() const
+    {
+        return max_deferred_msg_count_;
+    }
+
+    // frames that ran out of budget
+    uint64_t GetDeferredFrameCount() const
+    {
+        return deferred_frame_count_;
+    }
+
+private:
+    int64_t budget_{DEFAULT_BUDGET};
+    std::chrono::steady_clock::time_point deadline_{};
+
+    size_t deferred_session_count_{0};
+    size_t deferred_msg_count_{0};
+
+    size_t last_deferred_session_count_{0};
+    size_t last_deferred_msg_count_{0};
+    size_t max_deferred_msg_count_{0};
+    uint64_t deferred_frame_count_{0};
+};
+
+} // namespace ark
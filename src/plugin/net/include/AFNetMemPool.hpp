@@ -0,0 +1,303 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPlatform.hpp"
+#include "base/AFMacros.hpp"
+
+namespace ark {
+
+// Size class memory pool for net messages and events.
+//
+// Every thread allocates from its own cache, a chunk freed by another thread is pushed back to the lock-free
+// remote list of the cache it came from and is picked up by the owner when its local list runs empty.
+// Size classes are 64, 128 ... 8K bytes which covers ARK_MSG_MAX_LENGTH, larger chunks go to the heap directly.
+class AFNetMemPool final
+{
+public:
+    static const size_t MIN_CHUNK_SIZE = 64;
+    static const size_t SIZE_CLASS_COUNT = 8;    // 64 ~ 8K
+    static const size_t MAX_CACHE_COUNT = 1024; // cached chunks of one size class in one thread
+    static const size_t HEAP_CLASS = SIZE_CLASS_COUNT;
+
+    struct Stats
+    {
+        size_t chunk_size_{0};
+        uint64_t hit_count_{0};  // served from cache
+        uint64_t miss_count_{0}; // served from heap
+        int64_t outstanding_{0}; // allocated and not freed yet
+    };
+
+    static void* Alloc(size_t size)
+    {
+        size_t size_class = GetSizeClass(size);
+        if (size_class == HEAP_CLASS)
+        {
+            ChunkHead* chunk = NewChunk(size);
+            ARK_ASSERT_RET_VAL(chunk != nullptr, nullptr);
+
+            chunk->size_class_ = HEAP_CLASS;
+            return chunk + 1;
+        }
+
+        ThreadCache* cache = GetThreadCache();
+        ChunkHead* chunk = cache->Pop(size_class);
+        if (chunk != nullptr)
+        {
+            Increase(cache->hit_count_[size_class]);
+        }
+        else
+        {
+            chunk = NewChunk(MIN_CHUNK_SIZE << size_class);
+            ARK_ASSERT_RET_VAL(chunk != nullptr, nullptr);
+
+            chunk->owner_ = cache;
+            chunk->size_class_ = size_class;
+            Increase(cache->miss_count_[size_class]);
+        }
+
+        Increase(cache->alloc_count_[size_class]);
+        return chunk + 1;
+    }
+
+    static void Free(void* ptr)
+    {
+        if (ptr == nullptr)
+        {
+            return;
+        }
+
+        ChunkHead* chunk = static_cast<ChunkHead*>(ptr) - 1;
+        size_t size_class = chunk->size_class_;
+        if (size_class == HEAP_CLASS)
+        {
+            ::operator delete(chunk);
+            return;
+        }
+
+        ThreadCache* cache = GetThreadCache();
+        Increase(cache->free_count_[size_class]);
+
+        if (chunk->owner_ != cache)
+        {
+            chunk->owner_->PushRemote(chunk);
+        }
+        else if (!cache->Push(chunk))
+        {
+            ::operator delete(chunk);
+        }
+    }
+
+    template<typename T, typename... Args>
+    static T* New(Args&&... args)
+    {
+        void* ptr = Alloc(sizeof(T));
+        ARK_ASSERT_RET_VAL(ptr != nullptr, nullptr);
+
+        return new (ptr) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    static void Delete(T*& obj)
+    {
+        if (obj != nullptr)
+        {
+            obj->~T();
+            Free(obj);
+            obj = nullptr;
+        }
+    }
+
+    // counters of all threads by size class
+    static void GetStats(std::vector<Stats>& stats)
+    {
+        stats.clear();
+        stats.resize(SIZE_CLASS_COUNT);
+        for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+        {
+            stats[i].chunk_size_ = MIN_CHUNK_SIZE << i;
+        }
+
+        CacheRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> guard(registry.mutex_);
+        for (auto cache : registry.cache_list_)
+        {
+            for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i)
+            {
+                stats[i].hit_count_ += cache->hit_count_[i].load(std::memory_order_relaxed);
+                stats[i].miss_count_ += cache->miss_count_[i].load(std::memory_order_relaxed);
+                stats[i].outstanding_ += static_cast<int64_t>(cache->alloc_count_[i].load(std::memory_order_relaxed));
+                stats[i].outstanding_ -= static_cast<int64_t>(cache->free_count_[i].load(std::memory_order_relaxed));
+            }
+        }
+    }
+
+private:
+    class ThreadCache;
+
+    struct alignas(16) ChunkHead
+    {
+        ThreadCache* owner_{nullptr};
+        ChunkHead* next_{nullptr};
+        size_t size_class_{0};
+    };
+
+    class ThreadCache final
+    {
+    public:
+        ChunkHead* Pop(size_t size_class)
+        {
+            auto& free_list = free_list_[size_class];
+            if (free_list.empty())
+            {
+                // take back everything other threads returned
+                ChunkHead* chunk = remote_list_[size_class].exchange(nullptr, std::memory_order_acquire);
+                while (chunk != nullptr)
+                {
+                    ChunkHead* next = chunk->next_;
+                    if (!Push(chunk))
+                    {
+                        ::operator delete(chunk);
+                    }
+
+                    chunk = next;
+                }
+
+                if (free_list.empty())
+                {
+                    return nullptr;
+                }
+            }
+
+            ChunkHead* chunk = free_list.back();
+            free_list.pop_back();
+            return chunk;
+        }
+
+        bool Push(ChunkHead* chunk)
+        {
+            auto& free_list = free_list_[chunk->size_class_];
+            if (free_list.size() >= MAX_CACHE_COUNT)
+            {
+                return false;
+            }
+
+            free_list.push_back(chunk);
+            return true;
+        }
+
+        void PushRemote(ChunkHead* chunk)
+        {
+            auto& remote_list = remote_list_[chunk->size_class_];
+            chunk->next_ = remote_list.load(std::memory_order_relaxed);
+            while (!remote_list.compare_exchange_weak(
+                chunk->next_, chunk, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        std::vector<ChunkHead*> free_list_[SIZE_CLASS_COUNT];
+        std::atomic<ChunkHead*> remote_list_[SIZE_CLASS_COUNT]{};
+
+        // written by the owner thread only
+        std::atomic<uint64_t> hit_count_[SIZE_CLASS_COUNT]{};
+        std::atomic<uint64_t> miss_count_[SIZE_CLASS_COUNT]{};
+        std::atomic<uint64_t> alloc_count_[SIZE_CLASS_COUNT]{};
+        std::atomic<uint64_t> free_count_[SIZE_CLASS_COUNT]{};
+    };
+
+    // caches live as long as the process, chunks may be freed after their thread exits.
+    // the cache of an exited thread is handed to the next new thread
+    struct CacheRegistry
+    {
+        std::mutex mutex_;
+        std::vector<ThreadCache*> cache_list_;
+        std::vector<ThreadCache*> idle_list_;
+    };
+
+    class CacheHolder final
+    {
+    public:
+        CacheHolder()
+        {
+            CacheRegistry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex_);
+            if (!registry.idle_list_.empty())
+            {
+                cache_ = registry.idle_list_.back();
+                registry.idle_list_.pop_back();
+            }
+            else
+            {
+                cache_ = ARK_NEW ThreadCache();
+                registry.cache_list_.push_back(cache_);
+            }
+        }
+
+        ~CacheHolder()
+        {
+            CacheRegistry& registry = GetRegistry();
+            std::lock_guard<std::mutex> guard(registry.mutex_);
+            registry.idle_list_.push_back(cache_);
+        }
+
+        ThreadCache* cache_{nullptr};
+    };
+
+    static CacheRegistry& GetRegistry()
+    {
+        // never destroyed, thread exit may run after static destruction
+        static CacheRegistry* registry = ARK_NEW CacheRegistry();
+        return *registry;
+    }
+
+    static ThreadCache* GetThreadCache()
+    {
+        thread_local CacheHolder holder;
+        return holder.cache_;
+    }
+
+    static size_t GetSizeClass(size_t size)
+    {
+        size_t size_class = 0;
+        size_t chunk_size = MIN_CHUNK_SIZE;
+        while (chunk_size < size && size_class < HEAP_CLASS)
+        {
+            chunk_size <<= 1;
+            ++size_class;
+        }
+
+        return size_class;
+    }
+
+    static ChunkHead* NewChunk(size_t size)
+    {
+        void* ptr = ::operator new(sizeof(ChunkHead) + size, std::nothrow);
+        return (ptr != nullptr ? new (ptr) ChunkHead() : nullptr);
+    }
+
+    static void Increase(std::atomic<uint64_t>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+} // namespace ark
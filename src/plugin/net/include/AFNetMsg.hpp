@@ -23,6 +23,8 @@
 #include "base/AFPlatform.hpp"
 #include "base/AFMacros.hpp"
 #include "base/AFNoncopyable.hpp"
+#include "net/include/AFNetMemPool.hpp"
+#include "net/include/AFNetRecvBlock.hpp"
 
 #pragma pack(push, 1)
 
@@ -32,7 +34,6 @@ ARK_CONSTEXPR static const int ARK_TCP_RECV_BUFFER_SIZE = 10 * 1024 * 1024;
 ARK_CONSTEXPR static const int ARK_HTTP_RECV_BUFFER_SIZE = 1024 * 1024;                        // 1M
 ARK_CONSTEXPR static const std::chrono::seconds ARK_CONNECT_TIMEOUT = std::chrono::seconds(5); // 5s
 ARK_CONSTEXPR static const std::chrono::seconds ARK_NET_HEART_TIME = std::chrono::seconds(30); // 30s
-ARK_CONSTEXPR static const int ARK_PROCESS_NET_MSG_COUNT_ONCE = 100;
 ARK_CONSTEXPR static const int ARK_MSG_MAX_LENGTH = 1024 * 5; // 5K
 
 enum class AFHeadLength : uint32_t
@@ -41,6 +42,10 @@ enum class AFHeadLength : uint32_t
     SS_HEAD_LENGTH = 22, // ss head
 };
 
+// a partial message is carried over to a new receive block, so one block must hold the largest message
+static_assert(AFNetRecvBlock::BLOCK_SIZE > static_cast<size_t>(AFHeadLength::SS_HEAD_LENGTH) + ARK_MSG_MAX_LENGTH,
+    "receive block is too small");
+
 class AFMsgHead
 {
 public:
@@ -83,17 +88,64 @@ public:
 
     static AFNetMsg* AllocMsg(uint32_t len)
     {
-        AFNetMsg* msg = ARK_NEW AFNetMsg();
+        AFNetMsg* msg = AFNetMemPool::New<AFNetMsg>();
+        ARK_ASSERT_RET_VAL(msg != nullptr, nullptr);
+
         msg->AllocData(len);
         return msg;
     }
 
+    // frame the message at the read position of a receive block, the body stays in the block
+    static AFNetMsg* AllocMsg(AFNetRecvBlock* block, uint32_t head_len)
+    {
+        ARK_ASSERT_RET_VAL(block != nullptr && block->GetLength() >= head_len, nullptr);
+
+        AFNetMsg* msg = AFNetMemPool::New<AFNetMsg>();
+        ARK_ASSERT_RET_VAL(msg != nullptr, nullptr);
+
+        memcpy(reinterpret_cast<char*>(&msg->head_), block->GetReadPtr(), head_len);
+        if (msg->head_.length_ > 0)
+        {
+            block->AddRef();
+            msg->block_ = block;
+            msg->msg_data_ = block->GetReadPtr() + head_len;
+        }
+
+        return msg;
+    }
+
+    // a body in a receive block is shared instead of copied
+    static AFNetMsg* Clone(const AFNetMsg* msg)
+    {
+        ARK_ASSERT_RET_VAL(msg != nullptr, nullptr);
+
+        if (msg->block_ == nullptr)
+        {
+            AFNetMsg* new_msg = AllocMsg(msg->GetMsgLength());
+            ARK_ASSERT_RET_VAL(new_msg != nullptr, nullptr);
+
+            new_msg->CopyFrom(const_cast<AFNetMsg*>(msg));
+            new_msg->session_id_ = msg->session_id_;
+            return new_msg;
+        }
+
+        AFNetMsg* new_msg = AFNetMemPool::New<AFNetMsg>();
+        ARK_ASSERT_RET_VAL(new_msg != nullptr, nullptr);
+
+        msg->block_->AddRef();
+        new_msg->head_ = msg->head_;
+        new_msg->block_ = msg->block_;
+        new_msg->msg_data_ = msg->msg_data_;
+        new_msg->session_id_ = msg->session_id_;
+        return new_msg;
+    }
+
     static void Release(AFNetMsg*& msg)
     {
         if (msg != nullptr)
         {
             msg->DeallocData();
-            ARK_DELETE(msg);
+            AFNetMemPool::Delete(msg);
         }
     }
 
@@ -141,6 +193,12 @@ public:
         return head_.dst_bus_;
     }
 
+    // the session the message was received from
+    int64_t GetSessionId() const
+    {
+        return session_id_;
+    }
+
     void SetMsgId(uint16_t value)
     {
         head_.id_ = value;
@@ -166,6 +224,11 @@ public:
         head_.dst_bus_ = value;
     }
 
+    void SetSessionId(int64_t value)
+    {
+        session_id_ = value;
+    }
+
     char* GetMsgData() const
     {
         return msg_data_;
@@ -181,15 +244,24 @@ protected:
     {
         if (len > 0)
         {
-            msg_data_ = ARK_NEW char[len];
+            msg_data_ = static_cast<char*>(AFNetMemPool::Alloc(len));
         }
     }
 
     void DeallocData()
     {
-        if (msg_data_ != nullptr)
+        if (block_ != nullptr)
+        {
+            // the body belongs to the receive block, the member is packed so release through a local
+            AFNetRecvBlock* block = block_;
+            AFNetRecvBlock::Release(block);
+            block_ = nullptr;
+            msg_data_ = nullptr;
+        }
+        else if (msg_data_ != nullptr)
         {
-            ARK_DELETE_ARRAY(char, msg_data_);
+            AFNetMemPool::Free(msg_data_);
+            msg_data_ = nullptr;
         }
 
         head_.length_ = 0;
@@ -198,6 +270,8 @@ protected:
 private:
     AFSSMsgHead head_;
     char* msg_data_{nullptr};
+    AFNetRecvBlock* block_{nullptr};
+    int64_t session_id_{0};
 };
 
 } // namespace ark
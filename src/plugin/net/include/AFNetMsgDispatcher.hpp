@@ -0,0 +1,137 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <condition_variable>
+
+#include "base/AFPlatform.hpp"
+#include "base/AFMacros.hpp"
+#include "net/interface/AFINet.hpp"
+
+namespace ark {
+
+// Dispatch messages to logic worker threads by actor id.
+// All messages of one actor go to the same worker and are handled in arrival order,
+// different actors are handled in parallel, so the handlers must be thread safe.
+class AFNetMsgDispatcher final
+{
+public:
+    AFNetMsgDispatcher(const size_t thread_count, NET_MSG_FUNCTOR&& handler)
+        : handler_(std::move(handler))
+    {
+        for (size_t i = 0; i < std::max<size_t>(thread_count, 1); ++i)
+        {
+            auto worker = std::make_unique<Worker>();
+            worker->thread_ = std::thread(&AFNetMsgDispatcher::Run, this, worker.get());
+            workers_.emplace_back(std::move(worker));
+        }
+    }
+
+    ~AFNetMsgDispatcher()
+    {
+        Stop();
+    }
+
+    // take the ownership of the message
+    void Dispatch(AFNetMsg* msg)
+    {
+        ARK_ASSERT_RET_NONE(msg != nullptr);
+
+        // mix the actor id, guid low bits are often sequential
+        uint64_t hash = static_cast<uint64_t>(msg->GetActorId()) * 0x9E3779B97F4A7C15ULL;
+        auto& worker = workers_[(hash >> 32) % workers_.size()];
+
+        {
+            std::lock_guard<std::mutex> guard(worker->mutex_);
+            worker->msg_list_.push_back(msg);
+        }
+
+        worker->cond_.notify_one();
+    }
+
+    // handle the queued messages and join the workers
+    void Stop()
+    {
+        for (auto& worker : workers_)
+        {
+            {
+                std::lock_guard<std::mutex> guard(worker->mutex_);
+                worker->stop_ = true;
+            }
+
+            worker->cond_.notify_one();
+        }
+
+        for (auto& worker : workers_)
+        {
+            if (worker->thread_.joinable())
+            {
+                worker->thread_.join();
+            }
+        }
+    }
+
+    size_t GetThreadCount() const
+    {
+        return workers_.size();
+    }
+
+private:
+    struct Worker
+    {
+        std::thread thread_;
+        std::mutex mutex_;
+        std::condition_variable cond_;
+        std::vector<AFNetMsg*> msg_list_;
+        bool stop_{false};
+    };
+
+    void Run(Worker* worker)
+    {
+        std::vector<AFNetMsg*> handle_list;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(worker->mutex_);
+                worker->cond_.wait(lock, [worker]() { return worker->stop_ || !worker->msg_list_.empty(); });
+                if (worker->msg_list_.empty())
+                {
+                    break;
+                }
+
+                handle_list.swap(worker->msg_list_);
+            }
+
+            for (auto msg : handle_list)
+            {
+                handler_(msg);
+                AFNetMsg::Release(msg);
+            }
+
+            handle_list.clear();
+        }
+    }
+
+    NET_MSG_FUNCTOR handler_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+};
+
+} // namespace ark
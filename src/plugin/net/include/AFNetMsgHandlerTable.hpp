@@ -0,0 +1,284 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <array>
+
+#include "base/AFPlatform.hpp"
+#include "base/AFMacros.hpp"
+#include "net/interface/AFINet.hpp"
+
+namespace ark {
+
+// expected traffic of one message id, messages out of it are rejected before the handler
+class AFNetMsgMeta
+{
+public:
+    uint32_t min_length_{0};
+    uint32_t max_length_{ARK_MSG_MAX_LENGTH};
+    uint32_t rate_limit_{0}; // messages per second of one sender, 0 means no limit
+};
+
+class AFNetMsgStats
+{
+public:
+    uint16_t msg_id_{0};
+    uint64_t count_{0};
+    uint64_t bytes_{0};
+    uint64_t handle_time_{0}; // us
+    uint64_t reject_count_{0};
+};
+
+// Message handlers indexed by message id.
+// Two level table of 256 pages with 256 entries, a page is allocated when the first id in it is registered.
+// Register at init, handling and counters are safe from several threads.
+// Rate is limited per sender, the actor of the message or the session if it has no actor, so a flooding client
+// only gets its own messages rejected.
+class AFNetMsgHandlerTable final
+{
+public:
+    enum class Result : uint8_t
+    {
+        HANDLED = 0,
+        UNKNOWN = 1,  // no handler
+        REJECTED = 2, // length or rate out of meta
+        FLOODED = 3,  // far beyond the rate limit, the sender should be disconnected
+    };
+
+    static const uint32_t FLOOD_FACTOR = 4; // times of rate limit in one second
+
+    bool Register(const int msg_id, NET_MSG_FUNCTOR&& cb)
+    {
+        ARK_ASSERT_RET_VAL(msg_id >= 0 && msg_id <= std::numeric_limits<uint16_t>::max(), false);
+
+        auto& page = pages_[msg_id >> PAGE_SHIFT];
+        if (page == nullptr)
+        {
+            page = std::make_unique<Page>();
+        }
+
+        auto& entry = (*page)[msg_id & PAGE_MASK];
+        if (entry.cb_)
+        {
+            return false;
+        }
+
+        entry.cb_ = std::move(cb);
+        return true;
+    }
+
+    bool SetMeta(const int msg_id, const AFNetMsgMeta& meta)
+    {
+        ARK_ASSERT_RET_VAL(msg_id >= 0 && msg_id <= std::numeric_limits<uint16_t>::max(), false);
+
+        Entry* entry = Find(static_cast<uint16_t>(msg_id));
+        if (entry == nullptr)
+        {
+            return false;
+        }
+
+        entry->meta_ = meta;
+        return true;
+    }
+
+    Result Handle(const AFNetMsg* msg)
+    {
+        Entry* entry = Find(msg->GetMsgId());
+        if (entry == nullptr)
+        {
+            unknown_count_.fetch_add(1, std::memory_order_relaxed);
+            return Result::UNKNOWN;
+        }
+
+        uint32_t len = msg->GetMsgLength();
+        if (len < entry->meta_.min_length_ || len > entry->meta_.max_length_)
+        {
+            entry->reject_count_.fetch_add(1, std::memory_order_relaxed);
+            return Result::REJECTED;
+        }
+
+        uint32_t rate_limit = entry->meta_.rate_limit_;
+        if (rate_limit > 0)
+        {
+            int64_t sender = (msg->GetActorId() != 0 ? msg->GetActorId() : msg->GetSessionId());
+            uint32_t rate_count = CountRate(msg->GetMsgId(), sender);
+            if (rate_count > rate_limit)
+            {
+                entry->reject_count_.fetch_add(1, std::memory_order_relaxed);
+                return (rate_count > rate_limit * FLOOD_FACTOR ? Result::FLOODED : Result::REJECTED);
+            }
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        entry->cb_(msg);
+        auto cost = std::chrono::steady_clock::now() - begin;
+
+        entry->count_.fetch_add(1, std::memory_order_relaxed);
+        entry->bytes_.fetch_add(len, std::memory_order_relaxed);
+        entry->handle_time_.fetch_add(
+            std::chrono::duration_cast<std::chrono::microseconds>(cost).count(), std::memory_order_relaxed);
+        return Result::HANDLED;
+    }
+
+    // counters of registered ids
+    void GetStats(std::vector<AFNetMsgStats>& stats) const
+    {
+        stats.clear();
+        for (size_t page_index = 0; page_index < PAGE_COUNT; ++page_index)
+        {
+            const auto& page = pages_[page_index];
+            if (page == nullptr)
+            {
+                continue;
+            }
+
+            for (size_t i = 0; i < PAGE_SIZE; ++i)
+            {
+                const Entry& entry = (*page)[i];
+                if (!entry.cb_)
+                {
+                    continue;
+                }
+
+                AFNetMsgStats item;
+                item.msg_id_ = static_cast<uint16_t>((page_index << PAGE_SHIFT) | i);
+                item.count_ = entry.count_.load(std::memory_order_relaxed);
+                item.bytes_ = entry.bytes_.load(std::memory_order_relaxed);
+                item.handle_time_ = entry.handle_time_.load(std::memory_order_relaxed);
+                item.reject_count_ = entry.reject_count_.load(std::memory_order_relaxed);
+                stats.push_back(item);
+            }
+        }
+    }
+
+    uint64_t GetUnknownCount() const
+    {
+        return unknown_count_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static const size_t PAGE_SHIFT = 8;
+    static const size_t PAGE_SIZE = 1 << PAGE_SHIFT;
+    static const size_t PAGE_MASK = PAGE_SIZE - 1;
+    static const size_t PAGE_COUNT = 1 << (16 - PAGE_SHIFT);
+
+    struct Entry
+    {
+        NET_MSG_FUNCTOR cb_;
+        AFNetMsgMeta meta_;
+
+        std::atomic<uint64_t> count_{0};
+        std::atomic<uint64_t> bytes_{0};
+        std::atomic<uint64_t> handle_time_{0};
+        std::atomic<uint64_t> reject_count_{0};
+
+    };
+
+    struct RateKey
+    {
+        int64_t sender_{0};
+        uint16_t msg_id_{0};
+
+        bool operator==(const RateKey& other) const
+        {
+            return sender_ == other.sender_ && msg_id_ == other.msg_id_;
+        }
+    };
+
+    struct RateKeyHash
+    {
+        size_t operator()(const RateKey& key) const
+        {
+            return std::hash<uint64_t>()(static_cast<uint64_t>(key.sender_) * 0x9E3779B97F4A7C15ULL ^ key.msg_id_);
+        }
+    };
+
+    // count of one sender in the current second
+    struct RateWindow
+    {
+        int64_t window_{0};
+        uint32_t count_{0};
+    };
+
+    // senders are spread over shards to keep workers apart, stale windows are swept once a second when it grows
+    struct RateShard
+    {
+        std::mutex mutex_;
+        std::unordered_map<RateKey, RateWindow, RateKeyHash> windows_;
+        int64_t sweep_window_{0};
+    };
+
+    static const size_t RATE_SHARD_COUNT = 16;
+    static const size_t RATE_SWEEP_SIZE = 1024;
+
+    using Page = std::array<Entry, PAGE_SIZE>;
+
+    Entry* Find(const uint16_t msg_id)
+    {
+        auto& page = pages_[msg_id >> PAGE_SHIFT];
+        if (page == nullptr)
+        {
+            return nullptr;
+        }
+
+        Entry& entry = (*page)[msg_id & PAGE_MASK];
+        return (entry.cb_ ? &entry : nullptr);
+    }
+
+    // return the count of the sender in current second including this one
+    uint32_t CountRate(const uint16_t msg_id, const int64_t sender)
+    {
+        auto now_time = std::chrono::steady_clock::now().time_since_epoch();
+        int64_t now = std::chrono::duration_cast<std::chrono::seconds>(now_time).count();
+
+        RateKey key;
+        key.sender_ = sender;
+        key.msg_id_ = msg_id;
+        size_t hash = RateKeyHash()(key);
+        RateShard& shard = rate_shards_[(hash >> 32) % RATE_SHARD_COUNT];
+
+        std::lock_guard<std::mutex> guard(shard.mutex_);
+        if (shard.windows_.size() >= RATE_SWEEP_SIZE && shard.sweep_window_ != now)
+        {
+            shard.sweep_window_ = now;
+            for (auto iter = shard.windows_.begin(); iter != shard.windows_.end();)
+            {
+                iter = (iter->second.window_ != now ? shard.windows_.erase(iter) : std::next(iter));
+            }
+        }
+
+        RateWindow& window = shard.windows_[key];
+        if (window.window_ != now)
+        {
+            window.window_ = now;
+            window.count_ = 0;
+        }
+
+        return ++window.count_;
+    }
+
+    std::array<std::unique_ptr<Page>, PAGE_COUNT> pages_;
+    std::atomic<uint64_t> unknown_count_{0};
+
+    std::array<RateShard, RATE_SHARD_COUNT> rate_shards_;
+};
+
+} // namespace ark
@@ -0,0 +1,159 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPlatform.hpp"
+#include "base/AFMacros.hpp"
+
+namespace ark {
+
+// Pooled receive block, messages framed from it refer to their body inside the block instead of copying it.
+// The session writing into the block holds one reference and every message sliced from it holds another,
+// the block goes back to the pool when the last reference is released.
+class AFNetRecvBlock final
+{
+public:
+    static const size_t BLOCK_SIZE = 16 * 1024; // 16K
+    static const size_t MAX_POOL_COUNT = 4096;  // cached free blocks, 64M at most
+
+    static AFNetRecvBlock* Alloc()
+    {
+        AFNetRecvBlock* block = GetPool().Pop();
+        if (block == nullptr)
+        {
+            block = ARK_NEW AFNetRecvBlock();
+            ARK_ASSERT_RET_VAL(block != nullptr, nullptr);
+        }
+
+        block->ref_count_.store(1, std::memory_order_relaxed);
+        block->read_pos_ = 0;
+        block->write_pos_ = 0;
+        return block;
+    }
+
+    static void Release(AFNetRecvBlock*& block)
+    {
+        if (block == nullptr)
+        {
+            return;
+        }
+
+        if (block->ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1 && !GetPool().Push(block))
+        {
+            ARK_DELETE(block);
+        }
+
+        block = nullptr;
+    }
+
+    void AddRef()
+    {
+        ref_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // write as much as the block can hold, return the written length
+    size_t Write(const char* data, size_t len)
+    {
+        size_t write_len = std::min(len, GetFreeSize());
+        if (write_len > 0)
+        {
+            memcpy(data_ + write_pos_, data, write_len);
+            write_pos_ += write_len;
+        }
+
+        return write_len;
+    }
+
+    void Consume(size_t len)
+    {
+        read_pos_ = std::min(read_pos_ + len, write_pos_);
+    }
+
+    char* GetReadPtr()
+    {
+        return data_ + read_pos_;
+    }
+
+    size_t GetLength() const
+    {
+        return write_pos_ - read_pos_;
+    }
+
+    size_t GetFreeSize() const
+    {
+        return BLOCK_SIZE - write_pos_;
+    }
+
+private:
+    class BlockPool final
+    {
+    public:
+        ~BlockPool()
+        {
+            for (auto block : free_list_)
+            {
+                ARK_DELETE(block);
+            }
+        }
+
+        AFNetRecvBlock* Pop()
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (free_list_.empty())
+            {
+                return nullptr;
+            }
+
+            AFNetRecvBlock* block = free_list_.back();
+            free_list_.pop_back();
+            return block;
+        }
+
+        bool Push(AFNetRecvBlock* block)
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (free_list_.size() >= MAX_POOL_COUNT)
+            {
+                return false;
+            }
+
+            free_list_.push_back(block);
+            return true;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::vector<AFNetRecvBlock*> free_list_;
+    };
+
+    static BlockPool& GetPool()
+    {
+        static BlockPool pool;
+        return pool;
+    }
+
+    std::atomic<uint32_t> ref_count_{0};
+    size_t read_pos_{0};
+    size_t write_pos_{0};
+    char data_[BLOCK_SIZE];
+};
+
+} // namespace ark
@@ -0,0 +1,216 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPlatform.hpp"
+
+namespace ark {
+
+// framed message, the net library queues the pointer itself and gathers queued packets into one writev
+using AFNetPacketPtr = std::shared_ptr<std::string>;
+
+// contiguous piece of a message body, framed behind the head when sending
+struct AFBufferSpan
+{
+    const char* data_{nullptr};
+    size_t len_{0};
+};
+
+// Per thread ring of packets to frame messages in.
+// A packet is reused once the net library and the send queues have released it, so framing does not allocate after
+// warm up. Packets still in flight are left to their holders and replaced in the ring by a new one.
+class AFNetPacketPool final
+{
+public:
+    static const size_t POOL_SIZE = 256;
+    static const size_t MAX_KEEP_CAPACITY = 64 * 1024; // larger buffers are released instead of kept
+
+    // the packet is empty with at least len reserved
+    static AFNetPacketPtr Alloc(const size_t len)
+    {
+        thread_local AFNetPacketPool pool;
+        return pool.Take(len);
+    }
+
+private:
+    AFNetPacketPtr Take(const size_t len)
+    {
+        AFNetPacketPtr& slot = packets_[next_];
+        next_ = (next_ + 1) % POOL_SIZE;
+
+        if (slot != nullptr && slot.use_count() == 1 && slot->capacity() <= MAX_KEEP_CAPACITY)
+        {
+            // the last holder released it on io thread, its reads happened before the release
+            std::atomic_thread_fence(std::memory_order_acquire);
+            slot->clear();
+        }
+        else
+        {
+            slot = std::make_shared<std::string>();
+        }
+
+        slot->reserve(len);
+        return slot;
+    }
+
+    std::array<AFNetPacketPtr, POOL_SIZE> packets_;
+    size_t next_{0};
+};
+
+// outbound limits of one session, in bytes handed to the net library but not written to the socket yet
+class AFNetSendLimit
+{
+public:
+    size_t low_watermark_{1024 * 1024};      // congestion ends below it, coalesced messages are sent again
+    size_t high_watermark_{4 * 1024 * 1024}; // congestion starts above it, low priority messages are coalesced
+    size_t hard_limit_{64 * 1024 * 1024};    // the session is disconnected as a slow consumer above it
+};
+
+class AFNetSendStats
+{
+public:
+    size_t queue_size_{0};      // bytes queued of all sessions
+    size_t max_queue_size_{0};  // bytes queued of the deepest session
+    size_t congested_count_{0}; // sessions above high watermark
+    size_t coalesced_count_{0}; // low priority messages replaced by a newer one
+    size_t dropped_count_{0};   // low priority messages dropped as the coalesce table was full
+    size_t kicked_count_{0};    // sessions disconnected past the hard limit
+};
+
+// Outbound state of one session.
+// The queued size grows when a packet is handed to the net library and shrinks in its sent callback on io thread,
+// callbacks hold the queue so it may outlive the session.
+// While congested, low priority messages are not sent but kept per msg id, actor id and the entity they are about,
+// a newer one replaces the older, they are sent again when the queue drains below low watermark.
+class AFNetSendQueue final
+{
+public:
+    enum class Result : uint8_t
+    {
+        SEND = 0,      // not congested, send it now
+        COALESCED = 1, // kept until congestion ends
+        REPLACED = 2,  // replaced an older one of the same msg id, actor id and entity
+        DROPPED = 3,   // coalesce table is full
+    };
+
+    static const size_t MAX_COALESCE_COUNT = 256;
+
+    struct CoalescedPacket
+    {
+        uint16_t msg_id_{0};
+        int64_t actor_id_{0};
+        int64_t entity_id_{0};
+        AFNetPacketPtr packet_{nullptr};
+    };
+
+    size_t GetQueueSize() const
+    {
+        return queue_size_.load(std::memory_order_acquire) + coalesced_size_.load(std::memory_order_acquire);
+    }
+
+    // return true if the queue crosses high watermark and becomes congested
+    bool AddQueued(const size_t len, const AFNetSendLimit& limit)
+    {
+        size_t queue_size = queue_size_.fetch_add(len, std::memory_order_acq_rel) + len;
+        return (queue_size > limit.high_watermark_ && !congested_.exchange(true, std::memory_order_acq_rel));
+    }
+
+    // called in sent callback of the net library
+    void RemoveQueued(const size_t len)
+    {
+        queue_size_.fetch_sub(len, std::memory_order_acq_rel);
+    }
+
+    bool IsCongested() const
+    {
+        return congested_.load(std::memory_order_acquire);
+    }
+
+    // return true if the queue is drained below low watermark and leaves congestion, the kept packets are moved out
+    bool EndCongest(const AFNetSendLimit& limit, std::vector<CoalescedPacket>& packets)
+    {
+        if (!IsCongested() || queue_size_.load(std::memory_order_acquire) > limit.low_watermark_)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        packets.swap(coalesced_);
+        coalesced_.clear();
+        coalesced_size_.store(0, std::memory_order_release);
+        congested_.store(false, std::memory_order_release);
+        return true;
+    }
+
+    Result Coalesce(
+        const uint16_t msg_id, const int64_t actor_id, const int64_t entity_id, const AFNetPacketPtr& packet)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (!IsCongested())
+        {
+            return Result::SEND;
+        }
+
+        for (auto& iter : coalesced_)
+        {
+            if (iter.msg_id_ == msg_id && iter.actor_id_ == actor_id && iter.entity_id_ == entity_id)
+            {
+                coalesced_size_.fetch_add(packet->size(), std::memory_order_acq_rel);
+                coalesced_size_.fetch_sub(iter.packet_->size(), std::memory_order_acq_rel);
+                iter.packet_ = packet;
+                return Result::REPLACED;
+            }
+        }
+
+        if (coalesced_.size() >= MAX_COALESCE_COUNT)
+        {
+            return Result::DROPPED;
+        }
+
+        CoalescedPacket item;
+        item.msg_id_ = msg_id;
+        item.actor_id_ = actor_id;
+        item.entity_id_ = entity_id;
+        item.packet_ = packet;
+        coalesced_.emplace_back(std::move(item));
+        coalesced_size_.fetch_add(packet->size(), std::memory_order_acq_rel);
+        return Result::COALESCED;
+    }
+
+    // return true only for the first time, a slow consumer is disconnected once
+    bool SetOverflow()
+    {
+        return !overflow_.exchange(true, std::memory_order_acq_rel);
+    }
+
+private:
+    std::atomic<size_t> queue_size_{0};
+    std::atomic<size_t> coalesced_size_{0};
+    std::atomic<bool> congested_{false};
+    std::atomic<bool> overflow_{false};
+
+    std::mutex mutex_;
+    std::vector<CoalescedPacket> coalesced_;
+};
+
+using AFNetSendQueuePtr = std::shared_ptr<AFNetSendQueue>;
+
+} // namespace ark
@@ -27,10 +27,11 @@
 
 #include "base/AFMacros.hpp"
 #include "base/AFNoncopyable.hpp"
-#include "base/AFBuffer.hpp"
 #include "base/AFRWLock.hpp"
 #include "base/AFLockFreeQueue.hpp"
 #include "net/include/AFNetMsg.hpp"
+#include "net/include/AFNetEvent.hpp"
+#include "net/include/AFNetSendQueue.hpp"
 
 namespace ark {
 
@@ -48,6 +49,7 @@ public:
     virtual ~AFNetSession()
     {
         ReleaseQueueData();
+        AFNetRecvBlock::Release(recv_block_);
     }
 
     void ReleaseQueueData()
@@ -80,29 +82,52 @@ public:
 
     int AddBuffer(const char* data, size_t len)
     {
-        buffer_.write(data, len);
-        return (int)buffer_.get_length();
+        while (len > 0 && !broken_)
+        {
+            if (recv_block_ == nullptr)
+            {
+                recv_block_ = AFNetRecvBlock::Alloc();
+                ARK_ASSERT_RET_VAL(recv_block_ != nullptr, 0);
+            }
+            else if (recv_block_->GetFreeSize() == 0)
+            {
+                // block is full, frame what is complete and carry the partial message over
+                ParseBufferToMsg();
+                if (recv_block_ != nullptr && recv_block_->GetFreeSize() == 0 && !SwitchRecvBlock())
+                {
+                    break;
+                }
+
+                continue;
+            }
+
+            size_t write_len = recv_block_->Write(data, len);
+            data += write_len;
+            len -= write_len;
+        }
+
+        return (int)GetBufferLen();
     }
 
     size_t RemoveBuffer(size_t len)
     {
-        if (len > buffer_.get_length())
+        if (len > GetBufferLen())
         {
             return 0;
         }
 
-        buffer_.remove_data(len);
-        return buffer_.get_length();
+        recv_block_->Consume(len);
+        return GetBufferLen();
     }
 
     char* GetBuffer()
     {
-        return buffer_.get_data();
+        return (recv_block_ != nullptr ? recv_block_->GetReadPtr() : nullptr);
     }
 
     size_t GetBufferLen()
     {
-        return buffer_.get_length();
+        return (recv_block_ != nullptr ? recv_block_->GetLength() : 0);
     }
 
     uint32_t GetHeadLen()
@@ -120,6 +145,12 @@ public:
         session_id_ = id;
     }
 
+    // the peer sent an invalid message head, the stream can not be framed any more and should be closed
+    bool IsBroken()
+    {
+        return broken_;
+    }
+
     bool NeedRemove()
     {
         return need_remove_;
@@ -150,69 +181,103 @@ public:
         return msg_queue_.Pop(msg);
     }
 
-    void ParseBufferToMsg()
+    size_t GetNetMsgCount()
     {
-        uint32_t pos = 0;
-        AFMsgHead* msg_head = CheckRecvDataValid(pos);
-        if (msg_head == nullptr)
-        {
-            return;
-        }
+        return msg_queue_.Count();
+    }
 
-        while (GetBufferLen() >= static_cast<size_t>(pos + GetHeadLen() + msg_head->length_))
-        {
-            AFNetMsg* msg = AFNetMsg::AllocMsg(msg_head->length_);
-            memcpy(&msg->GetHead(), msg_head, GetHeadLen());
+    const AFNetSendQueuePtr& GetSendQueue()
+    {
+        return send_queue_;
+    }
 
-            pos += GetHeadLen();
-            if (msg_head->length_ > 0)
-            {
-                msg->CopyData(GetBuffer() + pos, msg_head->length_);
-                pos += msg_head->length_;
-            }
+    // mark pending events or messages, return true if the session was not marked yet
+    bool SetReady()
+    {
+        return !ready_.exchange(true, std::memory_order_acq_rel);
+    }
 
-            AddNetMsg(msg);
+    void ClearReady()
+    {
+        ready_.store(false, std::memory_order_release);
+    }
 
-            msg_head = CheckRecvDataValid(pos);
-            if (msg_head == nullptr)
+    // return the count of new messages
+    size_t ParseBufferToMsg()
+    {
+        size_t msg_count = 0;
+        AFMsgHead* msg_head = CheckRecvDataValid();
+        while (msg_head != nullptr && GetBufferLen() >= static_cast<size_t>(GetHeadLen() + msg_head->length_))
+        {
+            // the message refers to its body in the receive block, no copy
+            AFNetMsg* msg = AFNetMsg::AllocMsg(recv_block_, GetHeadLen());
+            RemoveBuffer(GetHeadLen() + msg_head->length_);
+            if (msg != nullptr)
             {
-                break;
+                msg->SetSessionId(session_id_);
+                AddNetMsg(msg);
+                ++msg_count;
             }
+
+            msg_head = CheckRecvDataValid();
         }
 
-        // remove [0, pos] buffers
-        if (pos > 0)
+        // all consumed, idle session keeps no block, the framed messages still hold it
+        if (recv_block_ != nullptr && GetBufferLen() == 0)
         {
-            RemoveBuffer(pos);
+            AFNetRecvBlock::Release(recv_block_);
         }
+
+        return msg_count;
     }
 
 protected:
-    AFMsgHead* CheckRecvDataValid(uint32_t pos)
+    AFMsgHead* CheckRecvDataValid()
     {
-        if (GetBufferLen() < (pos + GetHeadLen()))
+        if (GetBufferLen() < GetHeadLen())
         {
             return nullptr;
         }
 
-        auto head = reinterpret_cast<AFMsgHead*>(GetBuffer() + pos);
-        ARK_ASSERT_RET_VAL(head->length_ <= ARK_MSG_MAX_LENGTH, nullptr);
+        auto head = reinterpret_cast<AFMsgHead*>(GetBuffer());
+        if (head->length_ > ARK_MSG_MAX_LENGTH)
+        {
+            // remote input, no assert, drop everything from now on and let the owner close the session
+            broken_ = true;
+            RemoveBuffer(GetBufferLen());
+            return nullptr;
+        }
 
         return head;
     }
 
+    // move the unread partial message to a new block, at most one message is copied
+    bool SwitchRecvBlock()
+    {
+        AFNetRecvBlock* new_block = AFNetRecvBlock::Alloc();
+        ARK_ASSERT_RET_VAL(new_block != nullptr, false);
+
+        new_block->Write(recv_block_->GetReadPtr(), recv_block_->GetLength());
+        AFNetRecvBlock::Release(recv_block_);
+        recv_block_ = new_block;
+        return true;
+    }
+
 private:
     uint32_t head_len_{0};
     int64_t session_id_{0};
     AFGUID object_id_{0};
-    AFBuffer buffer_;
+    AFNetRecvBlock* recv_block_{nullptr};
 
     AFLockFreeQueue<AFNetMsg*> msg_queue_;
     AFLockFreeQueue<AFNetEvent*> event_queue_;
     const SessionPTR session_;
+    AFNetSendQueuePtr send_queue_{std::make_shared<AFNetSendQueue>()};
 
     volatile bool connected_{false};
     volatile bool need_remove_{false};
+    bool broken_{false}; // only touched by the io thread
+    std::atomic<bool> ready_{false};
 };
 
 using AFTCPSession = AFNetSession<brynet::net::TcpConnectionPtr>;
@@ -22,9 +22,10 @@
 
 #include "base/AFMacros.hpp"
 #include "base/AFLockFreeQueue.hpp"
-#include "base/AFBuffer.hpp"
 #include "net/include/AFNetMsg.hpp"
 #include "net/include/AFNetEvent.hpp"
+#include "net/include/AFNetFrameBudget.hpp"
+#include "net/include/AFNetSendQueue.hpp"
 #include "proto/AFProtoCPP.hpp"
 
 namespace ark {
@@ -37,6 +38,12 @@ using NET_MSG_FUNCTOR = std::function<void(const AFNetMsg*)>;
 using NET_EVENT_FUNCTOR = std::function<void(const AFNetEvent*)>;
 //using NET_EVENT_FUNCTOR_PTR = std::shared_ptr<NET_EVENT_FUNCTOR>;
 
+// return false to drop the messages of an actor
+using NET_ACTOR_FILTER_FUNCTOR = std::function<bool(const int64_t)>;
+
+// return the entity a message body is about, 0 if the message can not be coalesced
+using NET_COALESCE_KEY_FUNCTOR = std::function<int64_t(const char*, const uint32_t)>;
+
 class AFINet
 {
 public:
@@ -59,13 +66,35 @@ public:
     virtual bool Shutdown() = 0;
 
     virtual bool SendMsg(AFMsgHead* head, const char* msg_data, const int64_t session_id) = 0;
+
+    // send a message whose body is split into several spans, the spans are framed behind the head in one packet
+    virtual bool SendMsgSpans(
+        AFMsgHead* head, const AFBufferSpan* body, const size_t body_count, const int64_t session_id)
+    {
+        return false;
+    }
+
     virtual bool BroadcastMsg(AFMsgHead* head, const char* msg_data)
     {
         return false;
     }
 
+    // send one message to a group of sessions, the message is framed once and shared by all of them
+    virtual bool MulticastMsg(AFMsgHead* head, const char* msg_data, const std::vector<int64_t>& session_list)
+    {
+        return false;
+    }
+
     virtual bool CloseSession(const int64_t& session_id) = 0;
 
+    // bytes queued to the session and not written yet
+    virtual size_t GetSendQueueSize(const int64_t session_id)
+    {
+        return 0;
+    }
+
+    virtual void GetSendStats(AFNetSendStats& stats) {}
+
     bool IsWorking() const
     {
         return working_;
@@ -76,9 +105,91 @@ public:
         working_ = value;
     }
 
+    // share the inbound budget with other nets, the owner starts it every frame
+    void SetFrameBudget(std::shared_ptr<AFNetFrameBudget> budget)
+    {
+        frame_budget_ = budget;
+    }
+
+    void SetSendLimit(const AFNetSendLimit& limit)
+    {
+        ARK_ASSERT_RET_NONE(
+            limit.low_watermark_ <= limit.high_watermark_ && limit.high_watermark_ <= limit.hard_limit_);
+        send_limit_ = limit;
+    }
+
+    const AFNetSendLimit& GetSendLimit() const
+    {
+        return send_limit_;
+    }
+
+    // Low priority messages carry absolute state of one entity, a congested session only keeps the newest one per
+    // msg id, actor id and the entity returned by key_functor. Never register relative deltas, replacing one of them
+    // corrupts the state of the receiver. Call before the net starts.
+    void SetLowPriorityMsg(const uint16_t msg_id, NET_COALESCE_KEY_FUNCTOR&& key_functor)
+    {
+        ARK_ASSERT_RET_NONE(key_functor != nullptr);
+        low_priority_msgs_[msg_id] = std::move(key_functor);
+    }
+
+    const NET_COALESCE_KEY_FUNCTOR* GetLowPriorityMsg(const uint16_t msg_id) const
+    {
+        auto iter = low_priority_msgs_.find(msg_id);
+        return (iter != low_priority_msgs_.end() ? &iter->second : nullptr);
+    }
+
+protected:
+    // a net without shared budget starts its own every frame
+    AFNetFrameBudget& BeginFrameBudget()
+    {
+        if (frame_budget_ != nullptr)
+        {
+            return *frame_budget_;
+        }
+
+        local_budget_.Start();
+        return local_budget_;
+    }
+
+    // frame head and body into one pooled packet, the head takes the front of the same buffer
+    static AFNetPacketPtr MakePacket(
+        const AFMsgHead* head, const uint32_t head_len, const AFBufferSpan* body, const size_t body_count)
+    {
+        size_t body_len = 0;
+        for (size_t i = 0; i < body_count; ++i)
+        {
+            body_len += body[i].len_;
+        }
+
+        ARK_ASSERT_RET_VAL(head->length_ == body_len, nullptr);
+
+        auto packet = AFNetPacketPool::Alloc(head_len + body_len);
+        packet->append(reinterpret_cast<const char*>(head), head_len);
+        for (size_t i = 0; i < body_count; ++i)
+        {
+            packet->append(body[i].data_, body[i].len_);
+        }
+
+        return packet;
+    }
+
+    static AFNetPacketPtr MakePacket(const AFMsgHead* head, const uint32_t head_len, const char* msg_data)
+    {
+        AFBufferSpan body;
+        body.data_ = msg_data;
+        body.len_ = head->length_;
+        return MakePacket(head, head_len, &body, (body.len_ > 0 ? 1 : 0));
+    }
+
 private:
     bool working_{false};
 
+    std::shared_ptr<AFNetFrameBudget> frame_budget_{nullptr};
+    AFNetFrameBudget local_budget_;
+
+    AFNetSendLimit send_limit_;
+    std::unordered_map<uint16_t, NET_COALESCE_KEY_FUNCTOR> low_priority_msgs_;
+
 public:
     size_t statistic_recv_size_{0};
     size_t statistic_send_size_{0};
@@ -26,6 +26,7 @@
 #include "base/AFSocketFunc.hpp"
 #include "proto/AFProtoCPP.hpp"
 #include "net/interface/AFINet.hpp"
+#include "net/include/AFNetMsgHandlerTable.hpp"
 
 namespace ark {
 
@@ -83,6 +84,9 @@ public:
     //virtual AFMapEx<int, AFConnectionData>& GetServerList() = 0;
 
     virtual bool RegMsgCallback(const int nMsgID, const NET_MSG_FUNCTOR&& cb) = 0;
+    // limit length and rate of a registered message
+    virtual bool SetMsgMeta(const int msg_id, const AFNetMsgMeta& meta) = 0;
+    virtual void GetMsgStats(std::vector<AFNetMsgStats>& stats) = 0;
     virtual bool RegForwardMsgCallback(const NET_MSG_FUNCTOR&& cb) = 0;
     virtual bool RegNetEventCallback(const NET_EVENT_FUNCTOR&& cb) = 0;
 
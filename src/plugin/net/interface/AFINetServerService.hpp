@@ -23,6 +23,7 @@
 #include "proto/AFProtoCPP.hpp"
 #include "base/AFBus.hpp"
 #include "AFINet.hpp"
+#include "net/include/AFNetMsgHandlerTable.hpp"
 
 namespace ark {
 
@@ -75,8 +76,9 @@ public:
         return RegNetEventCallback(std::move(functor));
     }
 
+    // messages with actor id are handled by logic_thread_count workers if it is not 0, handlers must be thread safe
     virtual bool Start(const AFHeadLength len, const int bus_id, const AFEndpoint& ep, const uint8_t thread_count,
-        const uint32_t max_connection) = 0;
+        const uint32_t max_connection, const uint8_t logic_thread_count = 0) = 0;
     virtual bool Update() = 0;
 
     // virtual bool SendBroadcastMsg(const int nMsgID, const std::string& msg, const AFGUID& player_id) = 0;
@@ -86,10 +88,16 @@ public:
     // SendMsg(const uint16_t msg_id, const std::string& data, const AFGUID& connect_id, const AFGUID& player_id, const
     // std::vector<AFGUID>* target_list = nullptr) = 0;
     virtual std::shared_ptr<AFINet> GetNet() = 0;
+    virtual AFHeadLength GetHeadLength() const = 0;
 
     virtual bool RegMsgCallback(const int msg_id, NET_MSG_FUNCTOR&& cb) = 0;
+    // limit length and rate of a registered message
+    virtual bool SetMsgMeta(const int msg_id, const AFNetMsgMeta& meta) = 0;
+    virtual void GetMsgStats(std::vector<AFNetMsgStats>& stats) = 0;
     virtual bool RegForwardMsgCallback(NET_MSG_FUNCTOR&& cb) = 0;
     virtual bool RegNetEventCallback(NET_EVENT_FUNCTOR&& cb) = 0;
+    // checked in main thread before handling or dispatching, e.g. to hold an actor migrating to another game
+    virtual bool RegActorFilter(NET_ACTOR_FILTER_FUNCTOR&& filter) = 0;
 };
 
 } // namespace ark
@@ -48,6 +48,15 @@ public:
     virtual std::shared_ptr<AFINet> GetNetConnectionBus(int src_bus, int target_bus) = 0;
 
     virtual std::shared_ptr<AFINetClientService> GetClientService(const ARK_APP_TYPE app_type) = 0;
+
+    // inbound budget shared by all nets of the process
+    virtual std::shared_ptr<AFNetFrameBudget> GetFrameBudget() = 0;
+
+    // low priority messages of the self server, see AFINet::SetLowPriorityMsg, call before CreateServer
+    virtual void SetLowPriorityMsg(const uint16_t msg_id, NET_COALESCE_KEY_FUNCTOR&& key_functor) = 0;
+
+    // send limits of proc config and the low priority messages, applied to a server net before it starts
+    virtual void InitSendPolicy(std::shared_ptr<AFINet> net) = 0;
 };
 
 } // namespace ark
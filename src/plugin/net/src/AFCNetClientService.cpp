@@ -57,15 +57,18 @@ void AFCNetClientService::Update()
 
 bool AFCNetClientService::RegMsgCallback(const int msg_id, const NET_MSG_FUNCTOR&& cb)
 {
-    if (net_msg_callbacks_.find(msg_id) != net_msg_callbacks_.end())
-    {
-        return false;
-    }
-    else
-    {
-        net_msg_callbacks_.insert(std::make_pair(msg_id, std::forward<const NET_MSG_FUNCTOR>(cb)));
-        return true;
-    }
+    // callbacks come in as const rvalue, keep a copy
+    return net_msg_handlers_.Register(msg_id, NET_MSG_FUNCTOR(cb));
+}
+
+bool AFCNetClientService::SetMsgMeta(const int msg_id, const AFNetMsgMeta& meta)
+{
+    return net_msg_handlers_.SetMeta(msg_id, meta);
+}
+
+void AFCNetClientService::GetMsgStats(std::vector<AFNetMsgStats>& stats)
+{
+    net_msg_handlers_.GetStats(stats);
 }
 
 bool AFCNetClientService::RegForwardMsgCallback(const NET_MSG_FUNCTOR&& cb)
@@ -153,7 +156,10 @@ std::shared_ptr<AFINet> AFCNetClientService::CreateNet(const proto_type proto)
 {
     if (proto == proto_type::tcp)
     {
-        return std::make_shared<AFCTCPClient>(this, &AFCNetClientService::OnNetMsg, &AFCNetClientService::OnNetEvent);
+        auto pNet =
+            std::make_shared<AFCTCPClient>(this, &AFCNetClientService::OnNetMsg, &AFCNetClientService::OnNetEvent);
+        pNet->SetFrameBudget(m_pNetServiceManagerModule->GetFrameBudget());
+        return pNet;
     }
     else if (proto == proto_type::udp)
     {
@@ -302,13 +308,13 @@ void AFCNetClientService::ProcessAddConnection()
 
 void AFCNetClientService::OnNetMsg(const AFNetMsg* msg)
 {
-    auto it = net_msg_callbacks_.find(msg->GetMsgId());
-
-    if (it != net_msg_callbacks_.end())
+    auto result = net_msg_handlers_.Handle(msg);
+    if (result == AFNetMsgHandlerTable::Result::REJECTED || result == AFNetMsgHandlerTable::Result::FLOODED)
     {
-        (it->second)(msg);
+        ARK_LOG_ERROR("Rejected message, id = {} length = {} actor_id = {}", msg->GetMsgId(), msg->GetMsgLength(),
+            msg->GetActorId());
     }
-    else
+    else if (result == AFNetMsgHandlerTable::Result::UNKNOWN)
     {
         ARK_LOG_ERROR("Invalid message, id = {}", msg->GetMsgId());
         // TODO:forward to other server process
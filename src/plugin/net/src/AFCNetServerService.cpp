@@ -39,12 +39,22 @@ AFCNetServerService::AFCNetServerService(AFPluginManager* p)
 //}
 
 bool AFCNetServerService::Start(const AFHeadLength len, const int bus_id, const AFEndpoint& ep,
-    const uint8_t thread_count, const uint32_t max_connection)
+    const uint8_t thread_count, const uint32_t max_connection, const uint8_t logic_thread_count /* = 0*/)
 {
+    if (logic_thread_count > 0)
+    {
+        dispatcher_ = std::make_unique<AFNetMsgDispatcher>(
+            logic_thread_count, std::bind(&AFCNetServerService::HandleNetMsg, this, std::placeholders::_1));
+    }
+
+    head_len_ = len;
+
     bool ret = false;
     if (ep.proto() == proto_type::tcp)
     {
         m_pNet = std::make_shared<AFCTCPServer>(this, &AFCNetServerService::OnNetMsg, &AFCNetServerService::OnNetEvent);
+        m_pNet->SetFrameBudget(m_pNetServiceManagerModule->GetFrameBudget());
+        m_pNetServiceManagerModule->InitSendPolicy(m_pNet);
         ret = m_pNet->StartServer(len, bus_id, ep.GetIP(), ep.GetPort(), thread_count, max_connection, ep.IsV6());
 
         //AFINetServerService::RegMsgCallback(
@@ -79,17 +89,24 @@ std::shared_ptr<AFINet> AFCNetServerService::GetNet()
     return m_pNet;
 }
 
+AFHeadLength AFCNetServerService::GetHeadLength() const
+{
+    return head_len_;
+}
+
 bool AFCNetServerService::RegMsgCallback(const int msg_id, NET_MSG_FUNCTOR&& cb)
 {
-    if (net_msg_callbacks_.find(msg_id) != net_msg_callbacks_.end())
-    {
-        return false;
-    }
-    else
-    {
-        net_msg_callbacks_.insert(std::make_pair(msg_id, std::forward<NET_MSG_FUNCTOR>(cb)));
-        return true;
-    }
+    return net_msg_handlers_.Register(msg_id, std::forward<NET_MSG_FUNCTOR>(cb));
+}
+
+bool AFCNetServerService::SetMsgMeta(const int msg_id, const AFNetMsgMeta& meta)
+{
+    return net_msg_handlers_.SetMeta(msg_id, meta);
+}
+
+void AFCNetServerService::GetMsgStats(std::vector<AFNetMsgStats>& stats)
+{
+    net_msg_handlers_.GetStats(stats);
 }
 
 bool AFCNetServerService::RegForwardMsgCallback(NET_MSG_FUNCTOR&& cb)
@@ -104,23 +121,69 @@ bool AFCNetServerService::RegNetEventCallback(NET_EVENT_FUNCTOR&& cb)
     return true;
 }
 
+bool AFCNetServerService::RegActorFilter(NET_ACTOR_FILTER_FUNCTOR&& filter)
+{
+    ARK_ASSERT_RET_VAL(actor_filter_ == nullptr, false);
+
+    actor_filter_ = std::forward<NET_ACTOR_FILTER_FUNCTOR>(filter);
+    return true;
+}
+
 void AFCNetServerService::OnNetMsg(const AFNetMsg* msg)
 {
-    auto it = net_msg_callbacks_.find(msg->GetMsgId());
-    if (it != net_msg_callbacks_.end())
+    if (actor_filter_ != nullptr && msg->GetActorId() != 0 && !actor_filter_(msg->GetActorId()))
     {
-        (it->second)(msg);
+        ARK_LOG_DEBUG("Filtered message, id = {} actor_id = {}", msg->GetMsgId(), msg->GetActorId());
+        return;
     }
-    else
+
+    // messages without actor are server level, keep them in main thread
+    if (dispatcher_ != nullptr && msg->GetActorId() != 0)
     {
-        // TODO:forward to other server process
+        AFNetMsg* dispatch_msg = AFNetMsg::Clone(msg);
+        if (dispatch_msg != nullptr)
+        {
+            dispatcher_->Dispatch(dispatch_msg);
+        }
 
-        ARK_LOG_ERROR("Invalid message, id = {}", msg->GetMsgId());
+        return;
+    }
 
-        // for (const auto& iter : mxCallBackList)
-        //{
-        //    (iter)(head, msg_id, msg, msg_len, session_id);
-        //}
+    HandleNetMsg(msg);
+}
+
+void AFCNetServerService::HandleNetMsg(const AFNetMsg* msg)
+{
+    auto result = net_msg_handlers_.Handle(msg);
+    if (result == AFNetMsgHandlerTable::Result::REJECTED)
+    {
+        ARK_LOG_ERROR("Rejected message, id = {} length = {} actor_id = {}", msg->GetMsgId(), msg->GetMsgLength(),
+            msg->GetActorId());
+    }
+    else if (result == AFNetMsgHandlerTable::Result::FLOODED)
+    {
+        ARK_LOG_ERROR("Flooded message, id = {} actor_id = {} session_id = {}", msg->GetMsgId(), msg->GetActorId(),
+            msg->GetSessionId());
+
+        // a session without actor is the sender itself, an actor comes through a server which must stay connected
+        if (msg->GetActorId() == 0 && m_pNet != nullptr)
+        {
+            m_pNet->CloseSession(msg->GetSessionId());
+        }
+    }
+    else if (result == AFNetMsgHandlerTable::Result::UNKNOWN)
+    {
+        if (net_forward_msg_callbacks_.empty())
+        {
+            ARK_LOG_ERROR("Invalid message, id = {}", msg->GetMsgId());
+            return;
+        }
+
+        // forward to other server process
+        for (const auto& cb : net_forward_msg_callbacks_)
+        {
+            cb(msg);
+        }
     }
 }
 
@@ -42,8 +42,11 @@ bool AFCNetServiceManagerModule::PostInit()
     auto reg_center = m_pBusModule->GetRegCenter();
     m_pConsulModule->SetRegisterCenter(reg_center.ip, reg_center.port);
 
+    frame_budget_->SetBudget(m_pBusModule->GetSelfProc().net_frame_budget);
+
     // start health check timer
     m_pTimerModule->AddForeverTimer(0, std::chrono::seconds(20), this, &AFCNetServiceManagerModule::HealthCheck);
+    m_pTimerModule->AddForeverTimer(0, std::chrono::seconds(60), this, &AFCNetServiceManagerModule::ReportNetStats);
 
     return true;
 }
@@ -124,17 +127,36 @@ void AFCNetServiceManagerModule::HealthCheck(uint64_t timer_id, const AFGUID& en
     }
 }
 
-bool AFCNetServiceManagerModule::Update()
+void AFCNetServiceManagerModule::ReportNetStats(uint64_t timer_id, const AFGUID& entity_id)
 {
     for (auto iter : server_services_)
     {
         auto pServerData = iter.second;
-        if (pServerData != nullptr)
+        if (pServerData == nullptr || pServerData->GetNet() == nullptr)
         {
-            pServerData->Update();
+            continue;
         }
+
+        AFNetSendStats stats;
+        pServerData->GetNet()->GetSendStats(stats);
+        ARK_LOG_INFO("net send stats, bus = {} queue = {} max_queue = {} congested = {} coalesced = {} dropped = {} "
+                     "kicked = {}",
+            AFBusAddr(iter.first).ToString(), stats.queue_size_, stats.max_queue_size_, stats.congested_count_,
+            stats.coalesced_count_, stats.dropped_count_, stats.kicked_count_);
     }
 
+    // inbound backlog left by the frame budget, shared by all nets
+    ARK_LOG_INFO("net frame budget, budget = {}us deferred_sessions = {} deferred_msgs = {} max_deferred_msgs = {} "
+                 "deferred_frames = {}",
+        frame_budget_->GetBudget(), frame_budget_->GetDeferredSessionCount(), frame_budget_->GetDeferredMsgCount(),
+        frame_budget_->GetMaxDeferredMsgCount(), frame_budget_->GetDeferredFrameCount());
+}
+
+bool AFCNetServiceManagerModule::Update()
+{
+    frame_budget_->Start();
+
+    // clients connect to other servers, server to server messages take the budget first
     for (auto iter : client_services_)
     {
         auto pData = iter.second;
@@ -144,6 +166,19 @@ bool AFCNetServiceManagerModule::Update()
         }
     }
 
+    // then server nets of other servers before the ones of game clients, every net sorts its own sessions alike
+    for (auto head_len : {AFHeadLength::SS_HEAD_LENGTH, AFHeadLength::CS_HEAD_LENGTH})
+    {
+        for (auto iter : server_services_)
+        {
+            auto pServerData = iter.second;
+            if (pServerData != nullptr && pServerData->GetHeadLength() == head_len)
+            {
+                pServerData->Update();
+            }
+        }
+    }
+
     return true;
 }
 
@@ -173,8 +208,8 @@ ananas::Future<std::pair<bool, std::string>> AFCNetServiceManagerModule::CreateS
     const AFProcConfig& self_proc = m_pBusModule->GetSelfProc();
 
     auto pServer = std::make_shared<AFCNetServerService>(GetPluginManager());
-    bool ret =
-        pServer->Start(head_len, self_proc.bus_id, self_proc.server_ep, self_proc.thread_num, self_proc.max_connection);
+    bool ret = pServer->Start(head_len, self_proc.bus_id, self_proc.server_ep, self_proc.thread_num,
+        self_proc.max_connection, self_proc.logic_thread_num);
     if (ret)
     {
         ARK_LOG_INFO("Start net server successful, url = {}", self_proc.server_ep.ToString());
@@ -230,6 +265,48 @@ std::shared_ptr<AFINetClientService> AFCNetServiceManagerModule::GetClientServic
     return client_services_.find_value(app_type);
 }
 
+std::shared_ptr<AFNetFrameBudget> AFCNetServiceManagerModule::GetFrameBudget()
+{
+    return frame_budget_;
+}
+
+void AFCNetServiceManagerModule::SetLowPriorityMsg(const uint16_t msg_id, NET_COALESCE_KEY_FUNCTOR&& key_functor)
+{
+    ARK_ASSERT_RET_NONE(key_functor != nullptr);
+    low_priority_msgs_[msg_id] = std::move(key_functor);
+}
+
+void AFCNetServiceManagerModule::InitSendPolicy(std::shared_ptr<AFINet> net)
+{
+    ARK_ASSERT_RET_NONE(net != nullptr);
+
+    // KB in config, keep the default of a field not configured
+    const AFProcConfig& self_proc = m_pBusModule->GetSelfProc();
+    AFNetSendLimit limit;
+    if (self_proc.send_low_watermark > 0)
+    {
+        limit.low_watermark_ = size_t(self_proc.send_low_watermark) * 1024;
+    }
+
+    if (self_proc.send_high_watermark > 0)
+    {
+        limit.high_watermark_ = size_t(self_proc.send_high_watermark) * 1024;
+    }
+
+    if (self_proc.send_hard_limit > 0)
+    {
+        limit.hard_limit_ = size_t(self_proc.send_hard_limit) * 1024;
+    }
+
+    net->SetSendLimit(limit);
+
+    for (auto& iter : low_priority_msgs_)
+    {
+        auto key_functor = iter.second;
+        net->SetLowPriorityMsg(iter.first, std::move(key_functor));
+    }
+}
+
 ananas::Future<std::pair<bool, std::string>> AFCNetServiceManagerModule::RegisterToConsul(const int bus_id)
 {
     auto reg_center = m_pBusModule->GetRegCenter();
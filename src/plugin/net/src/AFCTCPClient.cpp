@@ -84,6 +84,10 @@ bool AFCTCPClient::StartClient(
                 AFScopeRLock guard(shared_this->rw_lock_);
                 shared_this->client_session_ptr_->AddBuffer(buffer, len);
                 shared_this->client_session_ptr_->ParseBufferToMsg();
+                if (shared_this->client_session_ptr_->IsBroken())
+                {
+                    session->postDisConnect();
+                }
             }
 
             return len;
@@ -162,6 +166,7 @@ bool AFCTCPClient::CloseSession()
 
 void AFCTCPClient::UpdateNetSession()
 {
+    AFNetFrameBudget& budget = BeginFrameBudget();
     if (client_session_ptr_ == nullptr)
     {
         return;
@@ -170,7 +175,7 @@ void AFCTCPClient::UpdateNetSession()
     {
         AFScopeRLock guard(rw_lock_);
         UpdateNetEvent(client_session_ptr_.get());
-        UpdateNetMsg(client_session_ptr_.get());
+        UpdateNetMsg(client_session_ptr_.get(), budget);
     }
 
     if (client_session_ptr_->NeedRemove())
@@ -193,20 +198,21 @@ void AFCTCPClient::UpdateNetEvent(AFTCPSessionPtr session)
     }
 }
 
-void AFCTCPClient::UpdateNetMsg(AFTCPSessionPtr session)
+void AFCTCPClient::UpdateNetMsg(AFTCPSessionPtr session, AFNetFrameBudget& budget)
 {
     ARK_ASSERT_RET_NONE(session != nullptr);
 
-    AFNetMsg* msg(nullptr);
-    int msg_count = 0;
+    AFNetMsg* msg{nullptr};
+    size_t msg_count = 0;
     while (session->PopNetMsg(msg))
     {
         net_msg_cb_(msg);
         AFNetMsg::Release(msg);
 
         ++msg_count;
-        if (msg_count > ARK_PROCESS_NET_MSG_COUNT_ONCE)
+        if (msg_count % AFNetFrameBudget::SLICE_MSG_COUNT == 0 && budget.Expired())
         {
+            budget.AddDeferred(session->GetNetMsgCount());
             break;
         }
     }
@@ -217,20 +223,28 @@ bool AFCTCPClient::SendMsg(AFMsgHead* head, const char* msg_data, const int64_t
     ARK_ASSERT_RET_VAL(head != nullptr && msg_data != nullptr, false);
     ARK_ASSERT_RET_VAL(client_session_ptr_ != nullptr, false);
 
+    return SendPacket(MakePacket(head, client_session_ptr_->GetHeadLen(), msg_data));
+}
+
+bool AFCTCPClient::SendMsgSpans(
+    AFMsgHead* head, const AFBufferSpan* body, const size_t body_count, const int64_t session_id)
+{
+    ARK_ASSERT_RET_VAL(head != nullptr && (body != nullptr || body_count == 0), false);
+    ARK_ASSERT_RET_VAL(client_session_ptr_ != nullptr, false);
+
+    return SendPacket(MakePacket(head, client_session_ptr_->GetHeadLen(), body, body_count));
+}
+
+bool AFCTCPClient::SendPacket(const AFNetPacketPtr& packet)
+{
+    ARK_ASSERT_RET_VAL(packet != nullptr, false);
+
     AFHeadLength head_length = static_cast<AFHeadLength>(client_session_ptr_->GetHeadLen());
     ARK_ASSERT_RET_VAL(
         (head_length == AFHeadLength::CS_HEAD_LENGTH) || (head_length == AFHeadLength::SS_HEAD_LENGTH), false);
 
-    std::string buffer;
-    buffer.append(reinterpret_cast<char*>(head), client_session_ptr_->GetHeadLen());
-
-    if (buffer.empty())
-    {
-        return false;
-    }
-
-    buffer.append(msg_data, head->length_);
-    client_session_ptr_->GetSession()->send(buffer.c_str(), buffer.length());
+    // brynet keeps the packet pointer, no more copy
+    client_session_ptr_->GetSession()->send(packet);
     return true;
 }
 
@@ -71,6 +71,7 @@ bool AFCTCPServer::StartServer(AFHeadLength head_len, const int busid, const std
             if (shared_this->AddNetSession(session_ptr))
             {
                 session_ptr->AddNetEvent(net_connect_event);
+                shared_this->AddReadySession(session_ptr);
             }
         }
 
@@ -78,9 +79,26 @@ bool AFCTCPServer::StartServer(AFHeadLength head_len, const int busid, const std
             auto pUD = cast<int64_t>(session->getUD());
             if (pUD != nullptr)
             {
+                AFScopeRLock guard(shared_this->rw_lock_);
                 const AFTCPSessionPtr session_ptr = shared_this->GetNetSession(*pUD);
+                if (session_ptr == nullptr)
+                {
+                    return len;
+                }
+
                 session_ptr->AddBuffer(buffer, len);
                 session_ptr->ParseBufferToMsg();
+
+                // AddBuffer frames by itself when a block fills up, so check the queue rather than the parsed count
+                if (session_ptr->GetNetMsgCount() > 0)
+                {
+                    shared_this->AddReadySession(session_ptr);
+                }
+
+                if (session_ptr->IsBroken())
+                {
+                    session->postDisConnect();
+                }
             }
 
             return len;
@@ -101,14 +119,17 @@ bool AFCTCPServer::StartServer(AFHeadLength head_len, const int busid, const std
             net_disconnect_event->SetBusId(shared_this->bus_id_);
             net_disconnect_event->SetIP(session->getIP());
 
+            AFScopeRLock guard(shared_this->rw_lock_);
             const AFTCPSessionPtr session_ptr = shared_this->GetNetSession(session_id);
             if (session_ptr == nullptr)
             {
+                AFNetEvent::Release(net_disconnect_event);
                 return;
             }
 
             session_ptr->AddNetEvent(net_disconnect_event);
             session_ptr->SetNeedRemove(true);
+            shared_this->AddReadySession(session_ptr);
         });
     };
 
@@ -124,40 +145,129 @@ bool AFCTCPServer::StartServer(AFHeadLength head_len, const int busid, const std
     return true;
 }
 
+void AFCTCPServer::AddReadySession(AFTCPSessionPtr session)
+{
+    if (session->SetReady())
+    {
+        ready_sessions_.Push(session->GetSessionId());
+    }
+}
+
 void AFCTCPServer::UpdateNetSession()
 {
-    std::list<int64_t> remove_sessions;
+    AFNetFrameBudget& budget = BeginFrameBudget();
 
+    UpdateCongestedSession();
+
+    ready_list_.clear();
+    if (!ready_sessions_.PopAll(ready_list_))
+    {
+        return;
+    }
+
+    // only the main thread deletes sessions, the pointers stay valid after the lock is released.
+    // handlers run without the lock, so they and the dispatcher workers can send, which takes it
+    active_list_.clear();
     {
         AFScopeRLock guard(rw_lock_);
-        for (auto& iter : sessions_)
+        for (auto session_id : ready_list_)
         {
-            auto& session = iter.second;
-            ARK_ASSERT_CONTINUE(session != nullptr);
+            auto session = GetNetSession(session_id);
+            if (session != nullptr)
+            {
+                active_list_.emplace_back(session);
+            }
+        }
+    }
+
+    std::list<int64_t> remove_sessions;
+
+    // events are few and carry the connection state, handle all of them
+    size_t active_count = 0;
+    for (size_t i = 0; i < active_list_.size(); ++i)
+    {
+        auto session = active_list_[i];
+
+        // clear before processing, anything arriving from now on marks the session again
+        session->ClearReady();
 
-            UpdateNetEvent(session);
-            UpdateNetMsg(session);
+        UpdateNetEvent(session);
 
-            if (!session->NeedRemove())
+        if (session->NeedRemove())
+        {
+            // the last requests before closing, e.g. logout, are still handled
+            DrainNetMsg(session);
+            remove_sessions.emplace_back(session->GetSessionId());
+            continue;
+        }
+
+        active_list_[active_count++] = session;
+    }
+
+    active_list_.resize(active_count);
+
+    // server to server sessions are sliced first in every round, client sessions are the ones deferred
+    std::stable_partition(active_list_.begin(), active_list_.end(), [](const AFTCPSessionPtr& session) {
+        return session->GetHeadLen() == static_cast<uint32_t>(AFHeadLength::SS_HEAD_LENGTH);
+    });
+
+    // one slice of every session per round until all drained or the budget runs out.
+    // client nets run first on the shared budget, the first slice is always handled so this net is never starved
+    bool first_slice = true;
+    while (!active_list_.empty())
+    {
+        size_t keep_count = 0;
+        size_t index = 0;
+        for (; index < active_list_.size() && (first_slice || !budget.Expired()); ++index)
+        {
+            first_slice = false;
+            auto session = active_list_[index];
+            bool has_more = UpdateNetMsg(session, AFNetFrameBudget::SLICE_MSG_COUNT);
+            if (session->NeedRemove())
             {
-                continue;
+                DrainNetMsg(session);
+                remove_sessions.emplace_back(session->GetSessionId());
+            }
+            else if (has_more)
+            {
+                active_list_[keep_count++] = session;
             }
+        }
 
-            remove_sessions.emplace_back(session->GetSessionId());
+        if (index < active_list_.size())
+        {
+            // out of budget, sessions not reached in this round go first next frame
+            std::rotate(active_list_.begin() + keep_count, active_list_.begin() + index, active_list_.end());
+            size_t defer_count = keep_count + (active_list_.size() - index);
+            std::rotate(
+                active_list_.begin(), active_list_.begin() + keep_count, active_list_.begin() + defer_count);
+            active_list_.resize(defer_count);
+
+            for (auto session : active_list_)
+            {
+                budget.AddDeferred(session->GetNetMsgCount());
+                AddReadySession(session);
+            }
+
+            break;
         }
+
+        active_list_.resize(keep_count);
     }
 
-    for (auto& iter : remove_sessions)
+    if (remove_sessions.empty())
+    {
+        return;
+    }
+
+    AFScopeWLock guard(rw_lock_);
+    for (auto& session_id : remove_sessions)
     {
-        auto& session_id = iter;
         auto session = GetNetSession(session_id);
-        if (session == nullptr)
+        if (session != nullptr)
         {
-            continue;
+            CloseSession(session);
         }
-
-        AFScopeWLock guard(rw_lock_);
-        CloseSession(session);
     }
 }
 
@@ -173,22 +283,94 @@ void AFCTCPServer::UpdateNetEvent(AFTCPSessionPtr session)
     }
 }
 
-void AFCTCPServer::UpdateNetMsg(AFTCPSessionPtr session)
+void AFCTCPServer::UpdateCongestedSession()
 {
-    ARK_ASSERT_RET_NONE(session != nullptr);
+    // sessions crossed high watermark in any sending thread
+    congest_list_.clear();
+    congest_sessions_.PopAll(congest_list_);
+    if (congest_list_.empty() && congested_sessions_.empty())
+    {
+        return;
+    }
+
+    {
+        AFScopeRLock guard(rw_lock_);
+
+        for (auto session_id : congest_list_)
+        {
+            auto session = GetNetSession(session_id);
+            if (session != nullptr && !session->NeedRemove())
+            {
+                congested_sessions_.emplace_back(session_id);
+                send_events_.emplace_back(CreateSendEvent(session, AFNetEventType::SEND_HIGH_WATERMARK));
+            }
+        }
+
+        size_t keep_count = 0;
+        for (auto session_id : congested_sessions_)
+        {
+            auto session = GetNetSession(session_id);
+            if (session == nullptr || session->NeedRemove())
+            {
+                continue;
+            }
+
+            coalesced_packets_.clear();
+            if (!session->GetSendQueue()->EndCongest(GetSendLimit(), coalesced_packets_))
+            {
+                congested_sessions_[keep_count++] = session_id;
+                continue;
+            }
+
+            send_events_.emplace_back(CreateSendEvent(session, AFNetEventType::SEND_LOW_WATERMARK));
+
+            // the newest one of every kept message, in the order they were kept first
+            for (auto& iter : coalesced_packets_)
+            {
+                QueuePacket(session, iter.packet_);
+            }
+        }
+
+        congested_sessions_.resize(keep_count);
+        coalesced_packets_.clear();
+    }
+
+    // outside the lock, handlers may send
+    for (auto event : send_events_)
+    {
+        if (event != nullptr)
+        {
+            net_event_cb_(event);
+            AFNetEvent::Release(event);
+        }
+    }
+
+    send_events_.clear();
+}
+
+bool AFCTCPServer::UpdateNetMsg(AFTCPSessionPtr session, const size_t max_count)
+{
+    ARK_ASSERT_RET_VAL(session != nullptr, false);
 
     AFNetMsg* msg{nullptr};
-    int msg_count = 0;
-    while (session->PopNetMsg(msg))
+    for (size_t msg_count = 0; msg_count < max_count; ++msg_count)
     {
+        if (!session->PopNetMsg(msg))
+        {
+            return false;
+        }
+
         net_msg_cb_(msg);
         AFNetMsg::Release(msg);
+    }
 
-        ++msg_count;
-        if (msg_count > ARK_PROCESS_NET_MSG_COUNT_ONCE)
-        {
-            break;
-        }
+    return (session->GetNetMsgCount() > 0);
+}
+
+void AFCTCPServer::DrainNetMsg(AFTCPSessionPtr session)
+{
+    while (UpdateNetMsg(session, AFNetFrameBudget::SLICE_MSG_COUNT))
+    {
     }
 }
 
@@ -250,6 +432,7 @@ bool AFCTCPServer::CloseSession(AFTCPSessionPtr& session)
 
 bool AFCTCPServer::CloseSession(const int64_t& session_id)
 {
+    AFScopeRLock guard(rw_lock_);
     AFTCPSessionPtr session = GetNetSession(session_id);
     if (session == nullptr)
     {
@@ -257,11 +440,13 @@ bool AFCTCPServer::CloseSession(const int64_t& session_id)
     }
 
     session->SetNeedRemove(true);
+    AddReadySession(session);
     return true;
 }
 
 bool AFCTCPServer::CloseAllSession()
 {
+    AFScopeWLock guard(rw_lock_);
     for (auto& iter : sessions_)
     {
         auto& session = iter.second;
@@ -306,53 +491,203 @@ AFTCPSessionPtr AFCTCPServer::GetNetSession(const int64_t& session_id)
 bool AFCTCPServer::SendMsg(AFMsgHead* head, const char* msg_data, const int64_t session_id)
 {
     ARK_ASSERT_RET_VAL(head != nullptr && msg_data != nullptr, false);
+
+    // may be called by dispatcher workers, io threads insert sessions meanwhile
+    AFScopeRLock guard(rw_lock_);
     auto session = GetNetSession(session_id);
     ARK_ASSERT_RET_VAL(session != nullptr, false);
 
+    return SendPacket(session, head, MakePacket(head, session->GetHeadLen(), msg_data));
+}
+
+bool AFCTCPServer::SendMsgSpans(
+    AFMsgHead* head, const AFBufferSpan* body, const size_t body_count, const int64_t session_id)
+{
+    ARK_ASSERT_RET_VAL(head != nullptr && (body != nullptr || body_count == 0), false);
+
+    AFScopeRLock guard(rw_lock_);
+    auto session = GetNetSession(session_id);
+    ARK_ASSERT_RET_VAL(session != nullptr, false);
+
+    return SendPacket(session, head, MakePacket(head, session->GetHeadLen(), body, body_count));
+}
+
+bool AFCTCPServer::SendPacket(AFTCPSessionPtr session, const AFMsgHead* head, const AFNetPacketPtr& packet)
+{
+    ARK_ASSERT_RET_VAL(packet != nullptr, false);
+
     AFHeadLength head_length = static_cast<AFHeadLength>(session->GetHeadLen());
     ARK_ASSERT_RET_VAL(
         (head_length == AFHeadLength::CS_HEAD_LENGTH) || (head_length == AFHeadLength::SS_HEAD_LENGTH), false);
 
-    std::string buffer;
-    buffer.append(reinterpret_cast<char*>(head), session->GetHeadLen());
-
-    if (buffer.empty())
+    const AFNetSendLimit& limit = GetSendLimit();
+    const AFNetSendQueuePtr& queue = session->GetSendQueue();
+    if (queue->GetQueueSize() + packet->size() > limit.hard_limit_)
     {
+        // slow consumer, the disconnected event comes from brynet
+        if (queue->SetOverflow())
+        {
+            ++kicked_count_;
+            session->GetSession()->postDisConnect();
+        }
+
         return false;
     }
 
-    buffer.append(msg_data, head->length_);
-    session->GetSession()->send(buffer.c_str(), buffer.length());
+    // only absolute state of one entity can be coalesced, 0 means send it as usual
+    int64_t entity_id = 0;
+    const NET_COALESCE_KEY_FUNCTOR* key_functor = (queue->IsCongested() ? GetLowPriorityMsg(head->id_) : nullptr);
+    if (key_functor != nullptr)
+    {
+        entity_id = (*key_functor)(packet->data() + session->GetHeadLen(), head->length_);
+    }
+
+    if (entity_id != 0)
+    {
+        int64_t actor_id =
+            (head_length == AFHeadLength::SS_HEAD_LENGTH ? static_cast<const AFSSMsgHead*>(head)->actor_id_ : 0);
+        switch (queue->Coalesce(head->id_, actor_id, entity_id, packet))
+        {
+            case AFNetSendQueue::Result::COALESCED:
+                return true;
+            case AFNetSendQueue::Result::REPLACED:
+                ++coalesced_count_;
+                return true;
+            case AFNetSendQueue::Result::DROPPED:
+                ++dropped_count_;
+                return false;
+            default:
+                break;
+        }
+    }
+
+    QueuePacket(session, packet);
     return true;
 }
 
+void AFCTCPServer::QueuePacket(AFTCPSessionPtr session, const AFNetPacketPtr& packet)
+{
+    const AFNetSendQueuePtr& queue = session->GetSendQueue();
+    size_t packet_size = packet->size();
+    if (queue->AddQueued(packet_size, GetSendLimit()))
+    {
+        // may be a dispatcher worker, the main thread raises the event
+        congest_sessions_.Push(session->GetSessionId());
+    }
+
+    // brynet keeps the packet pointer, no more copy
+    session->GetSession()->send(packet, [queue, packet_size]() { queue->RemoveQueued(packet_size); });
+}
+
+AFNetEvent* AFCTCPServer::CreateSendEvent(AFTCPSessionPtr session, const AFNetEventType type)
+{
+    AFNetEvent* event = AFNetEvent::AllocEvent();
+    ARK_ASSERT_RET_VAL(event != nullptr, nullptr);
+
+    event->SetId(session->GetSessionId());
+    event->SetType(type);
+    event->SetBusId(bus_id_);
+    event->SetIP(session->GetSession()->getIP());
+    return event;
+}
+
+size_t AFCTCPServer::GetSendQueueSize(const int64_t session_id)
+{
+    AFScopeRLock guard(rw_lock_);
+    auto session = GetNetSession(session_id);
+    if (session == nullptr)
+    {
+        return 0;
+    }
+
+    return session->GetSendQueue()->GetQueueSize();
+}
+
+void AFCTCPServer::GetSendStats(AFNetSendStats& stats)
+{
+    stats = AFNetSendStats();
+
+    {
+        AFScopeRLock guard(rw_lock_);
+        for (auto& iter : sessions_)
+        {
+            auto session = iter.second;
+            if (session == nullptr)
+            {
+                continue;
+            }
+
+            const AFNetSendQueuePtr& queue = session->GetSendQueue();
+            size_t queue_size = queue->GetQueueSize();
+            stats.queue_size_ += queue_size;
+            stats.max_queue_size_ = std::max(stats.max_queue_size_, queue_size);
+            if (queue->IsCongested())
+            {
+                ++stats.congested_count_;
+            }
+        }
+    }
+
+    stats.coalesced_count_ = coalesced_count_;
+    stats.dropped_count_ = dropped_count_;
+    stats.kicked_count_ = kicked_count_;
+}
+
 bool AFCTCPServer::BroadcastMsg(AFMsgHead* head, const char* msg_data)
 {
     ARK_ASSERT_RET_VAL(head != nullptr && msg_data != nullptr, false);
 
+    AFScopeRLock guard(rw_lock_);
+
     if (sessions_.empty())
     {
         return false;
     }
 
-    auto iter = sessions_.begin();
-    auto first_session = iter->second;
-    if (first_session == nullptr)
+    // all sessions of a server share the same head length
+    auto first_session = sessions_.begin()->second;
+    ARK_ASSERT_RET_VAL(first_session != nullptr, false);
+
+    AFNetPacketPtr packet = MakePacket(head, first_session->GetHeadLen(), msg_data);
+    ARK_ASSERT_RET_VAL(packet != nullptr, false);
+
+    for (auto& iter : sessions_)
     {
-        return false;
+        auto session = iter.second;
+        if (session != nullptr && !session->NeedRemove())
+        {
+            SendPacket(session, head, packet);
+        }
     }
 
-    char* new_buffer = reinterpret_cast<char*>(head);
+    return true;
+}
+
+bool AFCTCPServer::MulticastMsg(AFMsgHead* head, const char* msg_data, const std::vector<int64_t>& session_list)
+{
+    ARK_ASSERT_RET_VAL(head != nullptr && msg_data != nullptr, false);
 
-    uint32_t new_buffer_len = first_session->GetHeadLen() + head->length_;
-    memcpy(new_buffer + first_session->GetHeadLen(), msg_data, head->length_);
+    AFScopeRLock guard(rw_lock_);
 
-    for (auto& session : sessions_)
+    AFNetPacketPtr packet{nullptr};
+    for (auto session_id : session_list)
     {
-        session.second->GetSession()->send(new_buffer, new_buffer_len);
+        auto session = GetNetSession(session_id);
+        if (session == nullptr || session->NeedRemove())
+        {
+            continue;
+        }
+
+        if (packet == nullptr)
+        {
+            packet = MakePacket(head, session->GetHeadLen(), msg_data);
+            ARK_ASSERT_RET_VAL(packet != nullptr, false);
+        }
+
+        SendPacket(session, head, packet);
     }
 
-    return true;
+    return (packet != nullptr);
 }
 
 } // namespace ark
@@ -88,6 +88,10 @@ bool AFCWebSocketClient::StartClient(
                 AFScopeRLock xGuard(shared_this->rw_lock_);
                 shared_this->client_session_ptr_->AddBuffer(payload.c_str(), payload.size());
                 shared_this->client_session_ptr_->ParseBufferToMsg();
+                if (shared_this->client_session_ptr_->IsBroken())
+                {
+                    httpSession->postClose();
+                }
             }
         });
 
@@ -142,6 +146,7 @@ void AFCWebSocketClient::Update()
 
 void AFCWebSocketClient::UpdateNetSession()
 {
+    AFNetFrameBudget& budget = BeginFrameBudget();
     if (client_session_ptr_ == nullptr)
     {
         return;
@@ -150,7 +155,7 @@ void AFCWebSocketClient::UpdateNetSession()
     {
         AFScopeRLock guard(rw_lock_);
         UpdateNetEvent(client_session_ptr_.get());
-        UpdateNetMsg(client_session_ptr_.get());
+        UpdateNetMsg(client_session_ptr_.get(), budget);
     }
 
     if (client_session_ptr_->NeedRemove())
@@ -173,20 +178,21 @@ void AFCWebSocketClient::UpdateNetEvent(AFHttpSessionPtr session)
     }
 }
 
-void AFCWebSocketClient::UpdateNetMsg(AFHttpSessionPtr session)
+void AFCWebSocketClient::UpdateNetMsg(AFHttpSessionPtr session, AFNetFrameBudget& budget)
 {
     ARK_ASSERT_RET_NONE(session != nullptr);
 
     AFNetMsg* msg{nullptr};
-    int msg_count = 0;
+    size_t msg_count = 0;
     while (session->PopNetMsg(msg))
     {
         net_msg_cb_(msg);
         AFNetMsg::Release(msg);
 
         ++msg_count;
-        if (msg_count > ARK_PROCESS_NET_MSG_COUNT_ONCE)
+        if (msg_count % AFNetFrameBudget::SLICE_MSG_COUNT == 0 && budget.Expired())
         {
+            budget.AddDeferred(session->GetNetMsgCount());
             break;
         }
     }
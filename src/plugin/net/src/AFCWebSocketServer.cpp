@@ -104,6 +104,10 @@ bool AFCWebSocketServer::StartServer(AFHeadLength head_len, const int busid, con
 
                     session_ptr->AddBuffer(payload.c_str(), payload.size());
                     session_ptr->ParseBufferToMsg();
+                    if (session_ptr->IsBroken())
+                    {
+                        httpSession->postClose();
+                    }
                 }
             });
 
@@ -149,6 +153,7 @@ bool AFCWebSocketServer::StartServer(AFHeadLength head_len, const int busid, con
 
 void AFCWebSocketServer::UpdateNetSession()
 {
+    AFNetFrameBudget& budget = BeginFrameBudget();
     std::list<AFGUID> remove_sessions;
 
     {
@@ -162,7 +167,7 @@ void AFCWebSocketServer::UpdateNetSession()
             }
 
             UpdateNetEvent(session);
-            UpdateNetMsg(session);
+            UpdateNetMsg(session, budget);
 
             if (!session->NeedRemove())
             {
@@ -201,20 +206,21 @@ void AFCWebSocketServer::UpdateNetEvent(AFHttpSessionPtr session)
     }
 }
 
-void AFCWebSocketServer::UpdateNetMsg(AFHttpSessionPtr session)
+void AFCWebSocketServer::UpdateNetMsg(AFHttpSessionPtr session, AFNetFrameBudget& budget)
 {
     ARK_ASSERT_RET_NONE(session != nullptr);
 
     AFNetMsg* msg{nullptr};
-    int msg_count = 0;
+    size_t msg_count = 0;
     while (session->PopNetMsg(msg))
     {
         net_msg_cb_(msg);
         AFNetMsg::Release(msg);
 
         ++msg_count;
-        if (msg_count > ARK_PROCESS_NET_MSG_COUNT_ONCE)
+        if (msg_count % AFNetFrameBudget::SLICE_MSG_COUNT == 0 && budget.Expired())
         {
+            budget.AddDeferred(session->GetNetMsgCount());
             break;
         }
     }
@@ -36,6 +36,9 @@ public:
 
     bool RemoveTimer(const uint64_t timer_id) override;
 
+    void PauseTimer(const AFGUID& entity_id) override;
+    void ResumeTimer(const AFGUID& entity_id) override;
+
 protected:
     uint64_t AddSingleTimer(const AFGUID& entity_id, const std::chrono::milliseconds interval, const uint32_t count,
         TIMER_FUNCTOR&& cb) override;
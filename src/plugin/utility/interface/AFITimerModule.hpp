@@ -47,6 +47,10 @@ public:
     virtual bool RemoveTimer(const uint64_t timer_id) = 0;
     //virtual bool RemoveTimer(const std::string& name, const AFGUID& entity_id) = 0;
 
+    // hold all timers of the entity, e.g. while it is migrating
+    virtual void PauseTimer(const AFGUID& entity_id) = 0;
+    virtual void ResumeTimer(const AFGUID& entity_id) = 0;
+
 protected:
     virtual uint64_t AddSingleTimer(const AFGUID& entity_id, const std::chrono::milliseconds interval,
         const uint32_t count, TIMER_FUNCTOR&& cb) = 0;
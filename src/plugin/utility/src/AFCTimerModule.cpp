@@ -47,6 +47,16 @@ bool AFCTimerModule::RemoveTimer(const uint64_t timer_id)
     return timer_manager_ptr->RemoveTimer(timer_id);
 }
 
+void AFCTimerModule::PauseTimer(const AFGUID& entity_id)
+{
+    timer_manager_ptr->PauseTimer(entity_id);
+}
+
+void AFCTimerModule::ResumeTimer(const AFGUID& entity_id)
+{
+    timer_manager_ptr->ResumeTimer(entity_id);
+}
+
 uint64_t AFCTimerModule::AddSingleTimer(
     const AFGUID& entity_id, const std::chrono::milliseconds interval, const uint32_t count, TIMER_FUNCTOR&& cb)
 {
@@ -40,6 +40,7 @@ public:
     bool Init() override;
     bool PostInit() override;
     //bool PreUpdate() override;
+    bool Update() override;
 
     void SendMsgPBToGate(const uint16_t nMsgID, google::protobuf::Message& xMsg, const AFGUID& self) override;
     void SendMsgPBToGate(const uint16_t nMsgID, const std::string& strMsg, const AFGUID& self) override;
@@ -90,6 +91,31 @@ protected:
 
     int CommonClassDestoryEvent(const AFGUID& self);
 
+    // enter data of an entity, built once and reused for all observers until it changes
+    struct EnterSnapshot
+    {
+        uint32_t data_version_{0};
+        bool data_valid_{false};
+        // serialized multi_entity_data_list with only this entity, could be concatenated
+        std::string node_data_;
+        std::string table_data_;
+
+        int32_t map_id_{0};
+        AFVector3D pos_;
+        bool enter_valid_{false};
+        // serialized AckEntityEnterList with only this entity, could be concatenated
+        std::string enter_data_;
+    };
+
+    const EnterSnapshot& GetEnterSnapshot(std::shared_ptr<AFIEntity> pEntity);
+
+    // enter and leave notify are batched and sent in Update,
+    // or earlier when anything else is sent to the observer
+    void AddEnterNotify(const AFGUID& observer, const AFGUID& target);
+    void AddLeaveNotify(const AFGUID& observer, const AFGUID& target);
+    void SendNotify();
+    void FlushNotify(const AFGUID& observer);
+
 private:
     //<PlayerID, GateBaseInfo>//其实可以在object系统中被代替
     // AFSmartPtrMap<AFGUID, GateBaseInfo> mRoleBaseData;
@@ -106,6 +132,13 @@ private:
     AFIMsgModule* m_pMsgModule;
 
     std::shared_ptr<AFINetServerService> m_pNetServerService;
+
+    std::unordered_map<AFGUID, EnterSnapshot> enter_snapshots_;
+
+    // observer -> targets
+    using NotifyList = std::unordered_map<AFGUID, std::set<AFGUID>>;
+    NotifyList enter_notify_list_;
+    NotifyList leave_notify_list_;
 };
 
 } // namespace ark
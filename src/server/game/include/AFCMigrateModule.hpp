@@ -0,0 +1,88 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPluginManager.hpp"
+#include "proto/AFProtoCPP.hpp"
+#include "log/interface/AFILogModule.hpp"
+#include "kernel/interface/AFIKernelModule.hpp"
+#include "utility/interface/AFITimerModule.hpp"
+#include "bus/interface/AFIBusModule.hpp"
+#include "bus/interface/AFIMsgModule.hpp"
+#include "net/interface/AFINetServiceManagerModule.hpp"
+#include "game/interface/AFIGameNetModule.hpp"
+#include "game/interface/AFIMigrateModule.hpp"
+
+namespace ark {
+
+// Live entity migration between game processes.
+//
+// source: hold messages -> ENTITY_EVT_MIGRATE_OUT -> freeze -> send entity -> wait ack -> route proxies -> destroy
+// target: create entity with the same guid -> ENTITY_EVT_MIGRATE_IN -> ack
+// timeout: tell the target to destroy the copy it may have created, then unfreeze
+//
+// Games are not linked to each other or to proxies, every message is relayed by world.
+//
+// Timers are functors and can not be sent, modules save what they need into entity data on
+// ENTITY_EVT_MIGRATE_OUT and restart their timers on ENTITY_EVT_MIGRATE_IN.
+class AFCMigrateModule final : public AFIMigrateModule
+{
+    ARK_DECLARE_MODULE_FUNCTIONS
+public:
+    bool Init() override;
+    bool Update() override;
+
+    bool MigrateEntity(const AFGUID& self, const int target_bus) override;
+    bool IsMigrating(const AFGUID& self) override;
+
+protected:
+    void OnMigrateEntity(const AFNetMsg* msg);
+    void OnMigrateEntityAck(const AFNetMsg* msg);
+    void OnMigrateDestroy(const AFNetMsg* msg);
+    void OnWorldSocketEvent(const AFNetEvent* event);
+
+    void OnMigrateFail(const AFGUID& self);
+
+    bool RegMsgCallback();
+
+private:
+    // give up if target does not answer in time
+    static const int64_t MIGRATE_TIMEOUT = 10 * AFTimespan::SECOND_MS;
+
+    struct MigrateData
+    {
+        int target_bus_{0};
+        int64_t start_time_{0};
+    };
+
+    std::map<AFGUID, MigrateData> migrating_list_;
+    bool reg_msg_callback_{false};
+
+    AFIKernelModule* m_pKernelModule;
+    AFILogModule* m_pLogModule;
+    AFIBusModule* m_pBusModule;
+    AFIMsgModule* m_pMsgModule;
+    AFINetServiceManagerModule* m_pNetServiceManagerModule;
+    AFIGameNetModule* m_pGameNetModule;
+    AFITimerModule* m_pTimerModule;
+};
+
+} // namespace ark
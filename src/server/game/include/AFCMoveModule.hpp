@@ -0,0 +1,168 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "base/AFPluginManager.hpp"
+#include "proto/AFProtoCPP.hpp"
+#include "log/interface/AFILogModule.hpp"
+#include "kernel/interface/AFIKernelModule.hpp"
+#include "kernel/interface/AFIMapModule.hpp"
+#include "bus/interface/AFIMsgModule.hpp"
+#include "game/interface/AFIGameNetModule.hpp"
+#include "game/interface/AFIMoveModule.hpp"
+
+namespace ark {
+
+// Movement pipeline, once per frame:
+// 1. collect move inputs into flat arrays
+// 2. check speed of all inputs in one pass
+// 3. apply accepted positions, move events (AOI) fire once per entity
+// 4. dead-reckoning, only entities whose predicted position drifts too far are synced,
+//    with quantized deltas batched per observer in VIEW_DISTANCE
+//
+// A delta is only meaningful to an observer which has the last sync, an observer gets a key frame
+// of an entity the first time it sees it after entering the view or the scene.
+class AFCMoveModule final : public AFIMoveModule
+{
+    ARK_DECLARE_MODULE_FUNCTIONS
+public:
+    // 1/16 meter
+    static constexpr float POSITION_SCALE = 16.0f;
+    static constexpr float ORIENT_SCALE = 100.0f;
+    static constexpr float PI = 3.14159265f;
+
+    static constexpr float DEFAULT_MAX_SPEED = 10.0f;
+    // allowance for network jitter
+    static constexpr float SPEED_TOLERANCE = 1.2f;
+    // dead-reckoning error before a sync, in meter
+    static constexpr float SYNC_DISTANCE = 0.5f;
+    // about 5 degrees, orient is in radian
+    static constexpr float SYNC_ORIENT = 0.1f;
+    // observers farther than this get no sync, in meter
+    static constexpr float VIEW_DISTANCE = 50.0f;
+    // absolute position is resent every KEY_FRAME_INTERVAL ms
+    static const int64_t KEY_FRAME_INTERVAL = 5 * AFTimespan::SECOND_MS;
+    // longest time span used for speed check
+    static const int64_t MAX_MOVE_INTERVAL = AFTimespan::SECOND_MS;
+    // larger quantized deltas are sent as key frame
+    static const int32_t MAX_DELTA = 1 << 14;
+    // move requests of one client per second
+    static const uint32_t MAX_MOVE_RATE = 30;
+
+    bool Init() override;
+    bool Update() override;
+
+    bool AddMoveInput(const AFGUID& self, const AFVector3D& pos, const float orient) override;
+    void SetMaxSpeed(const AFGUID& self, const float speed) override;
+    bool GetSyncPosition(const AFGUID& self, AFVector3D& pos) override;
+
+protected:
+    int OnClassEvent(
+        const AFGUID& self, const std::string& class_name, const ArkEntityEvent class_event, const AFIDataList& args);
+    int OnLeaveScene(const AFGUID& self, const int map_id, const int map_inst_id);
+
+    bool RegMsgCallback();
+    void OnReqMove(const AFNetMsg* msg);
+    void TakeMoveRequest();
+
+    void GatherInput(const int64_t now);
+    void ValidateInput();
+    void ApplyInput(const int64_t now);
+    void SyncMove(const int64_t now);
+
+    void SendCorrect(const AFGUID& self, std::shared_ptr<AFIEntity> pEntity);
+
+    // one synced entity, serialized AckMoveDeltaList with only this entity, could be concatenated
+    struct SyncItem
+    {
+        AFGUID id_{NULL_GUID};
+        AFVector3D pos_;
+        std::string delta_data_;
+        std::string key_data_;
+        // key frame without velocity, the observer stops predicting when the entity leaves view
+        std::string stop_data_;
+    };
+
+    void SendMoveDelta(const int map_id, const int inst_id, const std::vector<SyncItem>& items);
+    void RemoveView(const AFGUID& self);
+
+private:
+    struct MoveState
+    {
+        float max_speed_{DEFAULT_MAX_SPEED};
+
+        // last accepted move
+        int64_t move_time_{0};
+        AFVector3D velocity_;
+        bool moved_{false};
+
+        // last sync, position is quantized
+        bool synced_{false};
+        int64_t sync_time_{0};
+        int64_t key_frame_time_{0};
+        int32_t sync_x_{0};
+        int32_t sync_y_{0};
+        int32_t sync_z_{0};
+        AFVector3D sync_velocity_;
+        float sync_orient_{0.0f};
+    };
+
+    MoveState& GetMoveState(const AFGUID& self);
+
+    std::unordered_map<AFGUID, MoveState> move_states_;
+
+    // observer -> entities it has the last sync of
+    std::unordered_map<AFGUID, std::unordered_set<AFGUID>> observer_views_;
+
+    // client requests, handlers may run in net logic threads
+    struct MoveRequest
+    {
+        AFGUID id_{NULL_GUID};
+        AFVector3D pos_;
+        float orient_{0.0f};
+    };
+
+    std::mutex request_mutex_;
+    std::vector<MoveRequest> move_requests_;
+    std::vector<MoveRequest> take_requests_;
+    bool reg_msg_callback_{false};
+
+    // inputs of this frame, structure of arrays for the bulk speed check
+    std::unordered_map<AFGUID, size_t> input_index_;
+    std::vector<AFGUID> input_ids_;
+    std::vector<std::shared_ptr<AFIEntity>> input_entities_;
+    std::vector<float> input_x_;
+    std::vector<float> input_y_;
+    std::vector<float> input_z_;
+    std::vector<float> input_orient_;
+    std::vector<float> old_x_;
+    std::vector<float> old_y_;
+    std::vector<float> old_z_;
+    std::vector<float> max_distance_sq_;
+    std::vector<uint8_t> valid_;
+
+    AFIKernelModule* m_pKernelModule;
+    AFIMapModule* m_pMapModule;
+    AFILogModule* m_pLogModule;
+    AFIGameNetModule* m_pGameNetModule;
+};
+
+} // namespace ark
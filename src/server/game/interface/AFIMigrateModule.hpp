@@ -0,0 +1,38 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "interface/AFIModule.hpp"
+#include "base/AFDefine.hpp"
+
+namespace ark {
+
+class AFIMigrateModule : public AFIModule
+{
+public:
+    // freeze an entity and move it to another game process, the entity keeps its guid
+    virtual bool MigrateEntity(const AFGUID& self, const int target_bus) = 0;
+
+    // a migrating entity is frozen, its client messages are dropped by the game server
+    virtual bool IsMigrating(const AFGUID& self) = 0;
+};
+
+} // namespace ark
@@ -0,0 +1,43 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "interface/AFIModule.hpp"
+#include "base/AFDefine.hpp"
+#include "base/AFVector3D.hpp"
+
+namespace ark {
+
+class AFIMoveModule : public AFIModule
+{
+public:
+    // queue a move input, EGMI_REQ_MOVE of clients comes here too, inputs are validated and applied together in Update,
+    // a later input of the same entity in one frame overrides the former
+    virtual bool AddMoveInput(const AFGUID& self, const AFVector3D& pos, const float orient) = 0;
+
+    // max speed in meter per second, inputs faster than it are rejected
+    virtual void SetMaxSpeed(const AFGUID& self, const float speed) = 0;
+
+    // position last synced to clients, base of the following deltas
+    virtual bool GetSyncPosition(const AFGUID& self, AFVector3D& pos) = 0;
+};
+
+} // namespace ark
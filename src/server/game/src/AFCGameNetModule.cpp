@@ -21,6 +21,7 @@
 #include "base/AFEventDefine.hpp"
 #include "game/include/AFCGameNetModule.hpp"
 #include "kernel/include/AFCDataList.hpp"
+#include "kernel/include/AFDataListView.hpp"
 
 namespace ark {
 
@@ -51,6 +52,13 @@ bool AFCGameNetModule::Init()
 
 bool AFCGameNetModule::PostInit()
 {
+    // a correction carries the absolute position, a congested proxy link only needs the newest one of a player
+    m_pNetServiceManagerModule->SetLowPriorityMsg(
+        AFMsg::EGMI_ACK_MOVE_CORRECT, [](const char* msg_data, const uint32_t msg_len) -> int64_t {
+            AFMsg::AckMoveCorrect msg;
+            return (msg.ParseFromArray(msg_data, msg_len) ? msg.entity_id() : 0);
+        });
+
     StartServer();
     return true;
 }
@@ -111,6 +119,167 @@ int AFCGameNetModule::StartServer()
 //    return 0;
 //}
 
+bool AFCGameNetModule::Update()
+{
+    SendNotify();
+    return true;
+}
+
+const AFCGameNetModule::EnterSnapshot& AFCGameNetModule::GetEnterSnapshot(std::shared_ptr<AFIEntity> pEntity)
+{
+    const auto& self = pEntity->GetID();
+    auto& snapshot = enter_snapshots_[self];
+
+    if (!snapshot.data_valid_ || snapshot.data_version_ != pEntity->GetDataVersion())
+    {
+        ArkMaskType mask;
+        mask[(size_t)ArkDataMask::PF_SYNC_VIEW] = 1;
+
+        AFMsg::multi_entity_data_list node_msg;
+        AFMsg::pb_entity* node_entity = node_msg.add_data_list();
+        node_entity->set_id(self);
+        m_pKernelModule->EntityNodeToPBData(pEntity, node_entity->mutable_data(), mask);
+
+        AFMsg::multi_entity_data_list table_msg;
+        AFMsg::pb_entity* table_entity = table_msg.add_data_list();
+        table_entity->set_id(self);
+        m_pKernelModule->EntityTableToPBData(pEntity, table_entity->mutable_data(), mask);
+
+        snapshot.node_data_.clear();
+        snapshot.table_data_.clear();
+        node_msg.SerializeToString(&snapshot.node_data_);
+        table_msg.SerializeToString(&snapshot.table_data_);
+
+        snapshot.data_version_ = pEntity->GetDataVersion();
+        snapshot.data_valid_ = true;
+        snapshot.enter_valid_ = false;
+    }
+
+    // position changes much more often than data, check it by value
+    if (!snapshot.enter_valid_ || snapshot.map_id_ != pEntity->GetMapID() || snapshot.pos_ != pEntity->GetPosition())
+    {
+        snapshot.map_id_ = pEntity->GetMapID();
+        snapshot.pos_ = pEntity->GetPosition();
+
+        AFMsg::AckEntityEnterList enter_msg;
+        AFMsg::EntityEnterInfo* pEnterInfo = enter_msg.add_entity_list();
+        pEnterInfo->set_object_guid(self);
+        *pEnterInfo->mutable_pos() = AFIMsgModule::VecToPB(snapshot.pos_);
+        if (pEntity->GetClassName() == AFEntityMetaPlayer::self_name())
+        {
+            pEnterInfo->set_career_type(pEntity->GetInt32(AFEntityMetaPlayer::career_index()));
+        }
+        pEnterInfo->set_config_id(pEntity->GetConfigID());
+        pEnterInfo->set_scene_id(snapshot.map_id_);
+        pEnterInfo->set_class_id(pEntity->GetClassName());
+
+        snapshot.enter_data_.clear();
+        enter_msg.SerializeToString(&snapshot.enter_data_);
+        snapshot.enter_valid_ = true;
+    }
+
+    return snapshot;
+}
+
+void AFCGameNetModule::AddEnterNotify(const AFGUID& observer, const AFGUID& target)
+{
+    if (observer == NULL_GUID || target == NULL_GUID)
+    {
+        return;
+    }
+
+    enter_notify_list_[observer].insert(target);
+}
+
+void AFCGameNetModule::AddLeaveNotify(const AFGUID& observer, const AFGUID& target)
+{
+    if (observer == NULL_GUID || target == NULL_GUID)
+    {
+        return;
+    }
+
+    // entered and left in the same frame, the observer never knows it
+    auto iter = enter_notify_list_.find(observer);
+    if (iter != enter_notify_list_.end() && iter->second.erase(target) > 0)
+    {
+        return;
+    }
+
+    leave_notify_list_[observer].insert(target);
+}
+
+void AFCGameNetModule::SendNotify()
+{
+    while (!leave_notify_list_.empty())
+    {
+        FlushNotify(leave_notify_list_.begin()->first);
+    }
+
+    while (!enter_notify_list_.empty())
+    {
+        FlushNotify(enter_notify_list_.begin()->first);
+    }
+}
+
+void AFCGameNetModule::FlushNotify(const AFGUID& observer)
+{
+    // taken out before sending, sending to the observer flushes it again
+    std::set<AFGUID> leave_list;
+    auto leave_iter = leave_notify_list_.find(observer);
+    if (leave_iter != leave_notify_list_.end())
+    {
+        leave_list.swap(leave_iter->second);
+        leave_notify_list_.erase(leave_iter);
+    }
+
+    std::set<AFGUID> enter_list;
+    auto enter_iter = enter_notify_list_.find(observer);
+    if (enter_iter != enter_notify_list_.end())
+    {
+        enter_list.swap(enter_iter->second);
+        enter_notify_list_.erase(enter_iter);
+    }
+
+    // leave first, an entity may leave and enter again in the same frame
+    if (!leave_list.empty())
+    {
+        AFMsg::AckEntityLeaveList msg;
+        for (auto& target : leave_list)
+        {
+            msg.add_entity_list(target);
+        }
+
+        SendMsgPBToGate(AFMsg::EGMI_ACK_ENTITY_LEAVE, msg, observer);
+    }
+
+    // repeated fields of serialized messages could be concatenated, no message is rebuilt per observer
+    std::string enter_data;
+    std::string node_data;
+    std::string table_data;
+    for (auto& target : enter_list)
+    {
+        auto pEntity = m_pKernelModule->GetEntity(target);
+        if (pEntity == nullptr)
+        {
+            continue;
+        }
+
+        const auto& snapshot = GetEnterSnapshot(pEntity);
+        enter_data.append(snapshot.enter_data_);
+        node_data.append(snapshot.node_data_);
+        table_data.append(snapshot.table_data_);
+    }
+
+    if (enter_data.empty())
+    {
+        return;
+    }
+
+    SendMsgPBToGate(AFMsg::EGMI_ACK_ENTITY_ENTER, enter_data, observer);
+    SendMsgPBToGate(AFMsg::EGMI_ACK_ENTITY_DATA_NODE_ENTER, node_data, observer);
+    SendMsgPBToGate(AFMsg::EGMI_ACK_ENTITY_DATA_TABLE_ENTER, table_data, observer);
+}
+
 int AFCGameNetModule::OnViewDataNodeEnter(const AFIDataList& argVar, const AFGUID& self)
 {
     if (argVar.GetCount() <= 0 || self == 0)
@@ -124,13 +293,7 @@ int AFCGameNetModule::OnViewDataNodeEnter(const AFIDataList& argVar, const AFGUI
         return 0;
     }
 
-    AFMsg::multi_entity_data_list msg;
-    AFMsg::pb_entity* entity = msg.add_data_list();
-    entity->set_id(self);
-
-    ArkMaskType mask;
-    mask[(size_t)ArkDataMask::PF_SYNC_VIEW] = 1;
-    m_pKernelModule->EntityNodeToPBData(pEntity, entity->mutable_data(), mask);
+    const auto& snapshot = GetEnterSnapshot(pEntity);
 
     for (size_t i = 0; i < argVar.GetCount(); i++)
     {
@@ -138,7 +301,7 @@ int AFCGameNetModule::OnViewDataNodeEnter(const AFIDataList& argVar, const AFGUI
 
         if (self != identOther)
         {
-            SendMsgPBToGate(AFMsg::EGMI_ACK_ENTITY_DATA_NODE_ENTER, msg, identOther);
+            SendMsgPBToGate(AFMsg::EGMI_ACK_ENTITY_DATA_NODE_ENTER, snapshot.node_data_, identOther);
         }
     }
 
@@ -210,21 +373,15 @@ int AFCGameNetModule::OnViewDataTableEnter(const AFIDataList& argVar, const AFGU
         return 1;
     }
 
-    AFMsg::multi_entity_data_list msg;
-    AFMsg::pb_entity* entity = msg.add_data_list();
-    entity->set_id(self);
-
-    ArkMaskType mask;
-    mask[(size_t)ArkDataMask::PF_SYNC_VIEW] = 1;
-    m_pKernelModule->EntityTableToPBData(pEntity, entity->mutable_data(), mask);
+    const auto& snapshot = GetEnterSnapshot(pEntity);
 
     for (size_t i = 0; i < argVar.GetCount(); i++)
     {
         AFGUID identOther = argVar.Int64(i);
 
-        if (self != identOther && msg.data_list_size() > 0)
+        if (self != identOther)
         {
-            SendMsgPBToGate(AFMsg::EGMI_ACK_ENTITY_DATA_TABLE_ENTER, msg, identOther);
+            SendMsgPBToGate(AFMsg::EGMI_ACK_ENTITY_DATA_TABLE_ENTER, snapshot.table_data_, identOther);
         }
     }
 
@@ -238,41 +395,40 @@ bool AFCGameNetModule::ProcessLeaveGroup(const AFGUID& self, int map_id, int old
         return false;
     }
 
+    auto pSelf = m_pKernelModule->GetEntity(self);
+    bool self_is_player = (pSelf != nullptr && pSelf->GetClassName() == AFEntityMetaPlayer::self_name());
+
     AFCDataList valueAllOldObjectList;
-    AFCDataList valueAllOldPlayerList;
     m_pMapModule->GetInstEntityList(map_id, old_inst_id, valueAllOldObjectList);
 
-    if (valueAllOldObjectList.GetCount() > 0)
+    for (size_t i = 0; i < valueAllOldObjectList.GetCount(); i++)
     {
-        //broadcast self to others around
-        for (size_t i = 0; i < valueAllOldObjectList.GetCount(); i++)
+        AFGUID identBC = valueAllOldObjectList.Int64(i);
+        if (identBC == self)
         {
-            AFGUID identBC = valueAllOldObjectList.Int64(i);
-            auto pEntity = m_pKernelModule->GetEntity(identBC);
-            if (pEntity == nullptr)
-            {
-                continue;
-            }
-
-            if (valueAllOldObjectList.Int64(i) == self)
-            {
-                valueAllOldObjectList.SetInt64(i, 0);
-            }
+            continue;
+        }
 
-            const std::string& class_name = pEntity->GetClassName();
-            if (AFEntityMetaPlayer::self_name() == class_name)
-            {
-                valueAllOldPlayerList << identBC;
-            }
+        auto pEntity = m_pKernelModule->GetEntity(identBC);
+        if (pEntity == nullptr)
+        {
+            continue;
         }
 
-        OnEntityListLeave(valueAllOldPlayerList, AFCDataList() << self);
+        // broadcast self to others around
+        if (AFEntityMetaPlayer::self_name() == pEntity->GetClassName())
+        {
+            AddLeaveNotify(identBC, self);
+        }
 
-        //broadcast self that leave the map
-        OnEntityListLeave(AFCDataList() << self, valueAllOldObjectList);
+        // broadcast self that leave the map
+        if (self_is_player)
+        {
+            AddLeaveNotify(self, identBC);
+        }
     }
 
-    m_pKernelModule->DoEvent(self, AFED_ON_CLIENT_LEAVE_SCENE, AFCDataList() << old_inst_id);
+    m_pKernelModule->DoEvent(self, AFED_ON_CLIENT_LEAVE_SCENE, AFDataListView() << old_inst_id);
 
     return true;
 }
@@ -285,66 +441,41 @@ bool AFCGameNetModule::ProcessEnterGroup(const AFGUID& self, int nSceneID, int n
         return false;
     }
 
-    //exclude myself
-    //////////////////////////////////////////////////////////////////////////
+    auto pSelf = m_pKernelModule->GetEntity(self);
+    if (pSelf == nullptr)
+    {
+        return false;
+    }
+
+    bool self_is_player = (pSelf->GetClassName() == AFEntityMetaPlayer::self_name());
+
     AFCDataList valueAllObjectList;
-    AFCDataList valueAllObjectListNoSelf;
-    AFCDataList valuePlayerList;
-    AFCDataList valuePlayerListNoSelf;
     m_pMapModule->GetInstEntityList(nSceneID, nNewGroupID, valueAllObjectList);
 
     for (size_t i = 0; i < valueAllObjectList.GetCount(); i++)
     {
         AFGUID identBC = valueAllObjectList.Int64(i);
-        auto pEntity = m_pKernelModule->GetEntity(identBC);
-        if (pEntity == nullptr)
+        if (identBC == self)
         {
             continue;
         }
 
-        const std::string& class_name = pEntity->GetClassName();
-        if (AFEntityMetaPlayer::self_name() == class_name)
+        auto pEntity = m_pKernelModule->GetEntity(identBC);
+        if (pEntity == nullptr)
         {
-            valuePlayerList << identBC;
-
-            if (identBC != self)
-            {
-                valuePlayerListNoSelf << identBC;
-            }
+            continue;
         }
 
-        if (identBC != self)
+        // broadcast others that I'm here
+        if (AFEntityMetaPlayer::self_name() == pEntity->GetClassName())
         {
-            valueAllObjectListNoSelf << identBC;
+            AddEnterNotify(identBC, self);
         }
-    }
 
-    // broadcast others that I'm here(need exclude self)
-    if (valuePlayerListNoSelf.GetCount() > 0)
-    {
-        auto pEntity = m_pKernelModule->GetEntity(self);
-        if (pEntity == nullptr)
+        // broadcast others' data to myself
+        if (self_is_player)
         {
-            return false;
-        }
-
-        OnEntityListEnter(valuePlayerListNoSelf, AFCDataList() << self);
-        OnViewDataNodeEnter(valuePlayerListNoSelf, self);
-        OnViewDataTableEnter(valuePlayerListNoSelf, self);
-
-        const std::string class_name = pEntity->GetClassName();
-        if (class_name == AFEntityMetaPlayer::self_name())
-        {
-            OnEntityListEnter(AFCDataList() << self, valueAllObjectListNoSelf);
-
-            for (size_t i = 0; i < valueAllObjectListNoSelf.GetCount(); i++)
-            {
-                // broadcast myself data to others
-                AFGUID identOld = valueAllObjectListNoSelf.Int64(i);
-
-                OnViewDataNodeEnter(AFCDataList() << self, identOld);
-                OnViewDataTableEnter(AFCDataList() << self, identOld);
-            }
+            AddEnterNotify(self, identBC);
         }
     }
 
@@ -358,7 +489,7 @@ int AFCGameNetModule::OnEntityListEnter(const AFIDataList& self, const AFIDataLi
         return 1;
     }
 
-    AFMsg::AckEntityEnterList xEntityEnterList;
+    std::string enter_data;
 
     for (size_t i = 0; i < argVar.GetCount(); i++)
     {
@@ -376,22 +507,10 @@ int AFCGameNetModule::OnEntityListEnter(const AFIDataList& self, const AFIDataLi
             continue;
         }
 
-        AFMsg::EntityEnterInfo* pEnterInfo = xEntityEnterList.add_entity_list();
-        pEnterInfo->set_object_guid(identOld);
-        AFVector3D xPoint;
-        xPoint.x = pEntity->GetFloat("x");
-        xPoint.y = pEntity->GetFloat("y");
-        xPoint.z = pEntity->GetFloat("z");
-
-        *pEnterInfo->mutable_pos() = AFIMsgModule::VecToPB(xPoint);
-        pEnterInfo->set_career_type(pEntity->GetInt32("Job"));
-        pEnterInfo->set_player_state(pEntity->GetInt32("State"));
-        pEnterInfo->set_config_id(pEntity->GetConfigID());
-        pEnterInfo->set_scene_id(pEntity->GetMapID());
-        pEnterInfo->set_class_id(pEntity->GetClassName());
+        enter_data.append(GetEnterSnapshot(pEntity).enter_data_);
     }
 
-    if (xEntityEnterList.entity_list_size() <= 0)
+    if (enter_data.empty())
     {
         return 1;
     }
@@ -402,7 +521,7 @@ int AFCGameNetModule::OnEntityListEnter(const AFIDataList& self, const AFIDataLi
 
         if (ident != 0)
         {
-            SendMsgPBToGate(AFMsg::EGMI_ACK_ENTITY_ENTER, xEntityEnterList, ident);
+            SendMsgPBToGate(AFMsg::EGMI_ACK_ENTITY_ENTER, enter_data, ident);
         }
     }
 
@@ -459,8 +578,6 @@ int AFCGameNetModule::CommonClassDestoryEvent(const AFGUID& self)
     }
 
     AFCDataList valueAllObjectList;
-    AFCDataList valueBroadCaseList;
-    AFCDataList valueBroadListNoSelf;
     m_pMapModule->GetInstEntityList(map_id, map_inst_id, valueAllObjectList);
 
     for (size_t i = 0; i < valueAllObjectList.GetCount(); i++)
@@ -474,18 +591,12 @@ int AFCGameNetModule::CommonClassDestoryEvent(const AFGUID& self)
 
         const std::string& class_name = pBCEntity->GetClassName();
 
-        if (AFEntityMetaPlayer::self_name() == class_name)
+        if (AFEntityMetaPlayer::self_name() == class_name && identBC != self)
         {
-            valueBroadCaseList << identBC;
-
-            if (identBC != self)
-            {
-                valueBroadListNoSelf << identBC;
-            }
+            AddLeaveNotify(identBC, self);
         }
     }
 
-    OnEntityListLeave(valueBroadListNoSelf, AFCDataList() << self);
     return 0;
 }
 
@@ -496,6 +607,9 @@ int AFCGameNetModule::OnCommonClassEvent(
     {
         case ArkEntityEvent::ENTITY_EVT_DESTROY:
             CommonClassDestoryEvent(self);
+            enter_snapshots_.erase(self);
+            enter_notify_list_.erase(self);
+            leave_notify_list_.erase(self);
             break;
 
         case ArkEntityEvent::ENTITY_EVT_PRE_LOAD_DATA:
@@ -512,7 +626,7 @@ int AFCGameNetModule::OnCommonClassEvent(
             // Just broadcast to self
             if (strClassName == AFEntityMetaPlayer::self_name())
             {
-                OnEntityListEnter(AFCDataList() << self, AFCDataList() << self);
+                OnEntityListEnter(AFDataListView() << self, AFDataListView() << self);
 
                 OnSelfDataNodeEnter(self);
                 OnSelfDataTableEnter(self);
@@ -699,6 +813,9 @@ int AFCGameNetModule::OnEntityEvent(
 
 void AFCGameNetModule::SendMsgPBToGate(const uint16_t nMsgID, google::protobuf::Message& xMsg, const AFGUID& self)
 {
+    // the observer must know an entity before any update of it
+    FlushNotify(self);
+
     //std::shared_ptr<GateBaseInfo> pData = mRoleBaseData.find_value(self);
 
     //if (nullptr == pData)
@@ -716,6 +833,9 @@ void AFCGameNetModule::SendMsgPBToGate(const uint16_t nMsgID, google::protobuf::
 
 void AFCGameNetModule::SendMsgPBToGate(const uint16_t nMsgID, const std::string& strMsg, const AFGUID& self)
 {
+    // the observer must know an entity before any update of it
+    FlushNotify(self);
+
     //std::shared_ptr<GateBaseInfo> pData = mRoleBaseData.find_value(self);
 
     //if (nullptr == pData)
@@ -0,0 +1,281 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "base/AFMisc.hpp"
+#include "game/include/AFCMigrateModule.hpp"
+#include "kernel/include/AFDataListView.hpp"
+
+namespace ark {
+
+bool AFCMigrateModule::Init()
+{
+    m_pKernelModule = FindModule<AFIKernelModule>();
+    m_pLogModule = FindModule<AFILogModule>();
+    m_pBusModule = FindModule<AFIBusModule>();
+    m_pMsgModule = FindModule<AFIMsgModule>();
+    m_pNetServiceManagerModule = FindModule<AFINetServiceManagerModule>();
+    m_pGameNetModule = FindModule<AFIGameNetModule>();
+    m_pTimerModule = FindModule<AFITimerModule>();
+
+    return true;
+}
+
+bool AFCMigrateModule::Update()
+{
+    // game server is started asynchronously
+    if (!reg_msg_callback_)
+    {
+        reg_msg_callback_ = RegMsgCallback();
+    }
+
+    if (migrating_list_.empty())
+    {
+        return true;
+    }
+
+    auto now = GetPluginManager()->GetNowTime();
+    std::vector<AFGUID> timeout_list;
+    for (auto& iter : migrating_list_)
+    {
+        if (iter.second.start_time_ + MIGRATE_TIMEOUT <= now)
+        {
+            timeout_list.push_back(iter.first);
+        }
+    }
+
+    for (auto& id : timeout_list)
+    {
+        int target_bus = migrating_list_[id].target_bus_;
+        ARK_LOG_ERROR("migrate entity timeout, entity = {} target_bus = {}", id, target_bus);
+
+        // the entity may be created on target with the ack lost, it must not stay alive on both sides
+        AFMsg::msg_ss_migrate_destroy destroy;
+        destroy.set_entity_id(id);
+        destroy.set_src_bus(m_pBusModule->GetSelfBusID());
+        destroy.set_dst_bus(target_bus);
+        m_pMsgModule->SendMsgByRelay(
+            ARK_APP_TYPE::ARK_APP_WORLD, target_bus, AFMsg::E_SS_MSG_ID_MIGRATE_DESTROY, destroy);
+
+        OnMigrateFail(id);
+    }
+
+    return true;
+}
+
+bool AFCMigrateModule::RegMsgCallback()
+{
+    auto pNetServer = m_pGameNetModule->GetNetServerService();
+    auto pWorldClient = m_pNetServiceManagerModule->GetClientService(ARK_APP_TYPE::ARK_APP_WORLD);
+    if (pNetServer == nullptr || pWorldClient == nullptr)
+    {
+        return false;
+    }
+
+    // client messages of a migrating entity are dropped, its state is already on the way
+    pNetServer->RegActorFilter([this](const int64_t actor_id) { return !IsMigrating(actor_id); });
+
+    // sent without actor id, so they are handled in main thread
+    pWorldClient->RegMsgCallback(AFMsg::E_SS_MSG_ID_MIGRATE_ENTITY, this, &AFCMigrateModule::OnMigrateEntity);
+    pWorldClient->RegMsgCallback(AFMsg::E_SS_MSG_ID_MIGRATE_ENTITY_ACK, this, &AFCMigrateModule::OnMigrateEntityAck);
+    pWorldClient->RegMsgCallback(AFMsg::E_SS_MSG_ID_MIGRATE_DESTROY, this, &AFCMigrateModule::OnMigrateDestroy);
+    pWorldClient->RegNetEventCallback(this, &AFCMigrateModule::OnWorldSocketEvent);
+
+    // world may be connected before the callback
+    auto busid = m_pBusModule->GetSelfBusID();
+    auto pConnection = pWorldClient->GetSuitableConnect(AFMisc::ToString(busid));
+    if (pConnection != nullptr && pConnection->net_state_ == AFConnectionData::CONNECTED)
+    {
+        AFMsg::msg_ss_migrate_register reg;
+        reg.set_bus_id(busid);
+        m_pMsgModule->SendMsgByBusID(pConnection->server_bus_id_, AFMsg::E_SS_MSG_ID_MIGRATE_REGISTER, reg);
+    }
+
+    return true;
+}
+
+void AFCMigrateModule::OnWorldSocketEvent(const AFNetEvent* event)
+{
+    if (event->GetType() != AFNetEventType::CONNECTED)
+    {
+        return;
+    }
+
+    AFMsg::msg_ss_migrate_register reg;
+    reg.set_bus_id(m_pBusModule->GetSelfBusID());
+    m_pMsgModule->SendMsgByBusID(event->GetBusId(), AFMsg::E_SS_MSG_ID_MIGRATE_REGISTER, reg);
+}
+
+bool AFCMigrateModule::MigrateEntity(const AFGUID& self, const int target_bus)
+{
+    ARK_ASSERT_RET_VAL(target_bus != m_pBusModule->GetSelfBusID(), false);
+
+    auto pEntity = m_pKernelModule->GetEntity(self);
+    if (pEntity == nullptr)
+    {
+        ARK_LOG_ERROR("migrate entity not exist, entity = {}", self);
+        return false;
+    }
+
+    if (IsMigrating(self))
+    {
+        ARK_LOG_ERROR("entity is already migrating, entity = {}", self);
+        return false;
+    }
+
+    // client messages are dropped from now on
+    MigrateData data;
+    data.target_bus_ = target_bus;
+    data.start_time_ = GetPluginManager()->GetNowTime();
+    migrating_list_.insert(std::make_pair(self, data));
+
+    AFDataListView args;
+    m_pKernelModule->DoEvent(self, pEntity->GetClassName(), ArkEntityEvent::ENTITY_EVT_MIGRATE_OUT, args);
+
+    // modules have saved what they need, nothing may change after serializing
+    pEntity->SetFrozen(true);
+    m_pTimerModule->PauseTimer(self);
+
+    AFMsg::msg_ss_migrate_entity msg;
+    msg.set_src_bus(m_pBusModule->GetSelfBusID());
+    msg.set_dst_bus(target_bus);
+    if (!m_pKernelModule->EntityToDBData(self, *msg.mutable_entity()))
+    {
+        ARK_LOG_ERROR("serialize migrate entity failed, entity = {}", self);
+        OnMigrateFail(self);
+        return false;
+    }
+
+    if (!m_pMsgModule->SendMsgByRelay(
+            ARK_APP_TYPE::ARK_APP_WORLD, target_bus, AFMsg::E_SS_MSG_ID_MIGRATE_ENTITY, msg))
+    {
+        ARK_LOG_ERROR("send migrate entity failed, entity = {} target_bus = {}", self, target_bus);
+        OnMigrateFail(self);
+        return false;
+    }
+
+    ARK_LOG_INFO("migrate entity start, entity = {} target_bus = {}", self, target_bus);
+    return true;
+}
+
+bool AFCMigrateModule::IsMigrating(const AFGUID& self)
+{
+    return (migrating_list_.find(self) != migrating_list_.end());
+}
+
+void AFCMigrateModule::OnMigrateEntity(const AFNetMsg* msg)
+{
+    ARK_PROCESS_MSG(msg, AFMsg::msg_ss_migrate_entity);
+
+    auto& pb_entity = pb_msg.entity();
+    AFGUID entity_id = pb_entity.id();
+
+    AFMsg::msg_ss_migrate_entity_ack ack;
+    ack.set_entity_id(entity_id);
+    ack.set_dst_bus(m_pBusModule->GetSelfBusID());
+    ack.set_src_bus(pb_msg.src_bus());
+
+    auto pEntity = m_pKernelModule->CreateEntity(pb_entity);
+    if (pEntity == nullptr)
+    {
+        ARK_LOG_ERROR("create migrate entity failed, entity = {} src_bus = {}", entity_id, pb_msg.src_bus());
+        ack.set_success(false);
+    }
+    else
+    {
+        AFDataListView args;
+        m_pKernelModule->DoEvent(entity_id, pEntity->GetClassName(), ArkEntityEvent::ENTITY_EVT_MIGRATE_IN, args);
+        ack.set_success(true);
+
+        ARK_LOG_INFO("migrate entity in, entity = {} src_bus = {}", entity_id, pb_msg.src_bus());
+    }
+
+    m_pMsgModule->SendMsgByRelay(
+        ARK_APP_TYPE::ARK_APP_WORLD, pb_msg.src_bus(), AFMsg::E_SS_MSG_ID_MIGRATE_ENTITY_ACK, ack);
+}
+
+void AFCMigrateModule::OnMigrateDestroy(const AFNetMsg* msg)
+{
+    ARK_PROCESS_MSG(msg, AFMsg::msg_ss_migrate_destroy);
+
+    AFGUID entity_id = pb_msg.entity_id();
+    if (m_pKernelModule->GetEntity(entity_id) == nullptr)
+    {
+        return;
+    }
+
+    // source timed out and kept its own copy
+    m_pKernelModule->DestroyEntity(entity_id);
+    ARK_LOG_INFO("migrate entity dropped, entity = {} src_bus = {}", entity_id, pb_msg.src_bus());
+}
+
+void AFCMigrateModule::OnMigrateEntityAck(const AFNetMsg* msg)
+{
+    ARK_PROCESS_MSG(msg, AFMsg::msg_ss_migrate_entity_ack);
+
+    AFGUID entity_id = pb_msg.entity_id();
+    auto iter = migrating_list_.find(entity_id);
+    if (iter == migrating_list_.end())
+    {
+        // timeout already, the destroy sent on timeout follows the entity through the same world
+        ARK_LOG_ERROR("migrate ack of unknown entity, entity = {} dst_bus = {}", entity_id, pb_msg.dst_bus());
+        return;
+    }
+
+    if (!pb_msg.success())
+    {
+        ARK_LOG_ERROR("migrate entity refused, entity = {} dst_bus = {}", entity_id, pb_msg.dst_bus());
+        OnMigrateFail(entity_id);
+        return;
+    }
+
+    migrating_list_.erase(iter);
+
+    // client traffic goes to the new game from now on
+    AFMsg::msg_ss_migrate_route route;
+    route.set_entity_id(entity_id);
+    route.set_game_bus(pb_msg.dst_bus());
+    m_pMsgModule->SendMsgByRelay(ARK_APP_TYPE::ARK_APP_WORLD, 0, AFMsg::E_SS_MSG_ID_MIGRATE_ROUTE, route);
+
+    m_pKernelModule->DestroyEntity(entity_id);
+
+    // only drops the pause mark, the entity is gone
+    m_pTimerModule->ResumeTimer(entity_id);
+
+    ARK_LOG_INFO("migrate entity finished, entity = {} dst_bus = {}", entity_id, pb_msg.dst_bus());
+}
+
+void AFCMigrateModule::OnMigrateFail(const AFGUID& self)
+{
+    migrating_list_.erase(self);
+    m_pTimerModule->ResumeTimer(self);
+
+    auto pEntity = m_pKernelModule->GetEntity(self);
+    if (pEntity == nullptr)
+    {
+        return;
+    }
+
+    pEntity->SetFrozen(false);
+
+    AFDataListView args;
+    m_pKernelModule->DoEvent(self, pEntity->GetClassName(), ArkEntityEvent::ENTITY_EVT_MIGRATE_FAIL, args);
+}
+
+} // namespace ark
@@ -0,0 +1,488 @@
+/*
+ * This source file is part of ARK
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"),
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include "game/include/AFCMoveModule.hpp"
+
+namespace ark {
+
+bool AFCMoveModule::Init()
+{
+    m_pKernelModule = FindModule<AFIKernelModule>();
+    m_pMapModule = FindModule<AFIMapModule>();
+    m_pLogModule = FindModule<AFILogModule>();
+    m_pGameNetModule = FindModule<AFIGameNetModule>();
+
+    m_pKernelModule->AddCommonClassEvent(this, &AFCMoveModule::OnClassEvent);
+    m_pKernelModule->AddLeaveSceneEvent(AFEntityMetaPlayer::self_name(), this, &AFCMoveModule::OnLeaveScene);
+
+    return true;
+}
+
+bool AFCMoveModule::Update()
+{
+    // game server is started asynchronously
+    if (!reg_msg_callback_)
+    {
+        reg_msg_callback_ = RegMsgCallback();
+    }
+
+    TakeMoveRequest();
+
+    auto now = GetPluginManager()->GetNowTime();
+
+    if (!input_ids_.empty())
+    {
+        GatherInput(now);
+        ValidateInput();
+        ApplyInput(now);
+    }
+
+    if (!move_states_.empty())
+    {
+        SyncMove(now);
+    }
+
+    return true;
+}
+
+bool AFCMoveModule::AddMoveInput(const AFGUID& self, const AFVector3D& pos, const float orient)
+{
+    auto iter = input_index_.find(self);
+    if (iter != input_index_.end())
+    {
+        auto index = iter->second;
+        input_x_[index] = pos.x;
+        input_y_[index] = pos.y;
+        input_z_[index] = pos.z;
+        input_orient_[index] = orient;
+        return true;
+    }
+
+    input_index_.insert(std::make_pair(self, input_ids_.size()));
+    input_ids_.push_back(self);
+    input_x_.push_back(pos.x);
+    input_y_.push_back(pos.y);
+    input_z_.push_back(pos.z);
+    input_orient_.push_back(orient);
+
+    return true;
+}
+
+bool AFCMoveModule::RegMsgCallback()
+{
+    auto pNetServer = m_pGameNetModule->GetNetServerService();
+    if (pNetServer == nullptr)
+    {
+        return false;
+    }
+
+    pNetServer->RegMsgCallback(AFMsg::EGMI_REQ_MOVE, this, &AFCMoveModule::OnReqMove);
+
+    AFNetMsgMeta meta;
+    meta.rate_limit_ = MAX_MOVE_RATE;
+    pNetServer->SetMsgMeta(AFMsg::EGMI_REQ_MOVE, meta);
+
+    return true;
+}
+
+void AFCMoveModule::OnReqMove(const AFNetMsg* msg)
+{
+    ARK_PROCESS_MSG(msg, AFMsg::ReqMove);
+
+    if (actor_id == NULL_GUID)
+    {
+        return;
+    }
+
+    MoveRequest request;
+    request.id_ = actor_id;
+    request.pos_ = AFIMsgModule::PBToVec(pb_msg.pos());
+    request.orient_ = pb_msg.orient();
+
+    std::lock_guard<std::mutex> guard(request_mutex_);
+    move_requests_.push_back(request);
+}
+
+void AFCMoveModule::TakeMoveRequest()
+{
+    {
+        std::lock_guard<std::mutex> guard(request_mutex_);
+        take_requests_.swap(move_requests_);
+    }
+
+    // the last one of an entity wins, as AddMoveInput does
+    for (auto& request : take_requests_)
+    {
+        AddMoveInput(request.id_, request.pos_, request.orient_);
+    }
+
+    take_requests_.clear();
+}
+
+void AFCMoveModule::SetMaxSpeed(const AFGUID& self, const float speed)
+{
+    ARK_ASSERT_RET_NONE(speed > 0.0f);
+
+    GetMoveState(self).max_speed_ = speed;
+}
+
+bool AFCMoveModule::GetSyncPosition(const AFGUID& self, AFVector3D& pos)
+{
+    auto iter = move_states_.find(self);
+    if (iter == move_states_.end() || !iter->second.synced_)
+    {
+        return false;
+    }
+
+    auto& state = iter->second;
+    pos.x = state.sync_x_ / POSITION_SCALE;
+    pos.y = state.sync_y_ / POSITION_SCALE;
+    pos.z = state.sync_z_ / POSITION_SCALE;
+
+    return true;
+}
+
+int AFCMoveModule::OnClassEvent(
+    const AFGUID& self, const std::string& class_name, const ArkEntityEvent class_event, const AFIDataList& args)
+{
+    if (class_event == ArkEntityEvent::ENTITY_EVT_DESTROY)
+    {
+        move_states_.erase(self);
+        RemoveView(self);
+    }
+
+    return 0;
+}
+
+int AFCMoveModule::OnLeaveScene(const AFGUID& self, const int map_id, const int map_inst_id)
+{
+    // observers are told it left, a key frame is needed when it is seen again
+    RemoveView(self);
+    return 0;
+}
+
+void AFCMoveModule::RemoveView(const AFGUID& self)
+{
+    observer_views_.erase(self);
+    for (auto& iter : observer_views_)
+    {
+        iter.second.erase(self);
+    }
+}
+
+AFCMoveModule::MoveState& AFCMoveModule::GetMoveState(const AFGUID& self)
+{
+    return move_states_[self];
+}
+
+void AFCMoveModule::GatherInput(const int64_t now)
+{
+    auto count = input_ids_.size();
+    input_entities_.resize(count);
+    old_x_.resize(count);
+    old_y_.resize(count);
+    old_z_.resize(count);
+    max_distance_sq_.resize(count);
+    valid_.resize(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto pEntity = m_pKernelModule->GetEntity(input_ids_[i]);
+        input_entities_[i] = pEntity;
+        if (pEntity == nullptr)
+        {
+            old_x_[i] = old_y_[i] = old_z_[i] = 0.0f;
+            max_distance_sq_[i] = -1.0f;
+            continue;
+        }
+
+        const auto& pos = pEntity->GetPosition();
+        old_x_[i] = pos.x;
+        old_y_[i] = pos.y;
+        old_z_[i] = pos.z;
+
+        auto& state = GetMoveState(input_ids_[i]);
+        auto interval = (state.move_time_ == 0) ? MAX_MOVE_INTERVAL : (now - state.move_time_);
+        interval = std::min(interval, MAX_MOVE_INTERVAL);
+
+        float max_distance = state.max_speed_ * interval / AFTimespan::SECOND_MS * SPEED_TOLERANCE;
+        max_distance_sq_[i] = max_distance * max_distance;
+    }
+}
+
+void AFCMoveModule::ValidateInput()
+{
+    // no branch and no entity access, leave it to the compiler to vectorize
+    auto count = input_ids_.size();
+    const float* ix = input_x_.data();
+    const float* iy = input_y_.data();
+    const float* iz = input_z_.data();
+    const float* ox = old_x_.data();
+    const float* oy = old_y_.data();
+    const float* oz = old_z_.data();
+    const float* max_sq = max_distance_sq_.data();
+    uint8_t* valid = valid_.data();
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        float dx = ix[i] - ox[i];
+        float dy = iy[i] - oy[i];
+        float dz = iz[i] - oz[i];
+        valid[i] = static_cast<uint8_t>((dx * dx + dy * dy + dz * dz) <= max_sq[i]);
+    }
+}
+
+void AFCMoveModule::ApplyInput(const int64_t now)
+{
+    auto count = input_ids_.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        auto& pEntity = input_entities_[i];
+        if (pEntity == nullptr)
+        {
+            continue;
+        }
+
+        const auto& self = input_ids_[i];
+        if (!valid_[i])
+        {
+            ARK_LOG_ERROR("move too fast, entity = {} from = ({},{},{}) to = ({},{},{})", self, old_x_[i], old_y_[i],
+                old_z_[i], input_x_[i], input_y_[i], input_z_[i]);
+            SendCorrect(self, pEntity);
+            continue;
+        }
+
+        auto& state = GetMoveState(self);
+        if (state.move_time_ != 0 && now > state.move_time_)
+        {
+            float seconds = float(std::min(now - state.move_time_, MAX_MOVE_INTERVAL)) / AFTimespan::SECOND_MS;
+            state.velocity_ = AFVector3D((input_x_[i] - old_x_[i]) / seconds, (input_y_[i] - old_y_[i]) / seconds,
+                (input_z_[i] - old_z_[i]) / seconds);
+        }
+
+        state.move_time_ = now;
+        state.moved_ = true;
+
+        // move events (AOI) fire here, once per entity per frame
+        pEntity->SetPosition(input_x_[i], input_y_[i], input_z_[i], input_orient_[i]);
+    }
+
+    input_index_.clear();
+    input_ids_.clear();
+    input_entities_.clear();
+    input_x_.clear();
+    input_y_.clear();
+    input_z_.clear();
+    input_orient_.clear();
+}
+
+void AFCMoveModule::SyncMove(const int64_t now)
+{
+    std::map<std::pair<int, int>, std::vector<SyncItem>> sync_lists;
+
+    for (auto& iter : move_states_)
+    {
+        auto& state = iter.second;
+
+        // stopped, no input for a while
+        if (!state.moved_ && state.move_time_ + MAX_MOVE_INTERVAL <= now)
+        {
+            state.velocity_ = AFVector3D(0.0f, 0.0f, 0.0f);
+        }
+
+        // idle entity, nothing to predict
+        if (state.synced_ && !state.moved_ && state.velocity_.IsZero() && state.sync_velocity_.IsZero())
+        {
+            continue;
+        }
+
+        state.moved_ = false;
+
+        auto pEntity = m_pKernelModule->GetEntity(iter.first);
+        if (pEntity == nullptr)
+        {
+            continue;
+        }
+
+        const auto& pos = pEntity->GetPosition();
+        auto orient = pEntity->GetOrient();
+
+        bool need_sync = !state.synced_;
+        if (!need_sync)
+        {
+            // predicted by client since last sync
+            float seconds = float(now - state.sync_time_) / AFTimespan::SECOND_MS;
+            AFVector3D predicted(state.sync_x_ / POSITION_SCALE + state.sync_velocity_.x * seconds,
+                state.sync_y_ / POSITION_SCALE + state.sync_velocity_.y * seconds,
+                state.sync_z_ / POSITION_SCALE + state.sync_velocity_.z * seconds);
+
+            need_sync = AFVector3D::Distance(pos, predicted) > SYNC_DISTANCE ||
+                        std::fabs(std::remainder(orient - state.sync_orient_, 2.0f * PI)) > SYNC_ORIENT ||
+                        (state.velocity_.IsZero() != state.sync_velocity_.IsZero());
+        }
+
+        if (!need_sync)
+        {
+            continue;
+        }
+
+        auto x = static_cast<int32_t>(std::lround(pos.x * POSITION_SCALE));
+        auto y = static_cast<int32_t>(std::lround(pos.y * POSITION_SCALE));
+        auto z = static_cast<int32_t>(std::lround(pos.z * POSITION_SCALE));
+        auto vx = static_cast<int32_t>(std::lround(state.velocity_.x * POSITION_SCALE));
+        auto vy = static_cast<int32_t>(std::lround(state.velocity_.y * POSITION_SCALE));
+        auto vz = static_cast<int32_t>(std::lround(state.velocity_.z * POSITION_SCALE));
+
+        auto dx = x - state.sync_x_;
+        auto dy = y - state.sync_y_;
+        auto dz = z - state.sync_z_;
+        bool key_frame = !state.synced_ || state.key_frame_time_ + KEY_FRAME_INTERVAL <= now ||
+                         std::abs(dx) > MAX_DELTA || std::abs(dy) > MAX_DELTA || std::abs(dz) > MAX_DELTA;
+
+        auto& items = sync_lists[std::make_pair(pEntity->GetMapID(), pEntity->GetMapEntityID())];
+        items.emplace_back();
+        auto& item = items.back();
+        item.id_ = iter.first;
+        item.pos_ = pos;
+
+        // observers without the last sync get the key frame
+        AFMsg::AckMoveDeltaList msg;
+        auto pDelta = msg.add_delta_list();
+        pDelta->set_entity_id(iter.first);
+        pDelta->set_key_frame(true);
+        pDelta->set_x(x);
+        pDelta->set_y(y);
+        pDelta->set_z(z);
+        pDelta->set_orient(static_cast<int32_t>(std::lround(orient * ORIENT_SCALE)));
+        msg.SerializeToString(&item.stop_data_);
+
+        pDelta->set_vx(vx);
+        pDelta->set_vy(vy);
+        pDelta->set_vz(vz);
+        msg.SerializeToString(&item.key_data_);
+
+        if (key_frame)
+        {
+            item.delta_data_ = item.key_data_;
+        }
+        else
+        {
+            pDelta->set_key_frame(false);
+            pDelta->set_x(dx);
+            pDelta->set_y(dy);
+            pDelta->set_z(dz);
+            msg.SerializeToString(&item.delta_data_);
+        }
+
+        // keep the same quantized values as client
+        state.synced_ = true;
+        state.sync_time_ = now;
+        state.sync_x_ = x;
+        state.sync_y_ = y;
+        state.sync_z_ = z;
+        state.sync_velocity_ = AFVector3D(vx / POSITION_SCALE, vy / POSITION_SCALE, vz / POSITION_SCALE);
+        state.sync_orient_ = orient;
+        if (key_frame)
+        {
+            state.key_frame_time_ = now;
+        }
+    }
+
+    for (auto& iter : sync_lists)
+    {
+        SendMoveDelta(iter.first.first, iter.first.second, iter.second);
+    }
+}
+
+void AFCMoveModule::SendCorrect(const AFGUID& self, std::shared_ptr<AFIEntity> pEntity)
+{
+    const auto& pos = pEntity->GetPosition();
+
+    AFMsg::AckMoveCorrect msg;
+    msg.set_entity_id(self);
+    msg.mutable_pos()->set_x(pos.x);
+    msg.mutable_pos()->set_y(pos.y);
+    msg.mutable_pos()->set_z(pos.z);
+    msg.set_orient(pEntity->GetOrient());
+
+    m_pGameNetModule->SendMsgPBToGate(AFMsg::EGMI_ACK_MOVE_CORRECT, msg, self);
+}
+
+void AFCMoveModule::SendMoveDelta(const int map_id, const int inst_id, const std::vector<SyncItem>& items)
+{
+    auto pMapInfo = m_pMapModule->GetMapInfo(map_id);
+    if (pMapInfo == nullptr)
+    {
+        return;
+    }
+
+    auto pInstance = pMapInfo->GetInstance(inst_id);
+    if (pInstance == nullptr || pInstance->player_entities_.empty())
+    {
+        return;
+    }
+
+    // items are serialized once, each observer gets a concatenation of those in its view
+    std::string msg_data;
+    for (auto& iter : pInstance->player_entities_)
+    {
+        const auto& observer = iter.first;
+        auto pObserver = m_pKernelModule->GetEntity(observer);
+        if (pObserver == nullptr)
+        {
+            continue;
+        }
+
+        const auto& observer_pos = pObserver->GetPosition();
+        auto& views = observer_views_[observer];
+        msg_data.clear();
+
+        for (const auto& item : items)
+        {
+            bool in_view =
+                (item.id_ == observer || AFVector3D::Distance(observer_pos, item.pos_) <= VIEW_DISTANCE);
+            auto view_iter = views.find(item.id_);
+            if (view_iter == views.end())
+            {
+                if (in_view)
+                {
+                    views.insert(item.id_);
+                    msg_data.append(item.key_data_);
+                }
+            }
+            else if (in_view)
+            {
+                msg_data.append(item.delta_data_);
+            }
+            else
+            {
+                views.erase(view_iter);
+                msg_data.append(item.stop_data_);
+            }
+        }
+
+        if (!msg_data.empty())
+        {
+            m_pGameNetModule->SendMsgPBToGate(AFMsg::EGMI_ACK_MOVE_DELTA, msg_data, observer);
+        }
+    }
+}
+
+} // namespace ark
@@ -20,6 +20,8 @@
 
 #include "game/include/AFGamePlugin.hpp"
 #include "game/include/AFCGameNetModule.hpp"
+#include "game/include/AFCMigrateModule.hpp"
+#include "game/include/AFCMoveModule.hpp"
 
 namespace ark {
 
@@ -28,10 +30,14 @@ ARK_DECLARE_PLUGIN_DLL_FUNCTION(AFGamePlugin)
 void AFGamePlugin::Install()
 {
     ARK_REGISTER_MODULE(AFIGameNetModule, AFCGameNetModule);
+    ARK_REGISTER_MODULE(AFIMigrateModule, AFCMigrateModule);
+    ARK_REGISTER_MODULE(AFIMoveModule, AFCMoveModule);
 }
 
 void AFGamePlugin::Uninstall()
 {
+    ARK_DEREGISTER_MODULE(AFIMoveModule, AFCMoveModule);
+    ARK_DEREGISTER_MODULE(AFIMigrateModule, AFCMigrateModule);
     ARK_DEREGISTER_MODULE(AFIGameNetModule, AFCGameNetModule);
 }
 
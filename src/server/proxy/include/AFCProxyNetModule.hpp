@@ -37,19 +37,32 @@ class AFCProxyNetModule final : public AFIProxyNetModule
 public:
     bool Init() override;
     bool PostInit() override;
+    bool Update() override;
     //bool PreUpdate() override;
 
+    void AddConnectData(const std::string& strAccount, const std::string& strKey, const AFGUID& actor_id) override;
     bool VerifyConnectData(const std::string& strAccount, const std::string& strKey) override;
 
+    int GetActorGameBus(const AFGUID& actor_id) override;
+
 protected:
     int StartServer();
 
     void OnSelectServerResultProcess(const AFNetMsg* msg, const int64_t session_id);
     void OnServerInfoProcess(const AFNetMsg* msg, const int64_t session_id);
 
-    void OnOtherMessage(const AFNetMsg* msg, const int64_t session_id);
+    // bind the session to the actor of the connect data
+    void OnReqEnterGame(const AFNetMsg* msg);
+
+    // messages without handler go to the game which owns the actor of the session
+    void OnOtherMessage(const AFNetMsg* msg);
     void OnBrocastmsg(const AFNetMsg* msg, const int64_t session_id);
 
+    // entity migrated to another game
+    void OnMigrateRoute(const AFNetMsg* msg);
+    void OnWorldSocketEvent(const AFNetEvent* event);
+    bool RegWorldCallback();
+
     void OnSocketEvent(const AFNetEvent* event);
 
     void OnClientDisconnect(const AFGUID& xClientID);
@@ -78,6 +91,7 @@ protected:
 
         std::string strAccount{};
         std::string strConnectKey{};
+        AFGUID xActorID{0};
     };
 
     AFSmartPtrMap<std::string, ClientConnectData> mxWantToConnectMap;
@@ -91,6 +105,12 @@ private:
     AFIMsgModule* m_pMsgModule;
 
     std::shared_ptr<AFINetServerService> m_pNetServer{nullptr};
+
+    // session id <-> actor id, bound when entering game, actor ids from clients are never trusted
+    std::unordered_map<int64_t, AFGUID> session_actors_;
+    std::unordered_map<AFGUID, int64_t> actor_sessions_;
+
+    bool reg_world_callback_{false};
 };
 
 } // namespace ark
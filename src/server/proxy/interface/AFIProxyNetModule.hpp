@@ -21,13 +21,19 @@
 #pragma once
 
 #include "interface/AFIModule.hpp"
+#include "base/AFDefine.hpp"
 
 namespace ark {
 
 class AFIProxyNetModule : public AFIModule
 {
 public:
+    // the account may enter with the key once, its session is bound to the actor chosen at role selection
+    virtual void AddConnectData(const std::string& strAccount, const std::string& strKey, const AFGUID& actor_id) = 0;
     virtual bool VerifyConnectData(const std::string& strAccount, const std::string& strKey) = 0;
+
+    // game bus which owns the actor, 0 if unknown
+    virtual int GetActorGameBus(const AFGUID& actor_id) = 0;
 };
 
 } // namespace ark
@@ -18,6 +18,7 @@
  *
  */
 
+#include "base/AFMisc.hpp"
 #include "proxy/include/AFCProxyNetModule.hpp"
 
 namespace ark {
@@ -39,6 +40,17 @@ bool AFCProxyNetModule::PostInit()
     return true;
 }
 
+bool AFCProxyNetModule::Update()
+{
+    // clients are created asynchronously
+    if (!reg_world_callback_)
+    {
+        reg_world_callback_ = RegWorldCallback();
+    }
+
+    return true;
+}
+
 int AFCProxyNetModule::StartServer()
 {
     auto ret = m_pNetServiceManagerModule->CreateServer();
@@ -57,6 +69,10 @@ int AFCProxyNetModule::StartServer()
             ARK_LOG_ERROR("Cannot find server net, busid = {}", m_pBusModule->GetSelfBusName());
             exit(0);
         }
+
+        m_pNetServer->RegMsgCallback(AFMsg::EGMI_REQ_ENTER_GAME, this, &AFCProxyNetModule::OnReqEnterGame);
+        m_pNetServer->RegForwardMsgCallback(std::bind(&AFCProxyNetModule::OnOtherMessage, this, std::placeholders::_1));
+        m_pNetServer->RegNetEventCallback(this, &AFCProxyNetModule::OnSocketEvent);
     });
 
     return 0;
@@ -66,6 +82,18 @@ void AFCProxyNetModule::OnServerInfoProcess(const AFNetMsg* msg, const int64_t s
 
 void AFCProxyNetModule::OnSelectServerResultProcess(const AFNetMsg* msg, const int64_t session_id) {}
 
+void AFCProxyNetModule::AddConnectData(
+    const std::string& strAccount, const std::string& strKey, const AFGUID& actor_id)
+{
+    auto pConnectData = std::make_shared<ClientConnectData>();
+    pConnectData->strAccount = strAccount;
+    pConnectData->strConnectKey = strKey;
+    pConnectData->xActorID = actor_id;
+
+    mxWantToConnectMap.erase(strAccount);
+    mxWantToConnectMap.insert(strAccount, pConnectData);
+}
+
 bool AFCProxyNetModule::VerifyConnectData(const std::string& strAccount, const std::string& strKey)
 {
     auto pConnectData = mxWantToConnectMap.find_value(strAccount);
@@ -78,6 +106,83 @@ bool AFCProxyNetModule::VerifyConnectData(const std::string& strAccount, const s
     return false;
 }
 
+int AFCProxyNetModule::GetActorGameBus(const AFGUID& actor_id)
+{
+    auto pGameClient = m_pNetServiceManagerModule->GetClientService(ARK_APP_TYPE::ARK_APP_GAME);
+    if (pGameClient == nullptr)
+    {
+        return 0;
+    }
+
+    int game_bus = pGameClient->GetActorBusID(actor_id);
+    if (game_bus > 0)
+    {
+        return game_bus;
+    }
+
+    // not routed yet, the actor stays on the game chosen by its id
+    auto pConnection = pGameClient->GetSuitableConnect(AFMisc::ToString(actor_id));
+    if (pConnection == nullptr)
+    {
+        return 0;
+    }
+
+    return pConnection->server_bus_id_;
+}
+
+bool AFCProxyNetModule::RegWorldCallback()
+{
+    auto pWorldClient = m_pNetServiceManagerModule->GetClientService(ARK_APP_TYPE::ARK_APP_WORLD);
+    if (pWorldClient == nullptr)
+    {
+        return false;
+    }
+
+    // games are not linked to proxies, routes are relayed by world
+    pWorldClient->RegMsgCallback(AFMsg::E_SS_MSG_ID_MIGRATE_ROUTE, this, &AFCProxyNetModule::OnMigrateRoute);
+    pWorldClient->RegNetEventCallback(this, &AFCProxyNetModule::OnWorldSocketEvent);
+
+    // world may be connected before the callback
+    auto busid = m_pBusModule->GetSelfBusID();
+    auto pConnection = pWorldClient->GetSuitableConnect(AFMisc::ToString(busid));
+    if (pConnection != nullptr && pConnection->net_state_ == AFConnectionData::CONNECTED)
+    {
+        AFMsg::msg_ss_migrate_register reg;
+        reg.set_bus_id(busid);
+        m_pMsgModule->SendMsgByBusID(pConnection->server_bus_id_, AFMsg::E_SS_MSG_ID_MIGRATE_REGISTER, reg);
+    }
+
+    return true;
+}
+
+void AFCProxyNetModule::OnWorldSocketEvent(const AFNetEvent* event)
+{
+    if (event->GetType() != AFNetEventType::CONNECTED)
+    {
+        return;
+    }
+
+    AFMsg::msg_ss_migrate_register reg;
+    reg.set_bus_id(m_pBusModule->GetSelfBusID());
+    m_pMsgModule->SendMsgByBusID(event->GetBusId(), AFMsg::E_SS_MSG_ID_MIGRATE_REGISTER, reg);
+}
+
+void AFCProxyNetModule::OnMigrateRoute(const AFNetMsg* msg)
+{
+    ARK_PROCESS_MSG(msg, AFMsg::msg_ss_migrate_route);
+
+    auto pGameClient = m_pNetServiceManagerModule->GetClientService(ARK_APP_TYPE::ARK_APP_GAME);
+    if (pGameClient == nullptr)
+    {
+        return;
+    }
+
+    // insert does not overwrite an old route
+    pGameClient->RemoveActorBusID(pb_msg.entity_id());
+    pGameClient->AddActorBusID(pb_msg.entity_id(), pb_msg.game_bus());
+    ARK_LOG_INFO("actor route changed, actor = {} game_bus = {}", pb_msg.entity_id(), pb_msg.game_bus());
+}
+
 void AFCProxyNetModule::OnSocketEvent(const AFNetEvent* event)
 {
     switch (event->GetType())
@@ -109,7 +214,21 @@ void AFCProxyNetModule::OnClientConnected(const AFGUID& conn_id)
 
 void AFCProxyNetModule::OnClientDisconnect(const AFGUID& conn_id)
 {
-    // do something
+    auto iter = session_actors_.find(conn_id);
+    if (iter == session_actors_.end())
+    {
+        return;
+    }
+
+    actor_sessions_.erase(iter->second);
+
+    auto pGameClient = m_pNetServiceManagerModule->GetClientService(ARK_APP_TYPE::ARK_APP_GAME);
+    if (pGameClient != nullptr)
+    {
+        pGameClient->RemoveActorBusID(iter->second);
+    }
+
+    session_actors_.erase(iter);
 }
 
 bool AFCProxyNetModule::CheckSessionState(const int nGameID, const AFGUID& xClientID, const std::string& strAccount)
@@ -130,9 +249,77 @@ bool AFCProxyNetModule::CheckSessionState(const int nGameID, const AFGUID& xClie
     return false;
 }
 
-void AFCProxyNetModule::OnOtherMessage(const AFNetMsg* msg, const int64_t session_id)
+void AFCProxyNetModule::OnReqEnterGame(const AFNetMsg* msg)
 {
-    // Transpond(xHead, nMsgID  msg, nLen);
+    ARK_PROCESS_MSG(msg, AFMsg::ReqEnterGame);
+
+    auto session_id = msg->GetSessionId();
+    auto pConnectData = mxWantToConnectMap.find_value(pb_msg.account());
+    if (pConnectData == nullptr || pConnectData->xActorID == 0 || !VerifyConnectData(pb_msg.account(), pb_msg.key()))
+    {
+        ARK_LOG_ERROR("enter game refused, account = {} session_id = {}", pb_msg.account(), session_id);
+        m_pNetServer->GetNet()->CloseSession(session_id);
+        return;
+    }
+
+    AFGUID bind_actor = pConnectData->xActorID;
+
+    // one session per actor, the former one is kicked
+    auto actor_iter = actor_sessions_.find(bind_actor);
+    if (actor_iter != actor_sessions_.end() && actor_iter->second != session_id)
+    {
+        auto old_session = actor_iter->second;
+        session_actors_.erase(old_session);
+        actor_sessions_.erase(actor_iter);
+        m_pNetServer->GetNet()->CloseSession(old_session);
+    }
+
+    auto session_iter = session_actors_.find(session_id);
+    if (session_iter != session_actors_.end() && session_iter->second != bind_actor)
+    {
+        actor_sessions_.erase(session_iter->second);
+    }
+
+    session_actors_[session_id] = bind_actor;
+    actor_sessions_[bind_actor] = session_id;
+    ARK_LOG_INFO("enter game, account = {} actor = {} session_id = {}", pb_msg.account(), bind_actor, session_id);
+}
+
+void AFCProxyNetModule::OnOtherMessage(const AFNetMsg* msg)
+{
+    auto session_iter = session_actors_.find(msg->GetSessionId());
+    if (session_iter == session_actors_.end())
+    {
+        ARK_LOG_ERROR("message before entering game, id = {} session_id = {}", msg->GetMsgId(), msg->GetSessionId());
+        return;
+    }
+
+    // the head is written by the client, only the bound actor is trusted
+    AFGUID actor_id = session_iter->second;
+    if (msg->GetActorId() != 0 && msg->GetActorId() != actor_id)
+    {
+        ARK_LOG_ERROR("message of another actor, id = {} session_id = {} actor_id = {} claimed = {}", msg->GetMsgId(),
+            msg->GetSessionId(), actor_id, msg->GetActorId());
+        return;
+    }
+
+    int game_bus = GetActorGameBus(actor_id);
+    auto src_bus = m_pBusModule->GetSelfBusID();
+    auto pNet = m_pNetServiceManagerModule->GetNetConnectionBus(src_bus, game_bus);
+    if (pNet == nullptr)
+    {
+        ARK_LOG_ERROR("game of actor not connected, id = {} actor_id = {} game_bus = {}", msg->GetMsgId(), actor_id,
+            game_bus);
+        return;
+    }
+
+    AFSSMsgHead head;
+    head.id_ = msg->GetMsgId();
+    head.length_ = msg->GetMsgLength();
+    head.actor_id_ = actor_id;
+    head.src_bus_ = src_bus;
+    head.dst_bus_ = game_bus;
+    pNet->SendMsg(&head, msg->GetMsgData(), 0);
 }
 
 void AFCProxyNetModule::OnBrocastmsg(const AFNetMsg* msg, const int64_t session_id)
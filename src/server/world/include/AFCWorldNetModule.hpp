@@ -58,6 +58,14 @@ protected:
 
     int GetPlayerGameID(const AFGUID& self);
 
+    // games and proxies are not linked to each other, world relays migration by the dst bus of the head
+    void OnMigrateRegister(const AFNetMsg* msg);
+    void OnMigrateRelay(const AFNetMsg* msg);
+    void OnMigrateRoute(const AFNetMsg* msg);
+    void OnSocketEvent(const AFNetEvent* event);
+
+    bool RelayMsg(const AFNetMsg* msg, const int64_t session_id);
+
 private:
     // AFSmartPtrMap<int, AFServerData> reg_servers_;
 
@@ -74,6 +82,9 @@ private:
     AFINetServiceManagerModule* m_pNetServiceManagerModule;
 
     std::shared_ptr<AFINetServerService> m_pNetServer;
+
+    // bus id -> session id, games and proxies register after connected
+    std::unordered_map<int, int64_t> relay_sessions_;
 };
 
 } // namespace ark
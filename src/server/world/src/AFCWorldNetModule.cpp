@@ -64,6 +64,13 @@ int AFCWorldNetModule::StartServer()
             ARK_LOG_ERROR("Cannot find server net, busid = {}", m_pBusModule->GetSelfBusName());
             exit(0);
         }
+
+        m_pNetServer->RegMsgCallback(AFMsg::E_SS_MSG_ID_MIGRATE_REGISTER, this, &AFCWorldNetModule::OnMigrateRegister);
+        m_pNetServer->RegMsgCallback(AFMsg::E_SS_MSG_ID_MIGRATE_ENTITY, this, &AFCWorldNetModule::OnMigrateRelay);
+        m_pNetServer->RegMsgCallback(AFMsg::E_SS_MSG_ID_MIGRATE_ENTITY_ACK, this, &AFCWorldNetModule::OnMigrateRelay);
+        m_pNetServer->RegMsgCallback(AFMsg::E_SS_MSG_ID_MIGRATE_DESTROY, this, &AFCWorldNetModule::OnMigrateRelay);
+        m_pNetServer->RegMsgCallback(AFMsg::E_SS_MSG_ID_MIGRATE_ROUTE, this, &AFCWorldNetModule::OnMigrateRoute);
+        m_pNetServer->RegNetEventCallback(this, &AFCWorldNetModule::OnSocketEvent);
     });
 
     return 0;
@@ -233,4 +240,70 @@ int AFCWorldNetModule::GetPlayerGameID(const AFGUID& self)
     return -1;
 }
 
+void AFCWorldNetModule::OnMigrateRegister(const AFNetMsg* msg)
+{
+    ARK_PROCESS_MSG(msg, AFMsg::msg_ss_migrate_register);
+
+    relay_sessions_[pb_msg.bus_id()] = msg->GetSessionId();
+    ARK_LOG_INFO("relay registered, bus = {} session_id = {}", AFBusAddr(pb_msg.bus_id()).ToString(),
+        msg->GetSessionId());
+}
+
+void AFCWorldNetModule::OnMigrateRelay(const AFNetMsg* msg)
+{
+    auto iter = relay_sessions_.find(msg->GetDstBus());
+    if (iter == relay_sessions_.end())
+    {
+        ARK_LOG_ERROR("relay target not registered, msg_id = {} src_bus = {} dst_bus = {}", msg->GetMsgId(),
+            msg->GetSrcBus(), msg->GetDstBus());
+        return;
+    }
+
+    RelayMsg(msg, iter->second);
+}
+
+void AFCWorldNetModule::OnMigrateRoute(const AFNetMsg* msg)
+{
+    // every proxy may hold a client of the entity
+    for (auto& iter : relay_sessions_)
+    {
+        if (static_cast<ARK_APP_TYPE>(AFBusAddr(iter.first).app_type) == ARK_APP_TYPE::ARK_APP_PROXY)
+        {
+            RelayMsg(msg, iter.second);
+        }
+    }
+}
+
+void AFCWorldNetModule::OnSocketEvent(const AFNetEvent* event)
+{
+    if (event->GetType() != AFNetEventType::DISCONNECTED)
+    {
+        return;
+    }
+
+    for (auto iter = relay_sessions_.begin(); iter != relay_sessions_.end();)
+    {
+        if (iter->second == event->GetId())
+        {
+            iter = relay_sessions_.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+}
+
+bool AFCWorldNetModule::RelayMsg(const AFNetMsg* msg, const int64_t session_id)
+{
+    AFSSMsgHead head;
+    head.id_ = msg->GetMsgId();
+    head.length_ = msg->GetMsgLength();
+    head.actor_id_ = msg->GetActorId();
+    head.src_bus_ = msg->GetSrcBus();
+    head.dst_bus_ = msg->GetDstBus();
+
+    return m_pNetServer->GetNet()->SendMsg(&head, msg->GetMsgData(), session_id);
+}
+
 } // namespace ark
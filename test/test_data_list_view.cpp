@@ -0,0 +1,83 @@
+/*
+ * This source file is part of ArkNX
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "kernel/include/AFDataListView.hpp"
+#include "kernel/include/AFCDataList.hpp"
+
+using namespace ark;
+
+TEST_CASE("data list view borrows strings and user data", "[data_list_view]")
+{
+    std::string name = "player";
+    const char buffer[4] = {1, 2, 3, 4};
+
+    AFDataListView view;
+    view << 1 << int64_t(2) << 0.5f << name;
+    view.AddUserData(buffer, sizeof(buffer));
+
+    REQUIRE(view.GetCount() == 5);
+    REQUIRE(view.Int(0) == 1);
+    REQUIRE(view.Int64(1) == 2);
+    REQUIRE(view.Float(2) == 0.5f);
+
+    // borrowed, not copied
+    REQUIRE(view.String(3) == name.c_str());
+
+    size_t size = 0;
+    REQUIRE(view.UserData(4, size) == buffer);
+    REQUIRE(size == sizeof(buffer));
+
+    // a wrong type gets the null value
+    REQUIRE(view.Int(3) == NULL_INT);
+    REQUIRE(view.GetType(5) == ArkDataType::DT_EMPTY);
+}
+
+TEST_CASE("data list view is reused after clear", "[data_list_view]")
+{
+    AFBaseDataListView<2> view;
+    REQUIRE(view.AddInt(1));
+    REQUIRE(view.AddInt(2));
+    REQUIRE(view.GetCount() == 2);
+
+    view.Clear();
+    REQUIRE(view.Empty());
+    REQUIRE(view.AddBool(true));
+    REQUIRE(view.Bool(0));
+}
+
+TEST_CASE("data list view borrows a range of another list", "[data_list_view]")
+{
+    AFCDataList list;
+    list << 1 << "name" << 3;
+
+    AFDataListView view(list, 1, 2);
+    REQUIRE(view.GetCount() == 2);
+    REQUIRE(view.String(0) == list.String(1));
+    REQUIRE(view.Int(1) == 3);
+
+    // copied into an owning list, the data is kept
+    AFCDataList copy;
+    copy.Concat(view);
+    REQUIRE(copy.GetCount() == 2);
+    REQUIRE(std::string(copy.String(0)) == "name");
+    REQUIRE(copy.String(0) != list.String(1));
+}
@@ -0,0 +1,183 @@
+/*
+ * This source file is part of ArkNX
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "kernel/include/AFCEventManager.hpp"
+
+using namespace ark;
+
+static const int TEST_EVENT = 1;
+
+struct TestTypedEvent
+{
+    static const int EVENT_ID = 2;
+    int value_{0};
+};
+
+TEST_CASE("event callback added in dispatch is pending", "[event_manager]")
+{
+    AFCEventManager manager;
+    const AFGUID self(1);
+
+    int first_count = 0;
+    int added_count = 0;
+    manager.AddEventCallBack(self, TEST_EVENT, [&](const AFGUID&, const int, const AFIDataList&) {
+        if (++first_count == 1)
+        {
+            manager.AddEventCallBack(self, TEST_EVENT, [&](const AFGUID&, const int, const AFIDataList&) {
+                ++added_count;
+                return 0;
+            });
+        }
+
+        return 0;
+    });
+
+    REQUIRE(manager.DoEvent(self, TEST_EVENT, AFCDataList()));
+    REQUIRE(first_count == 1);
+    REQUIRE(added_count == 0);
+
+    // the pending callback joins once the outermost dispatch returned
+    manager.DoEvent(self, TEST_EVENT, AFCDataList());
+    REQUIRE(first_count == 2);
+    REQUIRE(added_count == 1);
+}
+
+TEST_CASE("event callback added in nested dispatch waits for the outermost", "[event_manager]")
+{
+    AFCEventManager manager;
+    const AFGUID self(1);
+    const int inner_event = 3;
+
+    int added_count = 0;
+    manager.AddEventCallBack(self, inner_event, [&](const AFGUID&, const int, const AFIDataList&) {
+        manager.AddEventCallBack(self, TEST_EVENT, [&](const AFGUID&, const int, const AFIDataList&) {
+            ++added_count;
+            return 0;
+        });
+        return 0;
+    });
+
+    manager.AddEventCallBack(self, TEST_EVENT, [&](const AFGUID& id, const int, const AFIDataList&) {
+        manager.DoEvent(id, inner_event, AFCDataList());
+        return 0;
+    });
+
+    manager.DoEvent(self, TEST_EVENT, AFCDataList());
+    REQUIRE(added_count == 0);
+
+    manager.DoEvent(self, TEST_EVENT, AFCDataList());
+    REQUIRE(added_count == 1);
+}
+
+TEST_CASE("event callback removed in dispatch is skipped until compaction", "[event_manager]")
+{
+    AFCEventManager manager;
+    const AFGUID self(1);
+
+    int first_count = 0;
+    int second_count = 0;
+    manager.AddEventCallBack(self, TEST_EVENT, [&](const AFGUID& id, const int event_id, const AFIDataList&) {
+        ++first_count;
+        manager.RemoveEventCallBack(id, event_id);
+        return 0;
+    });
+
+    manager.AddEventCallBack(self, TEST_EVENT, [&](const AFGUID&, const int, const AFIDataList&) {
+        ++second_count;
+        return 0;
+    });
+
+    // the second one is removed by the first one in the same dispatch
+    manager.DoEvent(self, TEST_EVENT, AFCDataList());
+    REQUIRE(first_count == 1);
+    REQUIRE(second_count == 0);
+
+    // still kept before Update, but never called
+    REQUIRE_FALSE(manager.DoEvent(self, TEST_EVENT, AFCDataList()));
+    REQUIRE(first_count == 1);
+
+    // a callback added again before compaction survives it
+    manager.AddEventCallBack(self, TEST_EVENT, [&](const AFGUID&, const int, const AFIDataList&) {
+        ++second_count;
+        return 0;
+    });
+
+    manager.Update();
+    REQUIRE(manager.DoEvent(self, TEST_EVENT, AFCDataList()));
+    REQUIRE(first_count == 1);
+    REQUIRE(second_count == 1);
+
+    // compaction drops the entity once all its callbacks are removed
+    manager.Clear(self);
+    manager.Update();
+    REQUIRE_FALSE(manager.DoEvent(self, TEST_EVENT, AFCDataList()));
+}
+
+TEST_CASE("posted event is delivered at frame end", "[event_manager]")
+{
+    AFCEventManager manager;
+    const AFGUID self(1);
+
+    std::vector<int> values;
+    manager.AddEventCallBack(self, TEST_EVENT, [&](const AFGUID& id, const int event_id, const AFIDataList& args) {
+        values.push_back(args.Int(0));
+
+        // posted while delivering, goes to the next frame
+        if (args.Int(0) == 1)
+        {
+            manager.PostEvent(id, event_id, AFCDataList() << 3);
+        }
+
+        return 0;
+    });
+
+    manager.PostEvent(self, TEST_EVENT, AFCDataList() << 1);
+    manager.PostEvent(self, TEST_EVENT, AFCDataList() << 2);
+    REQUIRE(values.empty());
+
+    manager.Update();
+    REQUIRE(values == std::vector<int>{1, 2});
+
+    manager.Update();
+    REQUIRE(values == std::vector<int>{1, 2, 3});
+}
+
+TEST_CASE("posted typed event is delivered at frame end", "[event_manager]")
+{
+    AFCEventManager manager;
+    const AFGUID self(1);
+
+    int value = 0;
+    std::function<int(const AFGUID&, const TestTypedEvent&)> cb = [&](const AFGUID&, const TestTypedEvent& event) {
+        value = event.value_;
+        return 0;
+    };
+    manager.AddEventCallBack<TestTypedEvent>(self, std::move(cb));
+
+    TestTypedEvent event;
+    event.value_ = 7;
+    manager.PostEvent(self, event);
+    REQUIRE(value == 0);
+
+    manager.Update();
+    REQUIRE(value == 7);
+}
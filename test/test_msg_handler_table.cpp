@@ -0,0 +1,133 @@
+/*
+ * This source file is part of ArkNX
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "net/include/AFNetMsgHandlerTable.hpp"
+
+using namespace ark;
+
+static AFNetMsg* MakeMsg(const uint16_t msg_id, const uint32_t len, const int64_t actor_id, const int64_t session_id)
+{
+    AFNetMsg* msg = AFNetMsg::AllocMsg(len);
+    msg->SetMsgLength(len);
+    msg->SetMsgId(msg_id);
+    msg->SetActorId(actor_id);
+    msg->SetSessionId(session_id);
+    return msg;
+}
+
+static AFNetMsgHandlerTable::Result Handle(
+    AFNetMsgHandlerTable& table, const uint16_t msg_id, const uint32_t len, const int64_t actor_id = 0)
+{
+    AFNetMsg* msg = MakeMsg(msg_id, len, actor_id, 1);
+    auto result = table.Handle(msg);
+    AFNetMsg::Release(msg);
+    return result;
+}
+
+TEST_CASE("msg handler table registers once per id", "[msg_handler_table]")
+{
+    AFNetMsgHandlerTable table;
+    int count = 0;
+
+    REQUIRE(table.Register(0x1234, [&](const AFNetMsg*) { ++count; }));
+    REQUIRE_FALSE(table.Register(0x1234, [&](const AFNetMsg*) {}));
+
+    REQUIRE(Handle(table, 0x1234, 4) == AFNetMsgHandlerTable::Result::HANDLED);
+    REQUIRE(count == 1);
+
+    // same page and another page without handler
+    REQUIRE(Handle(table, 0x1235, 4) == AFNetMsgHandlerTable::Result::UNKNOWN);
+    REQUIRE(Handle(table, 0x4321, 4) == AFNetMsgHandlerTable::Result::UNKNOWN);
+    REQUIRE(table.GetUnknownCount() == 2);
+
+    std::vector<AFNetMsgStats> stats;
+    table.GetStats(stats);
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].msg_id_ == 0x1234);
+    REQUIRE(stats[0].count_ == 1);
+    REQUIRE(stats[0].bytes_ == 4);
+}
+
+TEST_CASE("msg handler table rejects length out of meta", "[msg_handler_table]")
+{
+    AFNetMsgHandlerTable table;
+    int count = 0;
+    table.Register(1, [&](const AFNetMsg*) { ++count; });
+
+    AFNetMsgMeta meta;
+    meta.min_length_ = 2;
+    meta.max_length_ = 8;
+    REQUIRE(table.SetMeta(1, meta));
+    REQUIRE_FALSE(table.SetMeta(2, meta));
+
+    REQUIRE(Handle(table, 1, 1) == AFNetMsgHandlerTable::Result::REJECTED);
+    REQUIRE(Handle(table, 1, 9) == AFNetMsgHandlerTable::Result::REJECTED);
+    REQUIRE(Handle(table, 1, 8) == AFNetMsgHandlerTable::Result::HANDLED);
+    REQUIRE(count == 1);
+
+    std::vector<AFNetMsgStats> stats;
+    table.GetStats(stats);
+    REQUIRE(stats[0].reject_count_ == 2);
+}
+
+TEST_CASE("msg handler table limits rate per sender", "[msg_handler_table]")
+{
+    AFNetMsgHandlerTable table;
+    table.Register(1, [](const AFNetMsg*) {});
+
+    AFNetMsgMeta meta;
+    meta.rate_limit_ = 2;
+    table.SetMeta(1, meta);
+
+    // the whole run stays in one second unless it crosses a boundary, retry then
+    for (int retry = 0; retry < 3; ++retry)
+    {
+        auto begin = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+
+        std::vector<AFNetMsgHandlerTable::Result> results;
+        const int64_t actor_id = 100 + retry;
+        for (uint32_t i = 0; i < meta.rate_limit_ * AFNetMsgHandlerTable::FLOOD_FACTOR + 1; ++i)
+        {
+            results.push_back(Handle(table, 1, 0, actor_id));
+        }
+
+        // another sender is not limited by the flooding one
+        auto other = Handle(table, 1, 0, actor_id + 1000);
+
+        auto end = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+        if (begin != end)
+        {
+            continue;
+        }
+
+        REQUIRE(results[0] == AFNetMsgHandlerTable::Result::HANDLED);
+        REQUIRE(results[1] == AFNetMsgHandlerTable::Result::HANDLED);
+        REQUIRE(results[2] == AFNetMsgHandlerTable::Result::REJECTED);
+        REQUIRE(results.back() == AFNetMsgHandlerTable::Result::FLOODED);
+        REQUIRE(other == AFNetMsgHandlerTable::Result::HANDLED);
+        return;
+    }
+
+    FAIL("every run crossed a second boundary");
+}
@@ -0,0 +1,145 @@
+/*
+ * This source file is part of ArkNX
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "net/include/AFNetSession.hpp"
+
+using namespace ark;
+
+using TestSession = AFNetSession<int>;
+
+static std::string MakeSSMsg(const uint16_t msg_id, const int64_t actor_id, const std::string& body)
+{
+    AFSSMsgHead head;
+    head.id_ = msg_id;
+    head.length_ = static_cast<uint32_t>(body.length());
+    head.actor_id_ = actor_id;
+
+    std::string data(reinterpret_cast<const char*>(&head), static_cast<size_t>(AFHeadLength::SS_HEAD_LENGTH));
+    data.append(body);
+    return data;
+}
+
+static void PopAll(TestSession& session, std::vector<AFNetMsg*>& msgs)
+{
+    AFNetMsg* msg = nullptr;
+    while (session.PopNetMsg(msg))
+    {
+        msgs.push_back(msg);
+    }
+}
+
+TEST_CASE("recv block switch", "[recv_block]")
+{
+    TestSession session(AFHeadLength::SS_HEAD_LENGTH, 1, 0);
+
+    // fill the block up to a message cut in the middle
+    std::vector<std::string> bodies;
+    std::string stream;
+    for (int i = 0; stream.length() < AFNetRecvBlock::BLOCK_SIZE; ++i)
+    {
+        bodies.emplace_back(std::string(ARK_MSG_MAX_LENGTH, static_cast<char>('a' + i)));
+        stream.append(MakeSSMsg(1, i, bodies.back()));
+    }
+
+    REQUIRE(stream.length() % AFNetRecvBlock::BLOCK_SIZE != 0);
+
+    // the whole stream at once, the block runs full and the partial message is carried to a new block
+    session.AddBuffer(stream.data(), stream.length());
+    session.ParseBufferToMsg();
+
+    std::vector<AFNetMsg*> msgs;
+    PopAll(session, msgs);
+    REQUIRE(msgs.size() == bodies.size());
+    REQUIRE(session.GetBufferLen() == 0);
+
+    // messages sliced from the released block are still valid
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        REQUIRE(msgs[i]->GetActorId() == static_cast<int64_t>(i));
+        REQUIRE(msgs[i]->GetMsgLength() == bodies[i].length());
+        REQUIRE(memcmp(msgs[i]->GetMsgData(), bodies[i].data(), bodies[i].length()) == 0);
+        AFNetMsg::Release(msgs[i]);
+    }
+}
+
+TEST_CASE("recv block partial", "[recv_block]")
+{
+    TestSession session(AFHeadLength::SS_HEAD_LENGTH, 1, 0);
+
+    std::mt19937 rng(1);
+    std::vector<std::string> bodies;
+    std::string stream;
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string body(rng() % ARK_MSG_MAX_LENGTH, 0);
+        for (auto& c : body)
+        {
+            c = static_cast<char>(rng());
+        }
+
+        stream.append(MakeSSMsg(static_cast<uint16_t>(i), i, body));
+        bodies.emplace_back(std::move(body));
+    }
+
+    // random pieces cut heads and bodies at any position
+    std::vector<AFNetMsg*> msgs;
+    size_t pos = 0;
+    while (pos < stream.length())
+    {
+        size_t len = std::min<size_t>(rng() % 40000 + 1, stream.length() - pos);
+        session.AddBuffer(stream.data() + pos, len);
+        session.ParseBufferToMsg();
+        PopAll(session, msgs);
+        pos += len;
+    }
+
+    REQUIRE(msgs.size() == bodies.size());
+    REQUIRE(session.GetBufferLen() == 0);
+
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        REQUIRE(msgs[i]->GetMsgId() == static_cast<uint16_t>(i));
+        REQUIRE(msgs[i]->GetMsgLength() == bodies[i].length());
+        REQUIRE(memcmp(msgs[i]->GetMsgData(), bodies[i].data(), bodies[i].length()) == 0);
+        AFNetMsg::Release(msgs[i]);
+    }
+}
+
+TEST_CASE("recv block broken head", "[recv_block]")
+{
+    TestSession session(AFHeadLength::SS_HEAD_LENGTH, 1, 0);
+
+    AFSSMsgHead head;
+    head.length_ = ARK_MSG_MAX_LENGTH + 1;
+    std::string data(reinterpret_cast<const char*>(&head), static_cast<size_t>(AFHeadLength::SS_HEAD_LENGTH));
+    data.append(100, 'a');
+
+    session.AddBuffer(data.data(), data.length());
+    REQUIRE(session.ParseBufferToMsg() == 0);
+    REQUIRE(session.IsBroken());
+    REQUIRE(session.GetBufferLen() == 0);
+
+    // nothing is taken any more
+    session.AddBuffer(data.data(), data.length());
+    REQUIRE(session.GetBufferLen() == 0);
+}
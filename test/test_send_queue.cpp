@@ -0,0 +1,127 @@
+/*
+ * This source file is part of ArkNX
+ * For the latest info, see https://github.com/ArkNX
+ *
+ * Copyright (c) 2013-2019 ArkNX authors.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "net/include/AFNetSendQueue.hpp"
+
+using namespace ark;
+
+static AFNetSendLimit MakeLimit()
+{
+    AFNetSendLimit limit;
+    limit.low_watermark_ = 100;
+    limit.high_watermark_ = 1000;
+    limit.hard_limit_ = 10000;
+    return limit;
+}
+
+static AFNetPacketPtr MakePacket(const size_t len)
+{
+    return std::make_shared<std::string>(len, 'x');
+}
+
+TEST_CASE("send queue congests above high watermark once", "[send_queue]")
+{
+    AFNetSendQueue queue;
+    auto limit = MakeLimit();
+
+    REQUIRE_FALSE(queue.AddQueued(600, limit));
+    REQUIRE_FALSE(queue.IsCongested());
+    REQUIRE(queue.Coalesce(1, 0, 0, MakePacket(10)) == AFNetSendQueue::Result::SEND);
+
+    REQUIRE(queue.AddQueued(600, limit));
+    REQUIRE(queue.IsCongested());
+    REQUIRE_FALSE(queue.AddQueued(600, limit));
+    REQUIRE(queue.GetQueueSize() == 1800);
+}
+
+TEST_CASE("send queue coalesces low priority messages while congested", "[send_queue]")
+{
+    AFNetSendQueue queue;
+    auto limit = MakeLimit();
+    queue.AddQueued(2000, limit);
+
+    REQUIRE(queue.Coalesce(1, 10, 100, MakePacket(10)) == AFNetSendQueue::Result::COALESCED);
+    REQUIRE(queue.Coalesce(1, 10, 200, MakePacket(20)) == AFNetSendQueue::Result::COALESCED);
+
+    // the newer one replaces the older one of the same msg id, actor id and entity
+    auto newer = MakePacket(30);
+    REQUIRE(queue.Coalesce(1, 10, 100, newer) == AFNetSendQueue::Result::REPLACED);
+    REQUIRE(queue.GetQueueSize() == 2000 + 30 + 20);
+
+    // not drained below low watermark yet
+    std::vector<AFNetSendQueue::CoalescedPacket> packets;
+    REQUIRE_FALSE(queue.EndCongest(limit, packets));
+
+    queue.RemoveQueued(1950);
+    REQUIRE(queue.EndCongest(limit, packets));
+    REQUIRE_FALSE(queue.IsCongested());
+    REQUIRE(packets.size() == 2);
+    REQUIRE(packets[0].packet_ == newer);
+    REQUIRE(queue.GetQueueSize() == 50);
+}
+
+TEST_CASE("send queue drops when the coalesce table is full", "[send_queue]")
+{
+    AFNetSendQueue queue;
+    auto limit = MakeLimit();
+    queue.AddQueued(2000, limit);
+
+    for (size_t i = 0; i < AFNetSendQueue::MAX_COALESCE_COUNT; ++i)
+    {
+        REQUIRE(queue.Coalesce(1, 0, static_cast<int64_t>(i), MakePacket(1)) == AFNetSendQueue::Result::COALESCED);
+    }
+
+    REQUIRE(queue.Coalesce(1, 0, -1, MakePacket(1)) == AFNetSendQueue::Result::DROPPED);
+
+    // overflow is reported only once
+    REQUIRE(queue.SetOverflow());
+    REQUIRE_FALSE(queue.SetOverflow());
+}
+
+TEST_CASE("packet pool reuses released packets", "[send_queue]")
+{
+    auto packet = AFNetPacketPool::Alloc(64);
+    REQUIRE(packet->empty());
+    REQUIRE(packet->capacity() >= 64);
+
+    packet->append("held");
+    const std::string* held = packet.get();
+
+    // a packet still held is never handed out again
+    for (size_t i = 0; i < AFNetPacketPool::POOL_SIZE; ++i)
+    {
+        REQUIRE(AFNetPacketPool::Alloc(16).get() != held);
+    }
+
+    REQUIRE(*packet == "held");
+
+    // released, it comes back empty after a full turn of the ring
+    const std::string* released = AFNetPacketPool::Alloc(16).get();
+    for (size_t i = 1; i < AFNetPacketPool::POOL_SIZE; ++i)
+    {
+        AFNetPacketPool::Alloc(16);
+    }
+
+    auto reused = AFNetPacketPool::Alloc(16);
+    REQUIRE(reused.get() == released);
+    REQUIRE(reused->empty());
+}